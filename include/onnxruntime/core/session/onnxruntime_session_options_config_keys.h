@@ -299,6 +299,25 @@ static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas
 // If not provided, default is 4.
 static const char* const kOrtSessionOptionsQDQMatMulNBitsAccuracyLevel = "session.qdq_matmulnbits_accuracy_level";
 
+// Evict finished sequences from the decoder batch of the CPU GreedySearch and Sampling contrib operators.
+// Once a sequence generates the end-of-sequence token, its row is removed from the decoder subgraph inputs
+// (input_ids, position_ids, attention_mask and past state) so that later iterations only run unfinished rows.
+// The generated sequences are the same as without eviction. Not applied when past and present share a buffer.
+// Option values:
+// - "0": Finished sequences are kept in the batch until all sequences finish. [DEFAULT]
+// - "1": Finished sequences are evicted from the batch.
+static const char* const kOrtSessionOptionsGenerationEvictFinishedSequences = "session.generation_evict_finished_sequences";
+
+// Share the cross attention past key/value across beams in the CPU BeamSearch contrib operator for T5 and Whisper.
+// The cross attention key/value produced by the encoder are fed to the decoder subgraph once per batch instead of
+// being copied for every beam, and MultiHeadAttention broadcasts them to the beams of the same batch.
+// This requires the decoder subgraph to consume past_key_cross_* and past_value_cross_* only as the key and value
+// inputs of MultiHeadAttention. Not applied when past and present share a buffer.
+// Option values:
+// - "0": Cross attention key/value are expanded to batch_size * num_beams. [DEFAULT]
+// - "1": Cross attention key/value are kept with batch_size and shared by beams.
+static const char* const kOrtSessionOptionsGenerationShareCrossAttentionKV = "session.generation_share_cross_attention_kv";
+
 // THIS OPTION IS NOT A REGULAR SESSION OPTION SINCE IT CAN BE MODIFIED AT ANY TIME
 // Meant to be used with SetEpDynamicOptions
 // Specify the type of workload for this session.
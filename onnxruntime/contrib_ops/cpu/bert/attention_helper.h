@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
@@ -252,5 +254,50 @@ T* ConcatStateChunkGQA(const T* past,
   return start;
 }
 
+// Concatenate past and new states of one head to int8 quantized KV cache. Each token of a head is quantized
+// symmetrically with its own scale, so appending new tokens does not change the past tokens in cache.
+// row_buffer holds head_size floats, and is only used to convert new states from float16.
+template <typename T>
+void ConcatQuantizedStateChunkGQA(const int8_t* past,
+                                  const float* past_scale,
+                                  const T* chunk,
+                                  int8_t* present,
+                                  float* present_scale,
+                                  size_t present_buff_sequence_length,
+                                  size_t past_buff_sequence_length,
+                                  size_t past_sequence_length,
+                                  size_t new_sequence_length,
+                                  size_t head_size,
+                                  bool past_present_share_buffer,
+                                  std::ptrdiff_t i,
+                                  float* row_buffer) {
+  int8_t* start = present + i * present_buff_sequence_length * head_size;
+  float* scale_start = present_scale + i * present_buff_sequence_length;
+
+  if (!past_present_share_buffer && past_sequence_length > 0) {
+    memcpy(start, past + i * past_buff_sequence_length * head_size, past_sequence_length * head_size);
+    memcpy(scale_start, past_scale + i * past_buff_sequence_length, past_sequence_length * sizeof(float));
+  }
+
+  for (size_t s = 0; s < new_sequence_length; s++) {
+    const float* row;
+    if constexpr (std::is_same<T, float>::value) {
+      row = chunk + s * head_size;
+    } else {
+      MlasConvertHalfToFloatBuffer(chunk + s * head_size, row_buffer, head_size);
+      row = row_buffer;
+    }
+
+    float min_value;
+    float max_value;
+    MlasFindMinMaxElement(row, &min_value, &max_value, head_size);
+    const float abs_max = std::max(std::abs(min_value), std::abs(max_value));
+    const float scale = abs_max > 0.0f ? abs_max / 127.0f : 1.0f;
+
+    MlasQuantizeLinear<int8_t>(row, start + (past_sequence_length + s) * head_size, head_size, scale, 0);
+    scale_start[past_sequence_length + s] = scale;
+  }
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -34,6 +34,9 @@ class GQAAttentionBase {
     use_smooth_softmax_ = info.GetAttrOrDefault<int64_t>("smooth_softmax", 0) == 1;
 
     local_window_size_ = has_local ? static_cast<int>(info.GetAttrOrDefault<int64_t>("local_window_size", -1)) : -1;
+
+    kv_cache_bit_width_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("kv_cache_bit_width", 0));
+    ORT_ENFORCE(kv_cache_bit_width_ == 0 || kv_cache_bit_width_ == 8, "kv_cache_bit_width shall be 0 or 8");
   }
 
   int num_heads_;     // number of attention heads of Q
@@ -45,6 +48,7 @@ class GQAAttentionBase {
   int local_window_size_;
 
   bool use_smooth_softmax_;
+  int kv_cache_bit_width_;  // 0 when KV cache has same type as Q, or 8 for int8 quantized KV cache
 
   template <typename T>
   Status ApplyAttention(const T* Q,                                 // Q data with shape BxNxSxH
@@ -103,6 +107,221 @@ class GQAAttentionBase {
     return Status::OK();
   }
 
+  // Attention with int8 KV cache, where each token of a kv head has one float scale in past/present scale tensors
+  // of shape BxN_kvxS*. New key and value are quantized when they are appended to the cache. The cache is
+  // dequantized on the fly in Q*K' and attention_probs*V for token generation, which only reads int8 cache once.
+  // For prompt, the cache of a head is dequantized to a temporary buffer and multiplied by GEMM.
+  template <typename T>
+  Status ApplyAttentionWithQuantizedKVCache(const T* Q,                                 // Q data with shape BxNxSxH
+                                            const T* K,                                 // K data with shape BxN_kvxSxH
+                                            const T* V,                                 // V data with shape BxN_kvxSxH
+                                            const Tensor* past_key,                     // past K (int8)
+                                            const Tensor* past_value,                   // past V (int8)
+                                            const Tensor* past_key_scale,               // scale of past K
+                                            const Tensor* past_value_scale,             // scale of past V
+                                            Tensor* output,                             // output tensor
+                                            Tensor* present_key,                        // present K (int8)
+                                            Tensor* present_value,                      // present V (int8)
+                                            Tensor* present_key_scale,                  // scale of present K
+                                            Tensor* present_value_scale,                // scale of present V
+                                            const Tensor* seqlens_k,                    // past sequence lengths tensor
+                                            GroupQueryAttentionParameters& parameters,  // attention parameters
+                                            AllocatorPtr allocator,                     // allocator for temporary buffer
+                                            OpKernelContext* context) const {
+    const bool is_prompt = parameters.is_first_prompt;
+    const size_t batch_size = static_cast<size_t>(parameters.batch_size);
+    const size_t sequence_length = static_cast<size_t>(parameters.sequence_length);
+    const size_t head_size = static_cast<size_t>(parameters.head_size);
+    const size_t hidden_size = static_cast<size_t>(parameters.hidden_size);
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const int32_t* seqlens = seqlens_k->Data<int32_t>();
+
+    auto* tp = context->GetOperatorThreadPool();
+
+    const size_t past_buffer_sequence_length =
+        past_key != nullptr ? static_cast<size_t>(past_key->Shape().GetDims()[2]) : 0;
+    const size_t present_buffer_sequence_length = static_cast<size_t>(present_key->Shape().GetDims()[2]);
+
+    const int8_t* past_key_data = past_key != nullptr ? past_key->Data<int8_t>() : nullptr;
+    const int8_t* past_value_data = past_value != nullptr ? past_value->Data<int8_t>() : nullptr;
+    const float* past_key_scale_data = past_key_scale != nullptr ? past_key_scale->Data<float>() : nullptr;
+    const float* past_value_scale_data = past_value_scale != nullptr ? past_value_scale->Data<float>() : nullptr;
+    int8_t* present_key_data = present_key->MutableData<int8_t>();
+    int8_t* present_value_data = present_value->MutableData<int8_t>();
+    float* present_key_scale_data = present_key_scale->MutableData<float>();
+    float* present_value_scale_data = present_value_scale->MutableData<float>();
+
+    const bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
+    ORT_RETURN_IF(past_present_share_buffer && (past_key_scale_data != present_key_scale_data ||
+                                                past_value_scale_data != present_value_scale_data),
+                  "past and present scales shall share buffer when past and present key/value share buffer");
+
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t q_input_chunk_length = sequence_length * head_size;                      // S x H
+    const size_t kv_input_chunk_length = sequence_length * head_size;                     // L x H
+    const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
+    const T* k_input = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const T* v_input = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+
+    if (!past_present_share_buffer) {
+      const size_t cache_elements = batch_size * kv_num_heads_ * present_buff_chunk_length;
+      memset(present_key_data, 0, cache_elements);
+      memset(present_value_data, 0, cache_elements);
+      std::fill_n(present_key_scale_data, batch_size * kv_num_heads_ * present_buffer_sequence_length, 0.0f);
+      std::fill_n(present_value_scale_data, batch_size * kv_num_heads_ * present_buffer_sequence_length, 0.0f);
+    }
+
+    // Quantize new key and value, and append them to the cache.
+    TensorOpCost append_cost;
+    append_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(8) * kv_input_chunk_length);
+    append_cost.bytes_loaded = static_cast<double>(2 * kv_input_chunk_length * sizeof(T));
+    append_cost.bytes_stored = static_cast<double>(2 * kv_input_chunk_length);
+    if (!past_present_share_buffer) {
+      append_cost.bytes_loaded += static_cast<double>(2 * present_buff_chunk_length);
+      append_cost.bytes_stored += static_cast<double>(2 * present_buff_chunk_length);
+    }
+
+    ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, append_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      std::vector<float> row_buffer(head_size);
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t kv_head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;
+
+        const T* k;
+        const T* v;
+        if (packed_qkv) {
+          k = k_input + packed_batch_stride * batch_index + kv_input_chunk_length * kv_head_index;
+          v = v_input + packed_batch_stride * batch_index + kv_input_chunk_length * kv_head_index;
+        } else {
+          k = k_input + kv_input_chunk_length * i;
+          v = v_input + kv_input_chunk_length * i;
+        }
+
+        ConcatQuantizedStateChunkGQA(past_key_data, past_key_scale_data, k, present_key_data, present_key_scale_data,
+                                     present_buffer_sequence_length, past_buffer_sequence_length, past_seqlen,
+                                     sequence_length, head_size, past_present_share_buffer, i, row_buffer.data());
+        ConcatQuantizedStateChunkGQA(past_value_data, past_value_scale_data, v, present_value_data,
+                                     present_value_scale_data, present_buffer_sequence_length,
+                                     past_buffer_sequence_length, past_seqlen, sequence_length, head_size,
+                                     past_present_share_buffer, i, row_buffer.data());
+      }
+    });
+
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles =
+        static_cast<double>(SafeInt<ptrdiff_t>(4) * sequence_length * head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded = static_cast<double>(2 * present_buff_chunk_length + q_input_chunk_length * sizeof(T));
+    unit_cost.bytes_stored = static_cast<double>(q_input_chunk_length * sizeof(T));
+
+    ThreadPool::TryParallelFor(tp, batch_size * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / num_heads_;
+        const size_t head_index = i % num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;  // Assume no padding sequence length
+        const size_t kv_index = i / kv_num_heads_factor;
+
+        const int8_t* k = present_key_data + kv_index * present_buff_chunk_length;
+        const int8_t* v = present_value_data + kv_index * present_buff_chunk_length;
+        const float* k_scale = present_key_scale_data + kv_index * present_buffer_sequence_length;
+        const float* v_scale = present_value_scale_data + kv_index * present_buffer_sequence_length;
+
+        const T* q;
+        if (packed_qkv) {
+          q = Q + packed_batch_stride * batch_index + q_input_chunk_length * head_index;
+        } else {
+          q = Q + q_input_chunk_length * i;
+        }
+
+        // Buffers for Q (S x H), attention probs (S x T) and output (S x H) in float, followed by K and V (T x H)
+        // dequantized for prompt.
+        const bool use_gemm = sequence_length > 1;
+        size_t buffer_elements = SafeInt<size_t>(sequence_length) * (2 * head_size + total_seqlen);
+        if (use_gemm) {
+          buffer_elements += SafeInt<size_t>(2) * total_seqlen * head_size;
+        }
+        auto buffer = allocator->Alloc(buffer_elements * sizeof(float));
+        BufferUniquePtr scratch_buffer(buffer, BufferDeleter(allocator));
+
+        float* q_fp32 = static_cast<float*>(buffer);
+        float* probs = q_fp32 + q_input_chunk_length;
+        float* output_fp32 = probs + sequence_length * total_seqlen;
+        if constexpr (std::is_same<T, float>::value) {
+          memcpy(q_fp32, q, q_input_chunk_length * sizeof(float));
+        } else {
+          MlasConvertHalfToFloatBuffer(q, q_fp32, q_input_chunk_length);
+        }
+
+        if (use_gemm) {
+          float* k_fp32 = output_fp32 + q_input_chunk_length;
+          float* v_fp32 = k_fp32 + total_seqlen * head_size;
+          for (size_t t = 0; t < total_seqlen; t++) {
+            for (size_t h = 0; h < head_size; h++) {
+              k_fp32[t * head_size + h] = k_scale[t] * static_cast<float>(k[t * head_size + h]);
+              v_fp32[t * head_size + h] = v_scale[t] * static_cast<float>(v[t * head_size + h]);
+            }
+          }
+
+          math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seqlen, head_size, alpha,
+                                          q_fp32, static_cast<int>(head_size), k_fp32, static_cast<int>(head_size),
+                                          0.0f /*beta*/, probs, static_cast<int>(total_seqlen), nullptr);
+          ComputeCausalSoftmaxInplace(probs, sequence_length, past_seqlen, total_seqlen, total_seqlen);
+          math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, total_seqlen, 1.f,
+                                          probs, static_cast<int>(total_seqlen), v_fp32, static_cast<int>(head_size),
+                                          0.0f /*beta*/, output_fp32, static_cast<int>(head_size), nullptr);
+        } else {
+          for (size_t t = 0; t < total_seqlen; t++) {
+            const int8_t* k_row = k + t * head_size;
+            for (size_t s = 0; s < sequence_length; s++) {
+              const float* q_row = q_fp32 + s * head_size;
+              float dot = 0.0f;
+              for (size_t h = 0; h < head_size; h++) {
+                dot += q_row[h] * static_cast<float>(k_row[h]);
+              }
+              probs[s * total_seqlen + t] = alpha * k_scale[t] * dot;
+            }
+          }
+
+          ComputeCausalSoftmaxInplace(probs, sequence_length, past_seqlen, total_seqlen, total_seqlen);
+
+          std::fill_n(output_fp32, q_input_chunk_length, 0.0f);
+          for (size_t t = 0; t < total_seqlen; t++) {
+            const int8_t* v_row = v + t * head_size;
+            for (size_t s = 0; s < sequence_length; s++) {
+              const float weight = probs[s * total_seqlen + t] * v_scale[t];
+              if (weight == 0.0f) {
+                continue;
+              }
+              float* output_row = output_fp32 + s * head_size;
+              for (size_t h = 0; h < head_size; h++) {
+                output_row[h] += weight * static_cast<float>(v_row[h]);
+              }
+            }
+          }
+        }
+
+        // Output has shape BxSxNxH.
+        T* output_current = output->MutableData<T>() + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+        for (size_t s = 0; s < sequence_length; s++) {
+          if constexpr (std::is_same<T, float>::value) {
+            memcpy(output_current + s * hidden_size, output_fp32 + s * head_size, head_size * sizeof(float));
+          } else {
+            MlasConvertFloatToHalfBuffer(output_fp32 + s * head_size, output_current + s * hidden_size, head_size);
+          }
+        }
+      }
+    });
+
+    return Status::OK();
+  }
+
  private:
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
@@ -221,44 +440,54 @@ class GQAAttentionBase {
         }
 
         // compute Softmax
-        float* output_softmax = output;
-        for (size_t seq = 0; seq < sequence_length; seq++) {
-          size_t seq_causal_length = past_seqlen + seq + 1;
-          if (local_window_size_ > 0 && seq_causal_length > static_cast<size_t>(local_window_size_) + 1) {
-            for (size_t total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_ - 1; total_seq_id++) {
-              output_softmax[total_seq_id] = 0.f;
-            }
-            if (softcap_ > 0.f) {
-              ComputeAttentionSoftcapInplace(output_softmax + seq_causal_length - local_window_size_ - 1,
-                                             local_window_size_ + 1, softcap_);
-            }
-            if (use_smooth_softmax_) {
-              ComputeSmoothSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
-                                          local_window_size_ + 1, nullptr);
-            } else {
-              ComputeAttentionSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
-                                             local_window_size_ + 1, nullptr);
-            }
-          } else {
-            if (softcap_ > 0.f) {
-              ComputeAttentionSoftcapInplace(output_softmax, static_cast<int>(seq_causal_length), softcap_);
-            }
-            if (use_smooth_softmax_) {
-              ComputeSmoothSoftmaxInplace(output_softmax, 1, static_cast<int>(seq_causal_length), nullptr);
-            } else {
-              ComputeAttentionSoftmaxInplace(output_softmax, 1, static_cast<int>(seq_causal_length), nullptr);
-            }
-          }
-
-          // set causal [seq_causal_length, total_seqlen) to 0.f
-          for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
-            output_softmax[total_seq_id] = 0.f;
-          }
+        ComputeCausalSoftmaxInplace(output, sequence_length, past_seqlen, total_seqlen,
+                                    present_buffer_sequence_length);
+      }
+    });
+  }
 
-          output_softmax += present_buffer_sequence_length;
+  // Apply causal mask (and local window), softcap and softmax to attention scores of one head in place.
+  // The scores of each query token have total_seqlen elements, and the stride between query tokens is row_stride.
+  void ComputeCausalSoftmaxInplace(float* output_softmax,
+                                   size_t sequence_length,
+                                   size_t past_seqlen,
+                                   size_t total_seqlen,
+                                   size_t row_stride) const {
+    for (size_t seq = 0; seq < sequence_length; seq++) {
+      size_t seq_causal_length = past_seqlen + seq + 1;
+      if (local_window_size_ > 0 && seq_causal_length > static_cast<size_t>(local_window_size_) + 1) {
+        for (size_t total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_ - 1; total_seq_id++) {
+          output_softmax[total_seq_id] = 0.f;
+        }
+        if (softcap_ > 0.f) {
+          ComputeAttentionSoftcapInplace(output_softmax + seq_causal_length - local_window_size_ - 1,
+                                         local_window_size_ + 1, softcap_);
+        }
+        if (use_smooth_softmax_) {
+          ComputeSmoothSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
+                                      local_window_size_ + 1, nullptr);
+        } else {
+          ComputeAttentionSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
+                                         local_window_size_ + 1, nullptr);
+        }
+      } else {
+        if (softcap_ > 0.f) {
+          ComputeAttentionSoftcapInplace(output_softmax, static_cast<int>(seq_causal_length), softcap_);
+        }
+        if (use_smooth_softmax_) {
+          ComputeSmoothSoftmaxInplace(output_softmax, 1, static_cast<int>(seq_causal_length), nullptr);
+        } else {
+          ComputeAttentionSoftmaxInplace(output_softmax, 1, static_cast<int>(seq_causal_length), nullptr);
         }
       }
-    });
+
+      // set causal [seq_causal_length, total_seqlen) to 0.f
+      for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
+        output_softmax[total_seq_id] = 0.f;
+      }
+
+      output_softmax += row_stride;
+    }
   }
 
   template <typename T>
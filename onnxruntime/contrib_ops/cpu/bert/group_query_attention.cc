@@ -22,16 +22,18 @@ namespace onnxruntime {
 namespace contrib {
 
 // These ops are internal-only, so register outside of onnx
-#define REGISTER_KERNEL_TYPED(T)                                        \
-  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
-      GroupQueryAttention,                                              \
-      kMSDomain,                                                        \
-      1,                                                                \
-      T,                                                                \
-      kCpuExecutionProvider,                                            \
-      KernelDefBuilder()                                                \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
-          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()), \
+#define REGISTER_KERNEL_TYPED(T)                                              \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                              \
+      GroupQueryAttention,                                                    \
+      kMSDomain,                                                              \
+      1,                                                                      \
+      T,                                                                      \
+      kCpuExecutionProvider,                                                  \
+      KernelDefBuilder()                                                      \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())              \
+          .TypeConstraint("T_CACHE", {DataTypeImpl::GetTensorType<T>(),       \
+                                      DataTypeImpl::GetTensorType<int8_t>()}) \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()),       \
       GroupQueryAttention<T>);
 
 REGISTER_KERNEL_TYPED(float)
@@ -52,6 +54,8 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const Tensor* total_seqlen_tensor = context->Input<Tensor>(6);
   const Tensor* cos_cache = context->Input<Tensor>(7);
   const Tensor* sin_cache = context->Input<Tensor>(8);
+  const Tensor* past_key_scale = context->Input<Tensor>(9);
+  const Tensor* past_value_scale = context->Input<Tensor>(10);
 
   GroupQueryAttentionParameters parameters = {};
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
@@ -87,6 +91,32 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   Tensor* present_k = context->Output(1, present_k_shape);
   Tensor* present_v = context->Output(2, present_v_shape);
 
+  const bool quantized_kv_cache = kv_cache_bit_width_ != 0;
+  Tensor* present_k_scale = nullptr;
+  Tensor* present_v_scale = nullptr;
+  if (quantized_kv_cache) {
+    ORT_RETURN_IF(present_k == nullptr || present_v == nullptr || !present_k->IsDataType<int8_t>() ||
+                      !present_v->IsDataType<int8_t>(),
+                  "present_key and present_value shall be int8 when kv_cache_bit_width is 8");
+    if (past_key != nullptr) {
+      ORT_RETURN_IF(!past_key->IsDataType<int8_t>() || !past_value->IsDataType<int8_t>(),
+                    "past_key and past_value shall be int8 when kv_cache_bit_width is 8");
+      ORT_RETURN_IF(past_key_scale == nullptr || past_value_scale == nullptr,
+                    "past_key_scale and past_value_scale are required when kv_cache_bit_width is 8");
+      const auto& past_dims = past_key->Shape().GetDims();
+      const TensorShape past_scale_shape({past_dims[0], past_dims[1], past_dims[2]});
+      ORT_RETURN_IF(past_key_scale->Shape() != past_scale_shape || past_value_scale->Shape() != past_scale_shape,
+                    "past_key_scale and past_value_scale shall have shape (batch_size, kv_num_heads, ",
+                    "past_buffer_sequence_length)");
+    }
+
+    std::vector<int64_t> present_scale_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen)});
+    present_k_scale = context->Output(3, present_scale_shape);
+    present_v_scale = context->Output(4, present_scale_shape);
+    ORT_RETURN_IF(present_k_scale == nullptr || present_v_scale == nullptr,
+                  "present_key_scale and present_value_scale are required when kv_cache_bit_width is 8");
+  }
+
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
@@ -192,6 +222,14 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   }
 
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  if (quantized_kv_cache) {
+    return ApplyAttentionWithQuantizedKVCache(q_rotary, packed_qkv ? nullptr : k_rotary,
+                                              packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
+                                              past_key, past_value, past_key_scale, past_value_scale,
+                                              output, present_k, present_v, present_k_scale, present_v_scale,
+                                              seqlens_k, parameters, allocator, context);
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(q_rotary, packed_qkv ? nullptr : k_rotary, packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
                         past_key, past_value, output, present_k, present_v,
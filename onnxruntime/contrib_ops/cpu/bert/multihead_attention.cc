@@ -68,6 +68,29 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
     ORT_NOT_IMPLEMENTED("Packed KV not implemented for CPU");
   }
 
+  // Cross attention key and value in BNSH format could be shared by beams in beam search, so that their batch size
+  // is a divisor of the batch size of query. Query of shape (B * G, S, D) is viewed as (B, G * S, D) in that case,
+  // which is equivalent for cross attention without mask, and key and value are read once for the G beams.
+  const TensorShape original_query_shape = query->Shape();
+  Tensor grouped_query;
+  if (key != nullptr && value != nullptr && original_query_shape.NumDimensions() == 3 &&
+      key->Shape().NumDimensions() == 4 && value->Shape().NumDimensions() == 4) {
+    const int64_t query_batch_size = original_query_shape[0];
+    const int64_t kv_batch_size = key->Shape()[0];
+    if (kv_batch_size > 0 && kv_batch_size < query_batch_size && query_batch_size % kv_batch_size == 0) {
+      ORT_RETURN_IF(key_padding_mask != nullptr || attn_bias != nullptr || past_key != nullptr ||
+                        past_value != nullptr || is_unidirectional_,
+                    "key and value with smaller batch size than query is only supported for cross attention "
+                    "without key_padding_mask, attention_bias, past or unidirectional");
+      const int64_t group_size = query_batch_size / kv_batch_size;
+      grouped_query = Tensor(query->DataType(),
+                             TensorShape({kv_batch_size, group_size * original_query_shape[1], original_query_shape[2]}),
+                             const_cast<void*>(query->DataRaw()),
+                             query->Location());
+      query = &grouped_query;
+    }
+  }
+
   AttentionParameters parameters = {};
   bool past_present_share_buffer = false;
   ORT_RETURN_IF_ERROR(multihead_attention_helper::CheckInputs<Tensor>(query,
@@ -96,9 +119,10 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
   int qk_hidden_size = parameters.hidden_size;
   int v_hidden_size = parameters.v_hidden_size;
 
+  // Output has same layout for grouped query, so it is allocated with batch size and sequence length of the query.
   std::vector<int64_t> output_shape(3);
-  output_shape[0] = static_cast<int64_t>(batch_size);
-  output_shape[1] = static_cast<int64_t>(q_sequence_length);
+  output_shape[0] = original_query_shape[0];
+  output_shape[1] = original_query_shape[1];
   output_shape[2] = static_cast<int64_t>(parameters.v_hidden_size);
   Tensor* output = context->Output(0, output_shape);
 
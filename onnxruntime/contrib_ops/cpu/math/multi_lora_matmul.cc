@@ -0,0 +1,182 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// MatMul with base weight shared by all batch rows, plus a low-rank update selected per batch row from a stack of
+// resident LoRA adapters:
+//   Y[b] = A[b] * B + alpha * (A[b] * lora_a[adapter_ids[b]]) * lora_b[adapter_ids[b]]
+// The base weight is applied to all rows with a single GEMM. Rows are then grouped by adapter, so the low-rank update
+// of each adapter is two GEMMs (shrink to rank, then expand) over all rows using that adapter, like SGMV.
+class MultiLoRAMatMul final : public OpKernel {
+ public:
+  explicit MultiLoRAMatMul(const OpKernelInfo& info) : OpKernel(info) {
+    alpha_ = info.GetAttrOrDefault<float>("alpha", 1.0f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float alpha_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    MultiLoRAMatMul,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("I", DataTypeImpl::GetTensorType<int32_t>()),
+    MultiLoRAMatMul);
+
+Status MultiLoRAMatMul::Compute(OpKernelContext* context) const {
+  const Tensor* a = context->Input<Tensor>(0);
+  const Tensor* b = context->Input<Tensor>(1);
+  const Tensor* lora_a = context->Input<Tensor>(2);
+  const Tensor* lora_b = context->Input<Tensor>(3);
+  const Tensor* adapter_ids = context->Input<Tensor>(4);
+
+  const auto& a_shape = a->Shape();
+  const auto& b_shape = b->Shape();
+  const auto& lora_a_shape = lora_a->Shape();
+  const auto& lora_b_shape = lora_b->Shape();
+
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 2, "Input A shall have at least 2 dimensions");
+  ORT_RETURN_IF_NOT(b_shape.NumDimensions() == 2, "Input B shall be 2D with shape (K, N)");
+  ORT_RETURN_IF_NOT(lora_a_shape.NumDimensions() == 3 && lora_b_shape.NumDimensions() == 3,
+                    "Inputs lora_a and lora_b shall be 3D");
+
+  const int64_t batch_size = a_shape[0];
+  const int64_t K = a_shape[a_shape.NumDimensions() - 1];
+  const int64_t N = b_shape[1];
+  const int64_t num_adapters = lora_a_shape[0];
+  const int64_t rank = lora_a_shape[2];
+
+  ORT_RETURN_IF_NOT(b_shape[0] == K, "Input B dimension 0 shall be same as last dimension of A");
+  ORT_RETURN_IF_NOT(lora_a_shape[1] == K, "Input lora_a shall have shape (num_adapters, K, rank)");
+  ORT_RETURN_IF_NOT(lora_b_shape[0] == num_adapters && lora_b_shape[1] == rank && lora_b_shape[2] == N,
+                    "Input lora_b shall have shape (num_adapters, rank, N)");
+  ORT_RETURN_IF_NOT(adapter_ids->Shape().NumDimensions() == 1 && adapter_ids->Shape()[0] == batch_size,
+                    "Input adapter_ids shall have shape (batch_size)");
+
+  TensorShapeVector output_dims = a_shape.AsShapeVector();
+  output_dims.back() = N;
+  Tensor* y = context->Output(0, TensorShape(output_dims));
+  if (y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const size_t rows_per_batch = narrow<size_t>(a_shape.Slice(1, a_shape.NumDimensions() - 1).Size());
+  const size_t M = narrow<size_t>(batch_size) * rows_per_batch;
+  const size_t k = narrow<size_t>(K);
+  const size_t n = narrow<size_t>(N);
+  const size_t r = narrow<size_t>(rank);
+
+  const float* a_data = a->Data<float>();
+  const float* lora_a_data = lora_a->Data<float>();
+  const float* lora_b_data = lora_b->Data<float>();
+  float* y_data = y->MutableData<float>();
+
+  // Base weight for all rows.
+  MlasGemm(CblasNoTrans, CblasNoTrans, M, n, k, 1.0f, a_data, k, b->Data<float>(), n, 0.0f, y_data, n, thread_pool);
+
+  if (r == 0 || num_adapters == 0) {
+    return Status::OK();
+  }
+
+  // Group batch rows by adapter with counting sort. Negative adapter id means no adapter for the row.
+  const auto ids = adapter_ids->DataAsSpan<int32_t>();
+  InlinedVector<size_t> group_offsets(narrow<size_t>(num_adapters) + 1, 0);
+  for (int32_t id : ids) {
+    ORT_RETURN_IF_NOT(id < num_adapters, "adapter_ids shall be less than number of adapters. Got ", id);
+    if (id >= 0) {
+      ++group_offsets[static_cast<size_t>(id) + 1];
+    }
+  }
+  for (size_t g = 1; g < group_offsets.size(); g++) {
+    group_offsets[g] += group_offsets[g - 1];
+  }
+
+  InlinedVector<size_t> grouped_batches(group_offsets.back());
+  {
+    InlinedVector<size_t> next(group_offsets.begin(), group_offsets.end() - 1);
+    for (size_t i = 0; i < ids.size(); i++) {
+      if (ids[i] >= 0) {
+        grouped_batches[next[static_cast<size_t>(ids[i])]++] = i;
+      }
+    }
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  // Scratch for gathered A rows (rows x K), shrunk rows (rows x rank) and update (rows x N) of largest group.
+  size_t max_group_rows = 0;
+  for (size_t g = 0; g + 1 < group_offsets.size(); g++) {
+    max_group_rows = std::max(max_group_rows, (group_offsets[g + 1] - group_offsets[g]) * rows_per_batch);
+  }
+  auto buffer = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(max_group_rows) * (k + r + n));
+  float* gathered_a = buffer.get();
+  float* shrunk = gathered_a + max_group_rows * k;
+  float* update = shrunk + max_group_rows * r;
+
+  for (size_t g = 0; g + 1 < group_offsets.size(); g++) {
+    const size_t first = group_offsets[g];
+    const size_t count = group_offsets[g + 1] - first;
+    if (count == 0) {
+      continue;
+    }
+
+    const size_t group_rows = count * rows_per_batch;
+    const float* adapter_a = lora_a_data + g * k * r;
+    const float* adapter_b = lora_b_data + g * r * n;
+
+    // Batch rows of an adapter are consecutive when the ids are sorted, so A and Y could be used in place.
+    const bool contiguous = grouped_batches[first + count - 1] - grouped_batches[first] + 1 == count;
+    const float* group_a = a_data + grouped_batches[first] * rows_per_batch * k;
+    if (!contiguous) {
+      for (size_t i = 0; i < count; i++) {
+        memcpy(gathered_a + i * rows_per_batch * k,
+               a_data + grouped_batches[first + i] * rows_per_batch * k,
+               rows_per_batch * k * sizeof(float));
+      }
+      group_a = gathered_a;
+    }
+
+    MlasGemm(CblasNoTrans, CblasNoTrans, group_rows, r, k, alpha_, group_a, k, adapter_a, r, 0.0f, shrunk, r,
+             thread_pool);
+
+    if (contiguous) {
+      float* group_y = y_data + grouped_batches[first] * rows_per_batch * n;
+      MlasGemm(CblasNoTrans, CblasNoTrans, group_rows, n, r, 1.0f, shrunk, r, adapter_b, n, 1.0f, group_y, n,
+               thread_pool);
+    } else {
+      MlasGemm(CblasNoTrans, CblasNoTrans, group_rows, n, r, 1.0f, shrunk, r, adapter_b, n, 0.0f, update, n,
+               thread_pool);
+      for (size_t i = 0; i < count; i++) {
+        float* dst = y_data + grouped_batches[first + i] * rows_per_batch * n;
+        const float* src = update + i * rows_per_batch * n;
+        for (size_t j = 0; j < rows_per_batch * n; j++) {
+          dst[j] += src[j];
+        }
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/providers/cpu/nn/pool_attributes.h"
+#include "contrib_ops/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+//
+// Single precision kernels for tensors in channels last (NHWC) format. The
+// NhwcTransformer rewrites Conv/FusedConv, pooling and BatchNormalization nodes
+// to these kernels and relies on the transpose optimizer to cancel the layout
+// transposes between them, so the whole network runs without reorders.
+//
+
+/**
+ * @brief Convolution with optional fused Add (input Z) and activation, both
+ * channels last. Add is performed BEFORE activation.
+ */
+class NhwcConv final : public OpKernel {
+ public:
+  NhwcConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+ private:
+  /**
+   * @brief Reorder the (M x C/group x kH x kW) filter into (kH x kW x C/group) x M,
+   * so that the filters of each group are the columns of a GEMM B matrix with
+   * leading dimension M. For depthwise convolutions this is the
+   * (kernel_size x channels) layout consumed by MlasConvDepthwise.
+   */
+  static void ReorderFilter(const float* input,
+                            float* output,
+                            size_t output_channels,
+                            size_t input_channels,
+                            size_t kernel_size);
+
+  ConvAttributes conv_attrs_;
+  MLAS_ACTIVATION activation_;
+  TensorShape W_shape_;
+  BufferUniquePtr packed_W_buffer_;
+  size_t packed_W_size_{0};
+  bool is_W_packed_{false};
+  BufferUniquePtr reordered_W_buffer_;
+};
+
+/**
+ * @brief MaxPool, AveragePool and GlobalAveragePool, channels last.
+ */
+class NhwcPool final : public OpKernel {
+ public:
+  NhwcPool(const OpKernelInfo& info)
+      : OpKernel(info),
+        pool_attrs_(info, info.GetKernelDef().OpName(), info.node().SinceVersion()),
+        is_max_pool_(info.GetKernelDef().OpName() == "MaxPool") {
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  PoolAttributes pool_attrs_;
+  bool is_max_pool_;
+};
+
+/**
+ * @brief Inference mode BatchNormalization, channels last.
+ */
+class NhwcBatchNormalization final : public OpKernel {
+ public:
+  NhwcBatchNormalization(const OpKernelInfo& info) : OpKernel(info) {
+    epsilon_ = info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+    ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("training_mode", 0) == 0,
+                "Training mode is not supported for channels last BatchNormalization.");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float epsilon_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
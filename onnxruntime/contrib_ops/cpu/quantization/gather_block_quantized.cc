@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 
@@ -10,6 +11,7 @@
 #include "core/framework/float16.h"
 #include "core/framework/int4.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas_q4.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 
@@ -142,6 +144,13 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
   auto quantize_full_block = quantize_axis_dim * quantize_N;
   auto scale_full_block = (quantize_axis_dim + block_size_ - 1) / block_size_ * quantize_N;
 
+  // When the quantize axis is the innermost axis and each gathered block is made of whole rows along it, e.g. an
+  // embedding table gathered on axis 0 and quantized on axis 1, the rows and their scales are contiguous and are
+  // dequantized by MLAS a quantization block at a time.
+  const bool dequantize_rows = quantize_N == 1 && gather_block % quantize_axis_dim == 0;
+  const auto* packed_data = reinterpret_cast<const uint8_t*>(data_ptr);
+  const auto* packed_zero_points = reinterpret_cast<const uint8_t*>(zero_points_ptr);
+
   auto lambda = [&](int64_t gather_MN_idx, std::unordered_map<int64_t, int64_t>& cache) {
     int64_t gather_M_idx = gather_MN_idx / gather_N;
     int64_t gather_N_idx = gather_MN_idx % gather_N;
@@ -161,7 +170,23 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
       return;
     }
 
-    // TODO(fajin): use SIMD
+    if (dequantize_rows) {
+      const int64_t row_count = gather_block / quantize_axis_dim;
+      const int64_t first_row = data_idx_base / quantize_axis_dim;
+      for (int64_t r = 0; r < row_count; ++r) {
+        const int64_t row = first_row + r;
+        MlasDequantizeBlockwiseRun<T2, std::is_same_v<T1, Int4x2>>(
+            output_ptr + output_idx_base + r * quantize_axis_dim,
+            packed_data, narrow<size_t>(row * quantize_axis_dim),
+            scales_ptr + row * scale_full_block,
+            packed_zero_points, narrow<size_t>(row * scale_full_block),
+            narrow<size_t>(block_size_), narrow<size_t>(quantize_axis_dim));
+      }
+
+      cache[data_idx_base] = output_idx_base;
+      return;
+    }
+
     int64_t output_idx = output_idx_base;
     int64_t data_idx = data_idx_base;
     for (int64_t i = 0; i < gather_block; ++i, ++output_idx, ++data_idx) {
@@ -185,7 +210,9 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
   concurrency::ThreadPool::TryParallelFor(
       tp,
       SafeInt<ptrdiff_t>(gather_M) * gather_N,
-      static_cast<double>(gather_block * 3),
+      TensorOpCost{static_cast<double>(gather_block / 2 + gather_block / block_size_ * sizeof(T2)),
+                   static_cast<double>(gather_block * sizeof(T2)),
+                   static_cast<double>(gather_block)},
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
         // cache dequantized gather_block. Key is data_idx_base. Value is the output_idx_base.
         // cache is per thread to avoid contention.
@@ -39,7 +39,8 @@ REGISTER_KERNEL_TYPED(MLFloat16)
 
 namespace {
 
-template <typename T, typename = std::enable_if_t<std::is_same_v<T, float> || std::is_same_v<T, double>, void>>
+// Reference path for double, which MLAS does not implement.
+template <typename T, typename = std::enable_if_t<std::is_same_v<T, double>, void>>
 void ComputeJob(
     const T* input_data,
     const T* skip_data,
@@ -113,8 +114,6 @@ void ConvertMLFloat16ToFloatIfNeeded(const Tensor& tensor, AllocatorPtr alloc, I
 template <typename T, bool simplified>
 SkipLayerNorm<T, simplified>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
     : OpKernel(op_kernel_info),
-      prepacked_skip_fp32_size_(0),
-      prepacked_skip_fp32_data_(nullptr),
       prepacked_gamma_fp32_data_(nullptr),
       prepacked_beta_fp32_data_(nullptr),
       prepacked_bias_fp32_data_(nullptr) {
@@ -125,7 +124,7 @@ SkipLayerNorm<T, simplified>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
 template <typename T, bool simplified>
 Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   const Tensor* input = p_ctx->Input<Tensor>(0);
-  const Tensor* skip = prepacked_skip_fp32_data_ ? nullptr : p_ctx->Input<Tensor>(1);
+  const Tensor* skip = p_ctx->Input<Tensor>(1);
   const Tensor* gamma = prepacked_gamma_fp32_data_ ? nullptr : p_ctx->Input<Tensor>(2);
   const Tensor* beta = simplified ? nullptr : (prepacked_beta_fp32_data_ ? nullptr : p_ctx->Input<Tensor>(3));
   const Tensor* bias = prepacked_bias_fp32_data_ ? nullptr : p_ctx->Input<Tensor>(simplified ? 3 : 4);
@@ -144,13 +143,13 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
                                                                                       bias,
                                                                                       hidden_size,
                                                                                       input_dims_size,
-                                                                                      prepacked_skip_fp32_data_ != nullptr,
+                                                                                      false,
                                                                                       prepacked_gamma_fp32_data_ != nullptr));
 
   int64_t task_count = input->Shape().SizeToDimension(input_dims_size - 1);
 
   const T* input_data = input->Data<T>();
-  const T* skip_data = skip == nullptr ? nullptr : skip->Data<T>();
+  const T* skip_data = skip->Data<T>();
   const T* gamma_data = gamma == nullptr ? nullptr : gamma->Data<T>();
   const T* beta_data = beta == nullptr ? nullptr : beta->Data<T>();
   const T* bias_data = bias == nullptr ? nullptr : bias->Data<T>();
@@ -159,90 +158,62 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
 
   // For inferencing, we support one more optional output which is the sum of the input and skip tensors
   T* skip_input_bias_add_output_data = skip_input_bias_add_output == nullptr ? nullptr : skip_input_bias_add_output->MutableData<T>();
-  const int64_t skip_size = skip ? skip->Shape().Size() : prepacked_skip_fp32_size_;
+  const int64_t skip_size = skip->Shape().Size();
 
-  if constexpr (std::is_same_v<T, MLFloat16>) {
-    const size_t total_data_size = static_cast<size_t>(input->Shape().Size());
-
-    AllocatorPtr alloc;
-    ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
-
-    IAllocatorUniquePtr<float> input_fp32;
-    IAllocatorUniquePtr<float> output_fp32;
-    IAllocatorUniquePtr<float> skip_input_bias_add_output_fp32;
-    IAllocatorUniquePtr<float> skip_fp32;
-    IAllocatorUniquePtr<float> gamma_fp32;
-    IAllocatorUniquePtr<float> beta_fp32;
-    IAllocatorUniquePtr<float> bias_fp32;
-
-    const float* input_data_f = nullptr;
-    const float* skip_data_f = nullptr;
+  if constexpr (std::is_same_v<T, double>) {
+    concurrency::ThreadPool::TryBatchParallelFor(
+        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
+        [&](ptrdiff_t task_idx) {
+          ComputeJob(input_data, skip_data, gamma_data, beta_data, bias_data, task_idx, hidden_size, skip_size,
+                     epsilon_, simplified, output_data, skip_input_bias_add_output_data);
+        },
+        0);
+  } else {
+    // MLAS takes the gamma, beta and bias vectors in fp32. For fp16 they are converted once per call here unless
+    // they were constant and converted by PrePack; the input and skip rows are converted block by block by MLAS.
     const float* gamma_data_f = nullptr;
     const float* beta_data_f = nullptr;
     const float* bias_data_f = nullptr;
-    float* output_data_f = nullptr;
-    float* skip_input_bias_add_output_data_f = nullptr;
-
-    const size_t num_elems = static_cast<size_t>(hidden_size);
-
-    input_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
-    MlasConvertHalfToFloatBuffer(input_data, input_fp32.get(), total_data_size);
-    input_data_f = input_fp32.get();
-
-    output_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
-    output_data_f = output_fp32.get();
-
-    skip_input_bias_add_output_fp32 = IAllocator::MakeUniquePtr<float>(alloc, total_data_size);
-    skip_input_bias_add_output_data_f = skip_input_bias_add_output_fp32.get();
 
-    if (skip_data) {
-      skip_fp32 = IAllocator::MakeUniquePtr<float>(alloc, static_cast<size_t>(skip_size));
-      MlasConvertHalfToFloatBuffer(skip_data, skip_fp32.get(), static_cast<size_t>(skip_size));
-      skip_data_f = skip_fp32.get();
-    } else if (prepacked_skip_fp32_data_) {
-      skip_data_f = prepacked_skip_fp32_data_.get();
-    }
-
-    if (gamma_data) {
-      gamma_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-      MlasConvertHalfToFloatBuffer(gamma_data, gamma_fp32.get(), num_elems);
-      gamma_data_f = gamma_fp32.get();
-    } else if (prepacked_gamma_fp32_data_) {
-      gamma_data_f = prepacked_gamma_fp32_data_.get();
-    }
-
-    if (beta_data) {
-      beta_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-      MlasConvertHalfToFloatBuffer(beta_data, beta_fp32.get(), num_elems);
-      beta_data_f = beta_fp32.get();
-    } else if (prepacked_beta_fp32_data_) {
-      beta_data_f = prepacked_beta_fp32_data_.get();
-    }
+    IAllocatorUniquePtr<float> gamma_fp32;
+    IAllocatorUniquePtr<float> beta_fp32;
+    IAllocatorUniquePtr<float> bias_fp32;
 
-    if (bias_data) {
-      bias_fp32 = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-      MlasConvertHalfToFloatBuffer(bias_data, bias_fp32.get(), num_elems);
-      bias_data_f = bias_fp32.get();
-    } else if (prepacked_bias_fp32_data_) {
-      bias_data_f = prepacked_bias_fp32_data_.get();
+    if constexpr (std::is_same_v<T, MLFloat16>) {
+      AllocatorPtr alloc;
+      ORT_RETURN_IF_ERROR(p_ctx->GetTempSpaceAllocator(&alloc));
+
+      const size_t num_elems = static_cast<size_t>(hidden_size);
+
+      auto convert = [&](const MLFloat16* data, const IAllocatorUniquePtr<float>& prepacked,
+                         IAllocatorUniquePtr<float>& converted) -> const float* {
+        if (data != nullptr) {
+          converted = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
+          MlasConvertHalfToFloatBuffer(data, converted.get(), num_elems);
+          return converted.get();
+        }
+        return prepacked.get();
+      };
+
+      gamma_data_f = convert(gamma_data, prepacked_gamma_fp32_data_, gamma_fp32);
+      beta_data_f = convert(beta_data, prepacked_beta_fp32_data_, beta_fp32);
+      bias_data_f = convert(bias_data, prepacked_bias_fp32_data_, bias_fp32);
+    } else {
+      gamma_data_f = gamma_data;
+      beta_data_f = beta_data;
+      bias_data_f = bias_data;
     }
 
     concurrency::ThreadPool::TryBatchParallelFor(
         p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
         [&](ptrdiff_t task_idx) {
-          ComputeJob(input_data_f, skip_data_f, gamma_data_f, beta_data_f, bias_data_f, task_idx, hidden_size, skip_size,
-                     epsilon_, simplified, output_data_f, skip_input_bias_add_output_data_f);
-        },
-        0);
-    MlasConvertFloatToHalfBuffer(output_data_f, output_data, total_data_size);
-    if (skip_input_bias_add_output_data != nullptr)
-      MlasConvertFloatToHalfBuffer(skip_input_bias_add_output_data_f, skip_input_bias_add_output_data, total_data_size);
-  } else {
-    concurrency::ThreadPool::TryBatchParallelFor(
-        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
-        [&](ptrdiff_t task_idx) {
-          ComputeJob(input_data, skip_data, gamma_data, beta_data, bias_data, task_idx, hidden_size, skip_size,
-                     epsilon_, simplified, output_data, skip_input_bias_add_output_data);
+          const auto offset = task_idx * hidden_size;
+          MlasLayerNormalizationOneRow(input_data + offset, skip_data + (offset % skip_size), bias_data_f,
+                                       gamma_data_f, beta_data_f, output_data + offset,
+                                       skip_input_bias_add_output_data == nullptr
+                                           ? nullptr
+                                           : skip_input_bias_add_output_data + offset,
+                                       static_cast<size_t>(hidden_size), epsilon_, simplified, nullptr, nullptr);
         },
         0);
   }
@@ -255,10 +226,8 @@ Status SkipLayerNorm<T, simplified>::PrePack(const Tensor& tensor, int input_idx
                                              bool& is_packed, PrePackedWeights* prepacked_weights) {
   ORT_UNUSED_PARAMETER(prepacked_weights);
   is_packed = false;
-  if (input_idx == 1) {  // skip
-    prepacked_skip_fp32_size_ = tensor.Shape().Size();
-    ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, prepacked_skip_fp32_data_, is_packed);
-  } else if (input_idx == 2) {  // gamma
+  // skip (input 1) is consumed directly by the MLAS kernel in every data type, so it is not converted.
+  if (input_idx == 2) {  // gamma
     ConvertMLFloat16ToFloatIfNeeded(tensor, alloc, prepacked_gamma_fp32_data_, is_packed);
   } else if (input_idx == 3) {
     if constexpr (simplified) {
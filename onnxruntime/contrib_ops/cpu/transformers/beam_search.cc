@@ -153,6 +153,7 @@ Status BeamSearch::SetupSubgraphExecutionInfo(const SessionState& session_state,
                                                                  attribute_name,
                                                                  subgraph_session_state.GetGraphViewer());
       ORT_RETURN_IF_ERROR(t5_decoder_subgraph_->Setup(session_state, subgraph_session_state));
+      t5_decoder_subgraph_->SetShareCrossAttentionKV(parameters_->share_cross_attention_kv);
       decoder_feeds_fetches_manager_ = t5_decoder_subgraph_->GetFeedsFetchesManager();
       parameters_->SetSubgraphParameters(t5_decoder_subgraph_->vocab_size,
                                          t5_decoder_subgraph_->num_heads,
@@ -178,6 +179,7 @@ Status BeamSearch::SetupSubgraphExecutionInfo(const SessionState& session_state,
                                                                            attribute_name,
                                                                            subgraph_session_state.GetGraphViewer());
       ORT_RETURN_IF_ERROR(whisper_decoder_subgraph_->Setup(session_state, subgraph_session_state));
+      whisper_decoder_subgraph_->SetShareCrossAttentionKV(parameters_->share_cross_attention_kv);
       decoder_feeds_fetches_manager_ = whisper_decoder_subgraph_->GetFeedsFetchesManager();
       parameters_->SetSubgraphParameters(whisper_decoder_subgraph_->vocab_size,
                                          whisper_decoder_subgraph_->num_heads,
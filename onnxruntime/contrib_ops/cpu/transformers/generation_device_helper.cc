@@ -4,6 +4,7 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <utility>
 #include "core/providers/cpu/math/top_k.h"
 #include "core/providers/cpu/math/softmax_shared.h"
 #include "core/providers/cpu/generator/random.h"
@@ -437,6 +438,56 @@ Status ProcessLogits(const OrtValue& logits,                                 //
   return Status::OK();
 }
 
+// Select the token with the largest score in each row of next_token_scores, which has shape (batch_size, vocab_size).
+// This is TopK with k == 1, except that the vocabulary is also split into tiles: TopK only parallelizes over rows,
+// so a decode step with batch size 1 and a large vocabulary would scan all the scores on one thread. Each tile keeps
+// its own running maximum and the tiles of a row are merged in order, so ties resolve to the lowest token id.
+template <typename T>
+void ArgMaxNextTokens(gsl::span<const T> next_token_scores,
+                      int batch_size,
+                      int vocab_size,
+                      onnxruntime::concurrency::ThreadPool* thread_pool,
+                      gsl::span<int32_t> next_tokens) {
+  constexpr int min_tile_size = 4096;
+  const int max_tiles = static_cast<int>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+  const int tiles_per_row = std::max(1, std::min(max_tiles, vocab_size / min_tile_size));
+  const int tile_size = (vocab_size + tiles_per_row - 1) / tiles_per_row;
+
+  std::vector<std::pair<T, int>> tile_best(SafeInt<size_t>(batch_size) * tiles_per_row);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(tile_best.size()),
+      [&](std::ptrdiff_t tile) {
+        const int row = static_cast<int>(tile / tiles_per_row);
+        const int begin = static_cast<int>(tile % tiles_per_row) * tile_size;
+        const int end = std::min(begin + tile_size, vocab_size);
+        const T* scores = next_token_scores.data() + SafeInt<size_t>(row) * vocab_size;
+
+        T best = scores[begin];
+        int best_index = begin;
+        for (int j = begin + 1; j < end; ++j) {
+          if (scores[j] > best) {
+            best = scores[j];
+            best_index = j;
+          }
+        }
+
+        tile_best[tile] = {best, best_index};
+      });
+
+  for (int i = 0; i < batch_size; i++) {
+    const auto* row_tiles = tile_best.data() + SafeInt<size_t>(i) * tiles_per_row;
+    auto best = row_tiles[0];
+    for (int t = 1; t < tiles_per_row; t++) {
+      if (row_tiles[t].first > best.first) {
+        best = row_tiles[t];
+      }
+    }
+
+    next_tokens[i] = best.second;
+  }
+}
+
 template <typename T>
 Status GreedySearchProcessLogits(
     const OrtValue& logits,                                 // logits output of subgraph
@@ -449,7 +500,7 @@ Status GreedySearchProcessLogits(
     const transformers::IGenerationParameters* parameters,  // parameters
     bool do_sampling,                                       // whether to do sampling
     int step,                                               // iteration counter
-    Stream* stream,                                         // cuda stream (for CUDA only)
+    Stream* /*stream*/,                                     // cuda stream (for CUDA only)
     const IConsoleDumper* dumper) {                         // tensor dumper
 
   int batch_size = parameters->batch_size;
@@ -501,49 +552,12 @@ Status GreedySearchProcessLogits(
   }
 
   // next_tokens = torch.argmax(scores, dim=-1)
-  int64_t next_token_scores_dims[] = {static_cast<int64_t>(batch_size), vocab_size};
-  TensorShape next_token_scores_shape(&next_token_scores_dims[0], 2);
-  auto element_type = DataTypeImpl::GetType<T>();
-  OrtValue next_token_scores_value;
-  Tensor::InitOrtValue(element_type,
-                       next_token_scores_shape,
-                       next_token_scores.data(),
-                       allocator->Info(),
-                       next_token_scores_value);
-  const Tensor& input = next_token_scores_value.Get<Tensor>();
-
-  constexpr unsigned top_k = 1;
-  constexpr int axis = 1;
-  constexpr bool largest = true;
-  constexpr bool sorted = false;
-
-  Tensor topk_scores;
-  Tensor topk_indices;
-  ORT_RETURN_IF_ERROR(TopK(&input,
-                           axis,
-                           top_k,
-                           largest,
-                           sorted,
-                           allocator,
-                           stream,
-                           thread_pool,
-                           topk_scores,
-                           topk_indices));
-
-#ifdef DEBUG_GENERATION
-  dumper->Print("topk_scores", topk_scores);
-  dumper->Print("topk_indices", topk_indices);
-#endif
-
-  gsl::span<const int64_t> next_token_indices = topk_indices.DataAsSpan<int64_t>();
-  for (size_t i = 0; i < next_token_indices.size(); i++) {
-    greedy_state->next_tokens[i] = gsl::narrow_cast<int32_t>(next_token_indices[i]);
-  }
+  ArgMaxNextTokens<T>(next_token_scores, batch_size, vocab_size, thread_pool, greedy_state->next_tokens);
 
 #ifdef DEBUG_GENERATION
   gsl::span<const int32_t> next_tokens(greedy_state->next_tokens.data(),
                                        greedy_state->next_tokens.size());
-  dumper->Print("next_tokens before scorer", next_tokens.data(), batch_size, top_k);
+  dumper->Print("next_tokens before scorer", next_tokens.data(), batch_size, 1);
 #endif
 
   return Status::OK();
@@ -968,6 +982,13 @@ template Status GreedySearchProcessLogits<float>(
     Stream* ort_stream,
     const IConsoleDumper* dumper);
 
+template void ArgMaxNextTokens<float>(
+    gsl::span<const float> next_token_scores,
+    int batch_size,
+    int vocab_size,
+    onnxruntime::concurrency::ThreadPool* thread_pool,
+    gsl::span<int32_t> next_tokens);
+
 template Status DeviceCopy<float>(
     gsl::span<float> target,
     gsl::span<const float> source,
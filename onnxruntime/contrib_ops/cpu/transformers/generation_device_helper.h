@@ -293,6 +293,13 @@ Status GreedySearchProcessLogits(const OrtValue& logits,
                                  Stream* stream,                                         // cuda stream (for CUDA only)
                                  const IConsoleDumper* dumper);                          // tensor dumper
 
+template <typename T>
+void ArgMaxNextTokens(gsl::span<const T> next_token_scores,               // scores with shape (batch_size, vocab_size)
+                      int batch_size,                                     // batch size
+                      int vocab_size,                                     // vocabulary size
+                      onnxruntime::concurrency::ThreadPool* thread_pool,  // thread pool (for CPU only)
+                      gsl::span<int32_t> next_tokens);                    // token with the largest score in each row
+
 template <typename T>
 Status DeviceCopy(gsl::span<T> target,
                   gsl::span<const T> source,
@@ -101,6 +101,10 @@ struct ISequences {
   virtual gsl::span<int32_t> GetNextDeviceSequences() = 0;                 // Get all next beam_index sequences in one continuous block (to pass to CUDA)
   virtual int GetSequenceLength() const = 0;
   virtual int GetMaxLength() const = 0;
+
+  // Beam indices of the last appended token: sequence i was extended from sequence beam_indices[i] of previous step.
+  // Empty when it is unknown (like sequences appended on device).
+  virtual gsl::span<const int32_t> GetLastBeamIndices() const { return {}; }
 };
 
 struct ILogitsProcessorList {
@@ -199,6 +203,10 @@ struct IGenerationParameters {
   int extra_decoding_ids_input_id = -1;
   int cross_qk_output_id = -1;
   int no_speech_probs_output_id = -1;
+
+  // Parameters from session options.
+  bool evict_finished_sequences = false;  // remove finished sequences from decoder batch (CPU greedy search only)
+  bool share_cross_attention_kv = false;  // feed cross attention key/value once per batch (CPU beam search only)
 };
 
 }  // namespace transformers
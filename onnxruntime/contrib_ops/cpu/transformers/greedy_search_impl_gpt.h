@@ -3,6 +3,7 @@
 
 #pragma once
 #include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include "core/common/span_utils.h"
@@ -101,6 +102,19 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
       gsl::span<const int32_t> next_tokens,
       int past_sequence_length);
 
+  // Copy logits of the last token for the active rows to their rows in a (batch_size, 1, vocab_size) buffer,
+  // so that logits processing and token selection work on the whole batch after some rows were evicted.
+  void ScatterActiveLogits(const OrtValue& logits,
+                           gsl::span<const int32_t> active_rows,
+                           OrtValue& batch_logits);
+
+  // Keep only the given rows (indices into the current active rows) in the subgraph feeds and present state.
+  Status EvictFinishedRows(gsl::span<const int32_t> kept_rows,
+                           std::vector<OrtValue>& fetches,
+                           std::vector<OrtValue>& feeds,
+                           OrtValue& position_ids,
+                           gsl::span<int32_t> next_positions);
+
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
   GptSubgraph& gpt_subgraph_;
@@ -187,6 +201,94 @@ Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
                             false);
 }
 
+template <typename T, typename ParametersT>
+void GreedySearchGpt<T, ParametersT>::ScatterActiveLogits(const OrtValue& logits,
+                                                          gsl::span<const int32_t> active_rows,
+                                                          OrtValue& batch_logits) {
+  const int vocab_size = this->parameters_->vocab_size;
+  if (!batch_logits.IsAllocated()) {
+    int64_t dims[] = {this->parameters_->batch_size, 1, vocab_size};
+    TensorShape shape(&dims[0], 3);
+    Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), shape, this->temp_space_allocator_, batch_logits);
+    gsl::span<T> data = batch_logits.GetMutable<Tensor>()->MutableDataAsSpan<T>();
+    std::fill(data.begin(), data.end(), T{});
+  }
+
+  // Logits has shape (active_batch_size, input_length, vocab_size). Rows of finished sequences keep stale values,
+  // which is fine since their next token is always replaced by pad token.
+  const Tensor& logits_tensor = logits.Get<Tensor>();
+  const auto input_length = logits_tensor.Shape()[1];
+  gsl::span<const T> source = logits_tensor.DataAsSpan<T>();
+  gsl::span<T> target = batch_logits.GetMutable<Tensor>()->MutableDataAsSpan<T>();
+  for (size_t i = 0; i < active_rows.size(); i++) {
+    const size_t offset = SafeInt<size_t>((static_cast<int64_t>(i) + 1) * input_length - 1) * vocab_size;
+    gsl::copy(source.subspan(offset, vocab_size),
+              target.subspan(SafeInt<size_t>(active_rows[i]) * vocab_size, vocab_size));
+  }
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::EvictFinishedRows(gsl::span<const int32_t> kept_rows,
+                                                          std::vector<OrtValue>& fetches,
+                                                          std::vector<OrtValue>& feeds,
+                                                          OrtValue& position_ids,
+                                                          gsl::span<int32_t> next_positions) {
+  const int64_t num_kept = static_cast<int64_t>(kept_rows.size());
+  auto int32_type = DataTypeImpl::GetType<int32_t>();
+
+  // Rows are kept in order, so position ids can be compacted in place.
+  for (size_t i = 0; i < kept_rows.size(); i++) {
+    next_positions[i] = next_positions[kept_rows[i]];
+  }
+  int64_t position_dims[] = {num_kept, 1};
+  TensorShape position_shape(&position_dims[0], 2);
+  Tensor::InitOrtValue(int32_type, position_shape, next_positions.data(),
+                       this->temp_space_allocator_->Info(), position_ids);
+
+  // Attention mask has shape (active_batch_size, current_length - 1) before it is extended by UpdateFeeds.
+  const Tensor& old_mask = feeds[2].Get<Tensor>();
+  const int64_t mask_length = old_mask.Shape()[1];
+  int64_t mask_dims[] = {num_kept, mask_length};
+  TensorShape mask_shape(&mask_dims[0], 2);
+  OrtValue attention_mask;
+  Tensor::InitOrtValue(int32_type, mask_shape, this->temp_space_allocator_, attention_mask);
+  gsl::span<const int32_t> old_mask_data = old_mask.DataAsSpan<int32_t>();
+  gsl::span<int32_t> mask_data = attention_mask.GetMutable<Tensor>()->MutableDataAsSpan<int32_t>();
+  for (size_t i = 0; i < kept_rows.size(); i++) {
+    gsl::copy(old_mask_data.subspan(SafeInt<size_t>(kept_rows[i]) * mask_length, onnxruntime::narrow<size_t>(mask_length)),
+              mask_data.subspan(SafeInt<size_t>(i) * mask_length, onnxruntime::narrow<size_t>(mask_length)));
+  }
+  feeds[2] = attention_mask;
+
+  // Present state has shape like (2, active_batch_size, num_heads, past_seq_len, head_size).
+  // UpdateFeeds will pass the compacted present state to past state of next iteration.
+  for (size_t idx = static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex()); idx < fetches.size(); ++idx) {
+    const Tensor& present = fetches[idx].Get<Tensor>();
+    const TensorShape& present_shape = present.Shape();
+    const size_t block_size_per_row = onnxruntime::narrow<size_t>(present_shape.SizeFromDimension(2));
+    const size_t present_half_size = SafeInt<size_t>(present_shape[1]) * block_size_per_row;
+    const size_t past_half_size = SafeInt<size_t>(num_kept) * block_size_per_row;
+
+    TensorShape past_shape = present_shape;
+    past_shape[1] = num_kept;
+    OrtValue past;
+    Tensor::InitOrtValue(present.DataType(), past_shape, this->temp_space_allocator_, past);
+
+    gsl::span<const T> present_span = present.DataAsSpan<T>();
+    gsl::span<T> past_span = past.GetMutable<Tensor>()->MutableDataAsSpan<T>();
+    for (size_t kv = 0; kv < 2; kv++) {
+      for (size_t i = 0; i < kept_rows.size(); i++) {
+        gsl::copy(present_span.subspan(kv * present_half_size + SafeInt<size_t>(kept_rows[i]) * block_size_per_row,
+                                       block_size_per_row),
+                  past_span.subspan(kv * past_half_size + i * block_size_per_row, block_size_per_row));
+      }
+    }
+    fetches[idx] = past;
+  }
+
+  return Status::OK();
+}
+
 template <typename T, typename ParametersT>
 Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                                                 const FeedsFetchesManager& feeds_fetches_manager) {
@@ -268,6 +370,16 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                        this->temp_space_allocator_->Info(),
                        position_ids);
 
+  // Finished sequences can be evicted from the subgraph batch when past state is not shared with present state.
+  // active_rows maps a row of the subgraph batch to its batch index.
+  const bool evict_finished = parameters->evict_finished_sequences && !this->IsCuda() &&
+                              !gpt_subgraph_.past_present_share_buffer_;
+  std::vector<int32_t> active_rows(static_cast<size_t>(parameters->BatchBeamSize()));
+  std::iota(active_rows.begin(), active_rows.end(), 0);
+  std::vector<int32_t> kept_rows;
+  std::vector<int32_t> active_next_tokens;
+  OrtValue batch_logits;
+
   int current_length = parameters->sequence_length;
   int iteration_counter = 0;
   while (current_length < parameters->max_length) {
@@ -312,7 +424,11 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
 
     ORT_RETURN_IF_ERROR(status);
 
-    const OrtValue& logits = fetches[0];
+    const bool has_evicted_rows = active_rows.size() < static_cast<size_t>(parameters->BatchBeamSize());
+    if (has_evicted_rows) {
+      ScatterActiveLogits(fetches[0], active_rows, batch_logits);
+    }
+    const OrtValue& logits = has_evicted_rows ? batch_logits : fetches[0];
     gsl::span<int32_t> next_tokens;
 
     ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits,
@@ -361,9 +477,33 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
     if (current_length < parameters->max_length) {
       bool increase_position = (iteration_counter > 1);
 
+      gsl::span<const int32_t> feed_tokens = ReinterpretAsSpan<const int32_t>(next_tokens);
+      if (evict_finished) {
+        kept_rows.clear();
+        for (size_t i = 0; i < active_rows.size(); i++) {
+          if (!eos_meet[active_rows[i]]) {
+            kept_rows.push_back(static_cast<int32_t>(i));
+          }
+        }
+
+        if (kept_rows.size() < active_rows.size()) {
+          ORT_RETURN_IF_ERROR(EvictFinishedRows(kept_rows, fetches, feeds, position_ids, greedy_state.next_positions));
+          for (size_t i = 0; i < kept_rows.size(); i++) {
+            active_rows[i] = active_rows[kept_rows[i]];
+          }
+          active_rows.resize(kept_rows.size());
+        }
+
+        active_next_tokens.resize(active_rows.size());
+        for (size_t i = 0; i < active_rows.size(); i++) {
+          active_next_tokens[i] = next_tokens[active_rows[i]];
+        }
+        feed_tokens = active_next_tokens;
+      }
+
       ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
                                       position_ids, increase_position,
-                                      ReinterpretAsSpan<const int32_t>(next_tokens),
+                                      feed_tokens,
                                       current_length - 1));
     }
     if (gpt_subgraph_.past_present_share_buffer_) {
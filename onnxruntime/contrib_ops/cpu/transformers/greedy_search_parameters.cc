@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "contrib_ops/cpu/transformers/greedy_search_parameters.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -15,6 +16,8 @@ void GreedySearchParameters::ParseFromAttributes(const OpKernelInfo& info) {
   decoder_start_token_id = static_cast<int>(info.GetAttrOrDefault<int64_t>("decoder_start_token_id", -1));
   no_repeat_ngram_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("no_repeat_ngram_size", 0));
   vocab_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("vocab_size", -1));
+  evict_finished_sequences =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsGenerationEvictFinishedSequences, "0") == "1";
 }
 
 void GreedySearchParameters::ParseFromInputs(OpKernelContext* context) {
@@ -38,23 +38,28 @@ template <typename T>
 void RepetitionPenaltyLogitsProcessor<T>::Process(const ISequences* sequences,
                                                   NextTokenScores<T>& next_token_scores) {
   const int batch_beam_size = next_token_scores.batch_beam_size;
+  penalized_.resize(next_token_scores.vocab_size, false);
   for (int i = 0; i < batch_beam_size; i++) {
     gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
     gsl::span<const int32_t> sequence = sequences->GetSequence(i);
 
-    // Find unique word IDs in sequence.
-    std::unordered_set<int32_t> unique_word_ids;
-    for (const auto& word_id : sequence) {
-      unique_word_ids.insert(word_id);
-    }
+    // Penalize each unique word ID in sequence once.
+    for (const int32_t word_id : sequence) {
+      if (penalized_[word_id]) {
+        continue;
+      }
+      penalized_[word_id] = true;
 
-    for (const int32_t word_id : unique_word_ids) {
       T score = beam_token_scores[word_id];
 
       // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
       // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
       beam_token_scores[word_id] = (score < 0 ? score * penalty_ : score / penalty_);
     }
+
+    for (const int32_t word_id : sequence) {
+      penalized_[word_id] = false;
+    }
   }
 }
 
@@ -62,6 +67,68 @@ template <typename T>
 NoRepeatNGramLogitsProcessor<T>::NoRepeatNGramLogitsProcessor(int ngram_size) : ngram_size_(ngram_size) {
 }
 
+template <typename T>
+size_t NoRepeatNGramLogitsProcessor<T>::HashPrefix(gsl::span<const int32_t> prefix) const {
+  size_t hash = 0;
+  for (const int32_t word_id : prefix) {
+    hash ^= std::hash<int32_t>{}(word_id) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+template <typename T>
+void NoRepeatNGramLogitsProcessor<T>::AddNGram(gsl::span<const int32_t> sequence,
+                                               int start,
+                                               NGramIndex& index) const {
+  const gsl::index prefix_length = static_cast<gsl::index>(ngram_size_) - 1;
+  index[HashPrefix(sequence.subspan(start, prefix_length))].push_back(start);
+}
+
+template <typename T>
+void NoRepeatNGramLogitsProcessor<T>::UpdateIndices(const ISequences* sequences, int batch_beam_size) {
+  const int sequence_length = sequences->GetSequenceLength();
+  gsl::span<const int32_t> beam_indices = sequences->GetLastBeamIndices();
+
+  const bool can_fork = indexed_length_ > 0 &&
+                        sequence_length == indexed_length_ + 1 &&
+                        indices_.size() == static_cast<size_t>(batch_beam_size) &&
+                        beam_indices.size() == static_cast<size_t>(batch_beam_size);
+
+  if (can_fork) {
+    // The index of a beam selected only once is moved, otherwise it is copied.
+    InlinedVector<int> remaining_forks(batch_beam_size, 0);
+    for (const int32_t beam_index : beam_indices) {
+      ++remaining_forks[beam_index];
+    }
+
+    next_indices_.resize(batch_beam_size);
+    for (int i = 0; i < batch_beam_size; i++) {
+      const int32_t beam_index = beam_indices[i];
+      if (--remaining_forks[beam_index] == 0) {
+        next_indices_[i] = std::move(indices_[beam_index]);
+      } else {
+        next_indices_[i] = indices_[beam_index];
+      }
+    }
+    indices_.swap(next_indices_);
+
+    for (int i = 0; i < batch_beam_size; i++) {
+      AddNGram(sequences->GetSequence(i), sequence_length - ngram_size_, indices_[i]);
+    }
+  } else {
+    indices_.resize(batch_beam_size);
+    for (int i = 0; i < batch_beam_size; i++) {
+      gsl::span<const int32_t> sequence = sequences->GetSequence(i);
+      indices_[i].clear();
+      for (int j = 0; j <= sequence_length - ngram_size_; j++) {
+        AddNGram(sequence, j, indices_[i]);
+      }
+    }
+  }
+
+  indexed_length_ = sequence_length;
+}
+
 template <typename T>
 void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
                                               NextTokenScores<T>& next_token_scores) {
@@ -72,6 +139,9 @@ void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
   const gsl::index prefix_length = static_cast<gsl::index>(ngram_size_) - 1;
   int batch_beam_size = next_token_scores.batch_beam_size;
 
+  // The index makes the cost per step independent of sequence length, except the N-grams sharing the same prefix.
+  UpdateIndices(sequences, batch_beam_size);
+
   for (int i = 0; i < batch_beam_size; i++) {
     gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
     gsl::span<const int32_t> sequence = sequences->GetSequence(i);
@@ -79,18 +149,16 @@ void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
     gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
     ORT_ENFORCE(prefix.size() == narrow<size_t>(prefix_length));
 
-    std::unordered_set<int32_t> blocked_word_ids;
-    for (int j = 0; j <= static_cast<int>(sequence.size()) - ngram_size_; j++) {
-      // Here we use naive algorithm for matching. The complexity is O(batch_beam_size * ngram_size * sequence_length)
-      // TODO(tianleiwu): build N-Gram index (hash table with prefix of length NGram - 1 as key,
-      //                  and list of last word of NGram as value) for fast matching.
-      if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
-        blocked_word_ids.insert(sequence[static_cast<gsl::index>(j) + prefix_length]);
-      }
+    auto it = indices_[i].find(HashPrefix(prefix));
+    if (it == indices_[i].end()) {
+      continue;
     }
 
-    for (const int32_t word_id : blocked_word_ids) {
-      beam_token_scores[word_id] = std::numeric_limits<T>::lowest();
+    for (const int32_t start : it->second) {
+      // Compare the prefix since different prefixes might have same hash value.
+      if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(start, prefix_length))) {
+        beam_token_scores[sequence[static_cast<gsl::index>(start) + prefix_length]] = std::numeric_limits<T>::lowest();
+      }
     }
   }
 }
@@ -76,6 +76,9 @@ class RepetitionPenaltyLogitsProcessor : public ILogitsProcessor<T> {
 
  private:
   float penalty_;
+
+  // Flags of word IDs that have been penalized for current beam. It is reset after each beam.
+  std::vector<bool> penalized_;
 };
 
 template <typename T>
@@ -87,7 +90,22 @@ class NoRepeatNGramLogitsProcessor : public ILogitsProcessor<T> {
                NextTokenScores<T>& next_token_scores) override;
 
  private:
+  // N-gram index of a sequence: hash of N-gram prefix (first ngram_size - 1 words) -> start positions of N-grams.
+  using NGramIndex = InlinedHashMap<size_t, InlinedVector<int32_t>>;
+
+  size_t HashPrefix(gsl::span<const int32_t> prefix) const;
+
+  void AddNGram(gsl::span<const int32_t> sequence, int start, NGramIndex& index) const;
+
+  // Update the index of each beam to cover all N-grams in current sequences.
+  // The index of previous step is forked to the beams selected from it, and the N-gram ending with the last word
+  // is added. The index is rebuilt from scratch when beam indices of previous step are not available.
+  void UpdateIndices(const ISequences* sequences, int batch_beam_size);
+
   int ngram_size_;
+  int indexed_length_ = 0;  // sequence length covered by indices_
+  std::vector<NGramIndex> indices_;
+  std::vector<NGramIndex> next_indices_;
 };
 
 template <typename T>
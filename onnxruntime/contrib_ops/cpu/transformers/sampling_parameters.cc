@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "contrib_ops/cpu/transformers/sampling_parameters.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -19,6 +20,8 @@ void SamplingParameters::ParseFromAttributes(const OpKernelInfo& info) {
   presence_penalty = info.GetAttrOrDefault<float>("presence_penalty", 0.0f);
   custom_sampling = static_cast<int>(info.GetAttrOrDefault<int64_t>("custom", 0));
   vocab_size = static_cast<int>(info.GetAttrOrDefault<int64_t>("vocab_size", -1));
+  evict_finished_sequences =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsGenerationEvictFinishedSequences, "0") == "1";
 }
 
 void SamplingParameters::ParseFromInputs(OpKernelContext* context) {
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
 #include "core/common/safeint.h"
 #include "contrib_ops/cpu/transformers/sequences.h"
 
@@ -16,6 +17,7 @@ void Sequences::Init(gsl::span<int32_t> buffer, int batch_beam_size, int sequenc
   sequences[1] = buffer.subspan(sequences_size);
 
   current_sequences_buffer = 0;
+  last_beam_indices_.clear();
 
   batch_beam_size_ = batch_beam_size;
   max_length_ = max_length;
@@ -55,6 +57,7 @@ void Sequences::AppendNextTokenToSequences(
     gsl::span<int32_t>& beam_next_tokens) {
   gsl::span<const int32_t> input = sequences[current_sequences_buffer];
   gsl::span<int32_t> output = sequences[current_sequences_buffer ^ 1];
+  last_beam_indices_.assign(beam_indices.begin(), beam_indices.end());
 
   for (int i = 0; i < batch_beam_size_; i++) {
     int beam_index = beam_indices[i];
@@ -77,6 +80,12 @@ void Sequences::AppendNextTokenToSequences(
 void Sequences::AppendNextTokenToSequences(gsl::span<int32_t>& next_tokens) {
   auto output = sequences[0];
 
+  // Sequences are extended in place, so each sequence comes from the same index.
+  if (last_beam_indices_.size() != static_cast<size_t>(batch_beam_size_)) {
+    last_beam_indices_.resize(batch_beam_size_);
+    std::iota(last_beam_indices_.begin(), last_beam_indices_.end(), 0);
+  }
+
   // Append next token to each sequence.
   for (int i = 0; i < batch_beam_size_; i++) {
     output[SafeInt<size_t>(i) * max_length_ + current_length_] = next_tokens[i];
@@ -86,6 +95,7 @@ void Sequences::AppendNextTokenToSequences(gsl::span<int32_t>& next_tokens) {
 }
 
 void Sequences::AfterDeviceAppendedNextToken() {
+  last_beam_indices_.clear();
   ++current_length_;
   current_sequences_buffer ^= 1;
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <gsl/gsl>
+#include "core/common/inlined_containers.h"
 #include "contrib_ops/cpu/transformers/generation_shared.h"
 
 namespace onnxruntime {
@@ -28,6 +29,9 @@ class Sequences : public ISequences {
   // Returns max sequence length.
   int GetMaxLength() const override;
 
+  // Returns beam indices of the last AppendNextTokenToSequences call.
+  gsl::span<const int32_t> GetLastBeamIndices() const override { return last_beam_indices_; }
+
 #ifdef DEBUG_GENERATION
   // Print the sequences to StdOut in debug mode
   void PrintSequences(const IConsoleDumper* dumper) const;
@@ -53,6 +57,9 @@ class Sequences : public ISequences {
   // Index (either 0 or 1) of two buffers that is currently is active.
   int current_sequences_buffer;
 
+  // Beam indices used in last round. It is empty when sequences are appended on device.
+  InlinedVector<int32_t> last_beam_indices_;
+
   int batch_beam_size_;
   int max_length_;
   int current_length_;
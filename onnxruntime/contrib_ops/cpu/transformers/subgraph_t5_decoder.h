@@ -72,12 +72,18 @@ class T5DecoderSubgraph : public Subgraph {
     return use_sequence_as_input_ids_;
   }
 
+  // Feed cross attention past key/value without expanding them to beams. Only used with CPU provider.
+  void SetShareCrossAttentionKV(bool share_cross_attention_kv) {
+    share_cross_attention_kv_ = share_cross_attention_kv;
+  }
+
  protected:
   int first_past_input_index_;
   int first_present_output_index_;
   bool has_hidden_state_;
   bool has_encoder_input_ids_;
   bool use_sequence_as_input_ids_;
+  bool share_cross_attention_kv_ = false;
 };
 
 }  // namespace transformers
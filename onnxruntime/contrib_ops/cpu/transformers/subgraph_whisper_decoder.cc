@@ -202,6 +202,11 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
     past_present_share_buffer_max_seq_len = 0;
   }
 
+  // Cross attention past key/value are the same for all beams of a batch. When sharing is enabled, they are fed with
+  // batch_size instead of batch_size * num_beams, and MultiHeadAttention broadcasts them to the beams.
+  const bool share_cross_attention_kv = share_cross_attention_kv_ && !past_present_share_buffer_ &&
+                                        GetProvider()->Type() == kCpuExecutionProvider;
+
   // When first_past_input_index_ == 2, the encoder_hidden_states and past states are copied from the second output
   // of encoder.
   // When first_past_input_index_ == 1, the past states are copied from the second output of encoder.
@@ -232,6 +237,12 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool use_max_seq_len = (j - first_past_input_index_) <= 2 * static_cast<size_t>(num_layers);
 
+      // The last 2 * num_layers outputs of encoder are past key/value for cross attention.
+      if (share_cross_attention_kv && j + 2 * static_cast<size_t>(num_layers) >= encoder_fetches.size()) {
+        decoder_feeds.push_back(encoder_fetches[j]);
+        continue;
+      }
+
       OrtValue expanded_cache;
       if (is_output_float16_) {
         ORT_RETURN_IF_ERROR(expand_buffer_float16_func(stream,
@@ -138,8 +138,8 @@ void MultiHeadAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& c
 
   // Q, K and V without packing and past (cross attention):
   //   Input 0 (query) has shape (batch_size, sequence_length, hidden_size)
-  //   Input 1 (key) has shape (batch_size, num_head, kv_sequence_length, head_size)
-  //   Input 2 (value) has shape (batch_size, num_head, kv_sequence_length, head_size)
+  //   Input 1 (key) has shape (batch_size or kv_batch_size, num_head, kv_sequence_length, head_size)
+  //   Input 2 (value) has shape (batch_size or kv_batch_size, num_head, kv_sequence_length, head_size)
 
   // Packed KV:
   //   Input 0 (query) has shape (batch_size, sequence_length, hidden_size)
@@ -320,6 +320,15 @@ void GroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext&
   // TODO(aciddelgado): propagate output shapes depending if kv-share buffer is on or not
   constexpr int use_max_past_present_buffer = -1;
   BaseGroupQueryAttentionTypeAndShapeInference(ctx, past_key_index, use_max_past_present_buffer);
+
+  // Quantized KV cache is int8, and its scales are float.
+  if (getAttribute(ctx, "kv_cache_bit_width", 0) != 0 && ctx.getNumOutputs() > 1) {
+    updateOutputElemType(ctx, 1, ONNX_NAMESPACE::TensorProto::INT8);
+    updateOutputElemType(ctx, 2, ONNX_NAMESPACE::TensorProto::INT8);
+    for (size_t i = 3; i < ctx.getNumOutputs(); i++) {
+      updateOutputElemType(ctx, i, ONNX_NAMESPACE::TensorProto::FLOAT);
+    }
+  }
 }
 
 void SparseAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int past_key_index) {
@@ -960,6 +969,11 @@ Multi-Head Self/Cross Attention. Bias from input projection is included.
 The key padding mask is optional. When its shape is (batch_size, kv_sequence_length), value 0
 means padding or 1 otherwise. When key has right-side padding, its shape could be (batch_size): it is actual length of
 each key sequence excluding paddings.
+
+For cross attention, key and value of shape (kv_batch_size, num_heads, kv_sequence_length, head_size) could have a
+kv_batch_size that divides batch_size, e.g. when the beams of a batch in beam search share the same encoder output.
+Query i then attends to key and value i / (batch_size / kv_batch_size). This is only supported by the CPU execution
+provider, and not with key_padding_mask, attention_bias, past_key, past_value or unidirectional.
 )DOC";
 
 ONNX_MS_OPERATOR_SET_SCHEMA(
@@ -984,12 +998,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .Input(1,
                "key",
                "Key with shape (batch_size, kv_sequence_length, hidden_size), or packed KV with shape (batch_size, kv_sequence_length, num_heads, 2, head_size), "
-               "or past_key with shape (batch_size, num_heads, kv_sequence_length, head_size)",
+               "or past_key with shape (batch_size or kv_batch_size, num_heads, kv_sequence_length, head_size)",
                "T",
                OpSchema::Optional)
         .Input(2,
                "value",
-               "Value with shape (batch_size, kv_sequence_length, v_hidden_size), or past_value with shape (batch_size, num_heads, kv_sequence_length, head_size)",
+               "Value with shape (batch_size, kv_sequence_length, v_hidden_size), "
+               "or past_value with shape (batch_size or kv_batch_size, num_heads, kv_sequence_length, head_size)",
                "T",
                OpSchema::Optional)
         .Input(3,
@@ -1082,6 +1097,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
               "Use a smooth factor in softmax.",
               AttributeProto::INT,
               static_cast<int64_t>(-1))
+        .Attr("kv_cache_bit_width",
+              "Bit width of quantized KV cache. Default value is 0, where past and present key/value have the same "
+              "type as query. When it is 8, past and present key/value are int8 quantized symmetrically with one scale "
+              "for each token of each kv head, and the scales are in past/present_key_scale and "
+              "past/present_value_scale. Only supported by CPU.",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
         .Input(0,
                "query",
                "Query with shape (batch_size, sequence_length, hidden_size), or packed QKV with shape"
@@ -1101,13 +1123,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "past_key",
                "past state key with support for format BNSH. When past_key uses same tensor as present_key"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(4,
                "past_value",
                "past state value with support for format BNSH. When past_value uses same tensor as present_value"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(5,
                "seqlens_k",
@@ -1128,6 +1150,18 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "2D tensor with shape (max_sequence_length, head_size / 2).",
                "T",
                OpSchema::Optional)
+        .Input(9,
+               "past_key_scale",
+               "Scale of quantized past_key with shape (batch_size, kv_num_heads, past_buffer_sequence_length). "
+               "Required when kv_cache_bit_width is not 0 and past_key is given.",
+               "tensor(float)",
+               OpSchema::Optional)
+        .Input(10,
+               "past_value_scale",
+               "Scale of quantized past_value with shape (batch_size, kv_num_heads, past_buffer_sequence_length). "
+               "Required when kv_cache_bit_width is not 0 and past_value is given.",
+               "tensor(float)",
+               OpSchema::Optional)
         .Output(0,
                 "output",
                 "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
@@ -1137,14 +1171,28 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "present state key with support for format BNSH. When past_key uses same tensor as present_key"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(2,
                 "present_value",
                 "present state value with support for format BNSH. When past_value uses same tensor as present_value"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
+        .Output(3,
+                "present_key_scale",
+                "Scale of quantized present_key with shape (batch_size, kv_num_heads, present_buffer_sequence_length). "
+                "Required when kv_cache_bit_width is not 0.",
+                "tensor(float)",
+                OpSchema::Optional)
+        .Output(4,
+                "present_value_scale",
+                "Scale of quantized present_value with shape (batch_size, kv_num_heads, "
+                "present_buffer_sequence_length). Required when kv_cache_bit_width is not 0.",
+                "tensor(float)",
+                OpSchema::Optional)
         .TypeConstraint("T", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T_CACHE", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)", "tensor(int8)"},
+                        "Constrain KV cache to float tensors, or int8 tensors for quantized KV cache.")
         .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask to int tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
           GroupQueryAttentionTypeAndShapeInference(ctx, 3);
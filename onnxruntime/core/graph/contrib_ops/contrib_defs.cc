@@ -1136,6 +1136,43 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           updateOutputShape(ctx, 0, resultShape);
         }));
 
+constexpr const char* MultiLoRAMatMul_ver1_doc = R"DOC(
+Matrix product with a base weight shared by all batch rows, plus a low-rank (LoRA) update selected per batch row
+from a stack of adapters. It allows requests using different adapters to be served in one batch:
+
+  Y[i] = A[i] * B + alpha * (A[i] * lora_a[adapter_ids[i]]) * lora_b[adapter_ids[i]]
+
+No low-rank update is applied to batch row i when adapter_ids[i] is negative. Adapters of different ranks could be
+stacked by padding lora_a and lora_b with zeros to the maximum rank.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    MultiLoRAMatMul, 1,
+    OpSchema()
+        .SetDoc(MultiLoRAMatMul_ver1_doc)
+        .Attr("alpha", "Scaling factor of the low-rank update.", AttributeProto::FLOAT, 1.0f)
+        .Input(0, "A", "Input tensor with shape (batch_size, ..., K)", "T")
+        .Input(1, "B", "Base weight with shape (K, N)", "T")
+        .Input(2, "lora_a", "Stacked LoRA A weights with shape (num_adapters, K, rank)", "T")
+        .Input(3, "lora_b", "Stacked LoRA B weights with shape (num_adapters, rank, N)", "T")
+        .Input(4, "adapter_ids", "Adapter index of each batch row with shape (batch_size). Negative for no adapter.", "I")
+        .Output(0, "Y", "Output tensor with shape (batch_size, ..., N)", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeConstraint("I", {"tensor(int32)"}, "Constrain adapter ids to int32 tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          if (hasInputShape(ctx, 0) && hasInputShape(ctx, 1)) {
+            const auto& a_shape = getInputShape(ctx, 0);
+            const auto& b_shape = getInputShape(ctx, 1);
+            if (a_shape.dim_size() < 2 || b_shape.dim_size() != 2) {
+              fail_shape_inference("Input A shall have at least 2 dimensions and input B shall be 2D");
+            }
+            ONNX_NAMESPACE::TensorShapeProto output_shape(a_shape);
+            *output_shape.mutable_dim(a_shape.dim_size() - 1) = b_shape.dim(1);
+            updateOutputShape(ctx, 0, output_shape);
+          }
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(BeamSearch, 1,
                             OpSchema()
                                 .SetDoc("Beam Search for text generation. Supports GPT-2 decoder.")
@@ -835,6 +835,29 @@ MlasConvDepthwise(
     size_t KernelSize
     );
 
+/**
+ * @brief Depthwise convolution for fp32 NHWC
+ * @param Input         Indirect buffer to activations
+ * @param Filter        Filter in (kernel_size x channels) layout
+ * @param Bias          Optional bias vector, may be nullptr
+ * @param Output        Address of the result tensor
+ * @param Channels      C in NHWC
+ * @param OutputCount   Number of output pixels
+ * @param KernelSize    Size of the kernel
+ * @return
+*/
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Symmetric quantized integer convolution routines.
 //
@@ -978,6 +1001,93 @@ MlasMaximumPool(
     size_t KernelSize
     );
 
+/**
+ * @brief Max Pooling for fp32 NHWC
+ * @param Input         Indirect buffer to activations, nullptr entries are skipped
+ * @param Output        Address of the result tensor
+ * @param Channels      C in NHWC
+ * @param OutputCount   Number of output pixels
+ * @param KernelSize    Size of the kernel
+ * @return
+*/
+void
+MLASCALL
+MlasNhwcMaxPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+/**
+ * @brief Avg Pooling for fp32 NHWC
+ * @param Input         Indirect buffer to activations, nullptr entries are
+ *                      excluded from the average
+ * @param Output        Address of the result tensor
+ * @param Channels      C in NHWC
+ * @param OutputCount   Number of output pixels
+ * @param KernelSize    Size of the kernel
+ * @return
+*/
+void
+MLASCALL
+MlasNhwcAvgPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+//
+// Resize routines.
+//
+
+/**
+ * @brief Weighted sum of input rows, the vertical pass of a separable
+ *        linear or cubic interpolation
+ * @param Rows          Addresses of the input rows
+ * @param Weights       Weight of each input row
+ * @param RowCount      Number of input rows
+ * @param Output        Address of the output row
+ * @param Length        Number of elements in each row
+ * @return
+*/
+void
+MLASCALL
+MlasInterpolateRows(
+    const float* const* Rows,
+    const float* Weights,
+    size_t RowCount,
+    float* Output,
+    size_t Length
+    );
+
+/**
+ * @brief Weighted sum of input pixels within a row, the horizontal pass of a
+ *        separable linear or cubic interpolation. Vectorized across channels.
+ * @param Input         Address of the input row, InputWidth x Channels
+ * @param Indices       TapCount input pixel indices for each output pixel
+ * @param Weights       TapCount weights for each output pixel
+ * @param TapCount      Number of input pixels for each output pixel
+ * @param Output        Address of the output row, OutputCount x Channels
+ * @param OutputCount   Number of output pixels
+ * @param Channels      Number of channels, 1 for NCHW rows
+ * @return
+*/
+void
+MLASCALL
+MlasInterpolateColumns(
+    const float* Input,
+    const int32_t* Indices,
+    const float* Weights,
+    size_t TapCount,
+    float* Output,
+    size_t OutputCount,
+    size_t Channels
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -1458,6 +1568,47 @@ MlasRotaryEmbedOneRow(
     T* output
 );
 
+/**
+ * @brief Layer normalization of one row, optionally fused with a residual add.
+ *
+ * Computes S = Input + Skip + Bias and then
+ *   Output = (S - mean(S)) / sqrt(var(S) + Epsilon) * Scale + Shift
+ * or, when Simplified (RMS normalization),
+ *   Output = S / sqrt(mean(S * S) + Epsilon) * Scale.
+ * The statistics are accumulated in single precision for all data types.
+ *
+ * @tparam T: data type of input, skip and outputs. Currently only float32/16 are supported.
+ * @param Input:       input row, of shape [N]
+ * @param Skip:        residual row, of shape [N], or nullptr
+ * @param Bias:        bias added before normalization, of shape [N], or nullptr
+ * @param Scale:       scale (gamma), of shape [N]
+ * @param Shift:       shift (beta), of shape [N], or nullptr. Ignored when Simplified.
+ * @param Output:      output row, of shape [N]
+ * @param SkipOutput:  receives S, of shape [N], or nullptr
+ * @param N:           number of elements in the row
+ * @param Epsilon:     value added to the variance to avoid division by zero
+ * @param Simplified:  whether to skip the mean subtraction (RMS normalization)
+ * @param Mean:        receives the mean of S, or nullptr. Zero when Simplified.
+ * @param InvStdDev:   receives the reciprocal of the standard deviation, or nullptr
+ */
+template <typename T>
+void
+MLASCALL
+MlasLayerNormalizationOneRow(
+    const T* Input,
+    const T* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    T* Output,
+    T* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+);
+
 /**
  * @brief Supply matrices data information to half precision gemm functions
  */
@@ -435,3 +435,32 @@ MlasQDQTransposeBlockwiseQuantized(
     int quant_block_size,
     MLAS_THREADPOOL* thread_pool
 );
+
+/**
+ * @brief Dequantize a run of consecutive elements of a blockwise int4/uint4 quantized tensor
+ *        whose quantize axis is the innermost axis, e.g. one row of a quantized embedding table.
+ *        Elements are packed two per byte, the element with the lower index in the low nibble.
+ *        The run starts at the beginning of a quantization block.
+ * @tparam Tout             type of the scales and the dequantized elements, float or MLAS_FP16
+ * @tparam signed_quant     true when the quantized type is int4, false when it is uint4
+ * @param dst               points to the dequantized elements, [count]
+ * @param src               points to the packed quantized tensor
+ * @param src_offset        index of the first element of the run in src
+ * @param scales            points to the scales of the run, [ceil(count / block_size)]
+ * @param zero_points       points to the packed zero points tensor, or nullptr for a zero point of 0
+ * @param zero_point_offset index of the zero point of the first block of the run in zero_points
+ * @param block_size        number of elements that share a scale and zero point
+ * @param count             number of elements in the run
+ */
+template <typename Tout, bool signed_quant>
+void
+MlasDequantizeBlockwiseRun(
+    Tout* dst,
+    const uint8_t* src,
+    size_t src_offset,
+    const Tout* scales,
+    const uint8_t* zero_points,
+    size_t zero_point_offset,
+    size_t block_size,
+    size_t count
+);
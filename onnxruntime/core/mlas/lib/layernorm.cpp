@@ -0,0 +1,466 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernels used by the
+    LayerNormalization, SimplifiedLayerNormalization (RMSNorm) and
+    SkipLayerNormalization operators for single and half precision rows.
+
+    The row is processed in blocks that fit in the L1 cache. The first pass
+    forms each block of the (optionally residual added) input, computes the
+    block mean and sum of squared deviations from the cached block, and merges
+    them into the row statistics. The second pass rebuilds each block and
+    applies the normalization, scale and shift. Statistics are accumulated in
+    single precision for half precision rows.
+
+--*/
+
+#include "mlasi.h"
+
+namespace {
+
+//
+// Number of elements in a row block. Half precision rows are converted through
+// stack buffers of this size.
+//
+
+constexpr size_t MlasLayerNormBlockSize = 256;
+
+float
+MlasLayerNormSum(
+    const float* Values,
+    size_t N
+    )
+{
+    MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Accumulator2 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Accumulator3 = MlasZeroFloat32x4();
+
+    size_t i = 0;
+
+    for (; i + 16 <= N; i += 16) {
+        Accumulator0 = MlasAddFloat32x4(Accumulator0, MlasLoadFloat32x4(Values + i));
+        Accumulator1 = MlasAddFloat32x4(Accumulator1, MlasLoadFloat32x4(Values + i + 4));
+        Accumulator2 = MlasAddFloat32x4(Accumulator2, MlasLoadFloat32x4(Values + i + 8));
+        Accumulator3 = MlasAddFloat32x4(Accumulator3, MlasLoadFloat32x4(Values + i + 12));
+    }
+
+    for (; i + 4 <= N; i += 4) {
+        Accumulator0 = MlasAddFloat32x4(Accumulator0, MlasLoadFloat32x4(Values + i));
+    }
+
+    Accumulator0 = MlasAddFloat32x4(MlasAddFloat32x4(Accumulator0, Accumulator1),
+                                    MlasAddFloat32x4(Accumulator2, Accumulator3));
+    float Sum = MlasReduceAddFloat32x4(Accumulator0);
+
+    for (; i < N; i++) {
+        Sum += Values[i];
+    }
+
+    return Sum;
+}
+
+float
+MlasLayerNormSumSquares(
+    const float* Values,
+    size_t N,
+    float Center
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sum of the squared differences between the values
+    and the center value.
+
+--*/
+{
+    MLAS_FLOAT32X4 CenterVector = MlasBroadcastFloat32x4(Center);
+    MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Accumulator2 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Accumulator3 = MlasZeroFloat32x4();
+
+    size_t i = 0;
+
+    for (; i + 16 <= N; i += 16) {
+        MLAS_FLOAT32X4 Delta0 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Values + i), CenterVector);
+        MLAS_FLOAT32X4 Delta1 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Values + i + 4), CenterVector);
+        MLAS_FLOAT32X4 Delta2 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Values + i + 8), CenterVector);
+        MLAS_FLOAT32X4 Delta3 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Values + i + 12), CenterVector);
+        Accumulator0 = MlasMultiplyAddFloat32x4(Delta0, Delta0, Accumulator0);
+        Accumulator1 = MlasMultiplyAddFloat32x4(Delta1, Delta1, Accumulator1);
+        Accumulator2 = MlasMultiplyAddFloat32x4(Delta2, Delta2, Accumulator2);
+        Accumulator3 = MlasMultiplyAddFloat32x4(Delta3, Delta3, Accumulator3);
+    }
+
+    for (; i + 4 <= N; i += 4) {
+        MLAS_FLOAT32X4 Delta = MlasSubtractFloat32x4(MlasLoadFloat32x4(Values + i), CenterVector);
+        Accumulator0 = MlasMultiplyAddFloat32x4(Delta, Delta, Accumulator0);
+    }
+
+    Accumulator0 = MlasAddFloat32x4(MlasAddFloat32x4(Accumulator0, Accumulator1),
+                                    MlasAddFloat32x4(Accumulator2, Accumulator3));
+    float Sum = MlasReduceAddFloat32x4(Accumulator0);
+
+    for (; i < N; i++) {
+        float Delta = Values[i] - Center;
+        Sum += Delta * Delta;
+    }
+
+    return Sum;
+}
+
+void
+MlasLayerNormAddRow(
+    const float* Addend,
+    float* Values,
+    size_t N
+    )
+{
+    size_t i = 0;
+
+    for (; i + 4 <= N; i += 4) {
+        MlasStoreFloat32x4(Values + i, MlasAddFloat32x4(MlasLoadFloat32x4(Values + i), MlasLoadFloat32x4(Addend + i)));
+    }
+
+    for (; i < N; i++) {
+        Values[i] += Addend[i];
+    }
+}
+
+void
+MlasLayerNormScaleShift(
+    const float* Values,
+    const float* Scale,
+    const float* Shift,
+    float Mean,
+    float InvStdDev,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output = (Values - Mean) * InvStdDev * Scale + Shift.
+    Shift is optional.
+
+--*/
+{
+    MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDev);
+
+    size_t i = 0;
+
+    if (Shift != nullptr) {
+
+        for (; i + 4 <= N; i += 4) {
+            MLAS_FLOAT32X4 Normalized =
+                MlasMultiplyFloat32x4(MlasSubtractFloat32x4(MlasLoadFloat32x4(Values + i), MeanVector), InvStdDevVector);
+            MlasStoreFloat32x4(Output + i, MlasMultiplyAddFloat32x4(Normalized, MlasLoadFloat32x4(Scale + i),
+                                                                    MlasLoadFloat32x4(Shift + i)));
+        }
+
+        for (; i < N; i++) {
+            Output[i] = (Values[i] - Mean) * InvStdDev * Scale[i] + Shift[i];
+        }
+
+    } else {
+
+        for (; i + 4 <= N; i += 4) {
+            MLAS_FLOAT32X4 Normalized =
+                MlasMultiplyFloat32x4(MlasSubtractFloat32x4(MlasLoadFloat32x4(Values + i), MeanVector), InvStdDevVector);
+            MlasStoreFloat32x4(Output + i, MlasMultiplyFloat32x4(Normalized, MlasLoadFloat32x4(Scale + i)));
+        }
+
+        for (; i < N; i++) {
+            Output[i] = (Values[i] - Mean) * InvStdDev * Scale[i];
+        }
+    }
+}
+
+//
+// Row accessors. For single precision, the residual sum is formed in the output
+// row, which then serves as the block buffer for both passes. For half
+// precision, each block is converted into a stack buffer and rebuilt by the
+// second pass, so the only traffic to memory is the half precision input and
+// output.
+//
+
+template<typename T>
+struct MlasLayerNormRow;
+
+template<>
+struct MlasLayerNormRow<float>
+{
+    static
+    const float*
+    LoadBlock(
+        const float* Input,
+        const float* Skip,
+        const float* Bias,
+        float* Output,
+        float* SkipOutput,
+        float* Buffer,
+        size_t N
+        )
+    {
+        MLAS_UNREFERENCED_PARAMETER(Buffer);
+
+        if (Skip == nullptr && Bias == nullptr) {
+            if (SkipOutput != nullptr) {
+                std::copy_n(Input, N, SkipOutput);
+            }
+            return Input;
+        }
+
+        if (Skip != nullptr) {
+            size_t i = 0;
+            for (; i + 4 <= N; i += 4) {
+                MlasStoreFloat32x4(Output + i, MlasAddFloat32x4(MlasLoadFloat32x4(Input + i), MlasLoadFloat32x4(Skip + i)));
+            }
+            for (; i < N; i++) {
+                Output[i] = Input[i] + Skip[i];
+            }
+        } else {
+            std::copy_n(Input, N, Output);
+        }
+
+        if (Bias != nullptr) {
+            MlasLayerNormAddRow(Bias, Output, N);
+        }
+
+        if (SkipOutput != nullptr) {
+            std::copy_n(Output, N, SkipOutput);
+        }
+
+        return Output;
+    }
+
+    static
+    const float*
+    ReloadBlock(
+        const float* Input,
+        const float* Skip,
+        const float* Bias,
+        const float* Output,
+        float* Buffer,
+        size_t N
+        )
+    {
+        MLAS_UNREFERENCED_PARAMETER(Buffer);
+        MLAS_UNREFERENCED_PARAMETER(N);
+
+        return (Skip == nullptr && Bias == nullptr) ? Input : Output;
+    }
+
+    static constexpr bool NormalizeInPlace = true;
+};
+
+template<>
+struct MlasLayerNormRow<MLAS_FP16>
+{
+    static
+    const float*
+    LoadBlock(
+        const MLAS_FP16* Input,
+        const MLAS_FP16* Skip,
+        const float* Bias,
+        MLAS_FP16* Output,
+        MLAS_FP16* SkipOutput,
+        float* Buffer,
+        size_t N
+        )
+    {
+        MLAS_UNREFERENCED_PARAMETER(Output);
+
+        const float* Values = ReloadBlock(Input, Skip, Bias, nullptr, Buffer, N);
+
+        if (SkipOutput != nullptr) {
+            MlasConvertFloatToHalfBuffer(Values, SkipOutput, N);
+        }
+
+        return Values;
+    }
+
+    static
+    const float*
+    ReloadBlock(
+        const MLAS_FP16* Input,
+        const MLAS_FP16* Skip,
+        const float* Bias,
+        const MLAS_FP16* Output,
+        float* Buffer,
+        size_t N
+        )
+    {
+        MLAS_UNREFERENCED_PARAMETER(Output);
+
+        MlasConvertHalfToFloatBuffer(Input, Buffer, N);
+
+        if (Skip != nullptr) {
+            float SkipBuffer[MlasLayerNormBlockSize];
+            MlasConvertHalfToFloatBuffer(Skip, SkipBuffer, N);
+            MlasLayerNormAddRow(SkipBuffer, Buffer, N);
+        }
+
+        if (Bias != nullptr) {
+            MlasLayerNormAddRow(Bias, Buffer, N);
+        }
+
+        return Buffer;
+    }
+
+    static
+    void
+    StoreBlock(
+        const float* Values,
+        MLAS_FP16* Output,
+        size_t N
+        )
+    {
+        MlasConvertFloatToHalfBuffer(Values, Output, N);
+    }
+
+    static constexpr bool NormalizeInPlace = false;
+};
+
+template<typename T>
+void
+MlasLayerNormalizationOneRowImpl(
+    const T* Input,
+    const T* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    T* Output,
+    T* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    using Row = MlasLayerNormRow<T>;
+
+    float Buffer[MlasLayerNormBlockSize];
+
+    //
+    // Accumulate the row statistics. Blocks are merged with the pairwise update
+    // of Chan et al., so the variance is computed from deviations about the
+    // block mean rather than from the difference of two large sums.
+    //
+
+    float RowMean = 0.0f;
+    float RowM2 = 0.0f;
+
+    for (size_t b = 0; b < N; b += MlasLayerNormBlockSize) {
+
+        const size_t Count = std::min(MlasLayerNormBlockSize, N - b);
+
+        const float* Values = Row::LoadBlock(Input + b, (Skip != nullptr) ? Skip + b : nullptr,
+                                             (Bias != nullptr) ? Bias + b : nullptr, Output + b,
+                                             (SkipOutput != nullptr) ? SkipOutput + b : nullptr, Buffer, Count);
+
+        if (Simplified) {
+            RowM2 += MlasLayerNormSumSquares(Values, Count, 0.0f);
+            continue;
+        }
+
+        const float BlockMean = MlasLayerNormSum(Values, Count) / float(Count);
+        const float BlockM2 = MlasLayerNormSumSquares(Values, Count, BlockMean);
+
+        const float Delta = BlockMean - RowMean;
+        const float Total = float(b + Count);
+        RowMean += Delta * (float(Count) / Total);
+        RowM2 += BlockM2 + Delta * Delta * (float(b) * float(Count) / Total);
+    }
+
+    const float RowInvStdDev = 1.0f / std::sqrt(RowM2 / float(N) + Epsilon);
+
+    if (Mean != nullptr) {
+        *Mean = RowMean;
+    }
+
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+
+    //
+    // Normalize the row.
+    //
+
+    for (size_t b = 0; b < N; b += MlasLayerNormBlockSize) {
+
+        const size_t Count = std::min(MlasLayerNormBlockSize, N - b);
+
+        const float* Values = Row::ReloadBlock(Input + b, (Skip != nullptr) ? Skip + b : nullptr,
+                                               (Bias != nullptr) ? Bias + b : nullptr, Output + b, Buffer, Count);
+
+        if constexpr (Row::NormalizeInPlace) {
+            MlasLayerNormScaleShift(Values, Scale + b, Simplified || Shift == nullptr ? nullptr : Shift + b,
+                                    RowMean, RowInvStdDev, Output + b, Count);
+        } else {
+            MlasLayerNormScaleShift(Values, Scale + b, Simplified || Shift == nullptr ? nullptr : Shift + b,
+                                    RowMean, RowInvStdDev, Buffer, Count);
+            Row::StoreBlock(Buffer, Output + b, Count);
+        }
+    }
+}
+
+}  // namespace
+
+template<>
+void
+MLASCALL
+MlasLayerNormalizationOneRow<float>(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    MlasLayerNormalizationOneRowImpl<float>(Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon,
+                                            Simplified, Mean, InvStdDev);
+}
+
+template<>
+void
+MLASCALL
+MlasLayerNormalizationOneRow<MLAS_FP16>(
+    const MLAS_FP16* Input,
+    const MLAS_FP16* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    MLAS_FP16* Output,
+    MLAS_FP16* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    MlasLayerNormalizationOneRowImpl<MLAS_FP16>(Input, Skip, Bias, Scale, Shift, Output, SkipOutput, N, Epsilon,
+                                                Simplified, Mean, InvStdDev);
+}
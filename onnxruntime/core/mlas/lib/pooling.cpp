@@ -1701,3 +1701,194 @@ MlasMaximumPool<uint8_t>(
     size_t OutputCount,
     size_t KernelSize
     );
+
+template<bool IsMaxPool>
+void
+MlasNhwcPoolFloat(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision maximum or average pooling
+    operation for tensors in channels last format.
+
+    The input is supplied as an indirection buffer. Every pointer in the
+    indirection buffer points at a Channels length vector from the input
+    tensor, a vector of padding values or is nullptr. Null entries are
+    excluded from the aggregation, so average pooling divides by the number
+    of non-null entries.
+
+Arguments:
+
+    Input - Supplies an indirection buffer to the elements of the input tensor.
+
+    Output - Supplies the output tensor in channels last format.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of channel sized output elements to
+        produce.
+
+    KernelSize - Supplies the total number of channel sized kernel elements to
+        consume.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float InitialValue = IsMaxPool ? std::numeric_limits<float>::lowest() : 0.0f;
+    const MLAS_FLOAT32X4 InitialVector = MlasBroadcastFloat32x4(InitialValue);
+
+    while (OutputCount > 0) {
+
+        float Scale = 1.0f;
+
+        if constexpr (!IsMaxPool) {
+            size_t ValidCount = 0;
+            for (size_t k = 0; k < KernelSize; k++) {
+                ValidCount += (Input[k] != nullptr) ? 1 : 0;
+            }
+            Scale = (ValidCount > 0) ? 1.0f / float(ValidCount) : 0.0f;
+        }
+
+        const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+        size_t ChannelOffset = 0;
+        size_t c = Channels;
+
+        while (c >= 16) {
+
+            MLAS_FLOAT32X4 Aggregate0 = InitialVector;
+            MLAS_FLOAT32X4 Aggregate1 = InitialVector;
+            MLAS_FLOAT32X4 Aggregate2 = InitialVector;
+            MLAS_FLOAT32X4 Aggregate3 = InitialVector;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                if (Input[k] == nullptr) {
+                    continue;
+                }
+
+                const float* InputRow = Input[k] + ChannelOffset;
+
+                if constexpr (IsMaxPool) {
+                    Aggregate0 = MlasMaximumFloat32x4(Aggregate0, MlasLoadFloat32x4(InputRow));
+                    Aggregate1 = MlasMaximumFloat32x4(Aggregate1, MlasLoadFloat32x4(InputRow + 4));
+                    Aggregate2 = MlasMaximumFloat32x4(Aggregate2, MlasLoadFloat32x4(InputRow + 8));
+                    Aggregate3 = MlasMaximumFloat32x4(Aggregate3, MlasLoadFloat32x4(InputRow + 12));
+                } else {
+                    Aggregate0 = MlasAddFloat32x4(Aggregate0, MlasLoadFloat32x4(InputRow));
+                    Aggregate1 = MlasAddFloat32x4(Aggregate1, MlasLoadFloat32x4(InputRow + 4));
+                    Aggregate2 = MlasAddFloat32x4(Aggregate2, MlasLoadFloat32x4(InputRow + 8));
+                    Aggregate3 = MlasAddFloat32x4(Aggregate3, MlasLoadFloat32x4(InputRow + 12));
+                }
+            }
+
+            if constexpr (!IsMaxPool) {
+                Aggregate0 = MlasMultiplyFloat32x4(Aggregate0, ScaleVector);
+                Aggregate1 = MlasMultiplyFloat32x4(Aggregate1, ScaleVector);
+                Aggregate2 = MlasMultiplyFloat32x4(Aggregate2, ScaleVector);
+                Aggregate3 = MlasMultiplyFloat32x4(Aggregate3, ScaleVector);
+            }
+
+            MlasStoreFloat32x4(&Output[0], Aggregate0);
+            MlasStoreFloat32x4(&Output[4], Aggregate1);
+            MlasStoreFloat32x4(&Output[8], Aggregate2);
+            MlasStoreFloat32x4(&Output[12], Aggregate3);
+            Output += 16;
+
+            ChannelOffset += 16;
+            c -= 16;
+        }
+
+        while (c >= 4) {
+
+            MLAS_FLOAT32X4 Aggregate = InitialVector;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                if (Input[k] == nullptr) {
+                    continue;
+                }
+
+                MLAS_FLOAT32X4 InputVector = MlasLoadFloat32x4(Input[k] + ChannelOffset);
+
+                if constexpr (IsMaxPool) {
+                    Aggregate = MlasMaximumFloat32x4(Aggregate, InputVector);
+                } else {
+                    Aggregate = MlasAddFloat32x4(Aggregate, InputVector);
+                }
+            }
+
+            if constexpr (!IsMaxPool) {
+                Aggregate = MlasMultiplyFloat32x4(Aggregate, ScaleVector);
+            }
+
+            MlasStoreFloat32x4(Output, Aggregate);
+            Output += 4;
+
+            ChannelOffset += 4;
+            c -= 4;
+        }
+
+        while (c > 0) {
+
+            float Aggregate = InitialValue;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                if (Input[k] == nullptr) {
+                    continue;
+                }
+
+                if constexpr (IsMaxPool) {
+                    Aggregate = std::max(Aggregate, Input[k][ChannelOffset]);
+                } else {
+                    Aggregate += Input[k][ChannelOffset];
+                }
+            }
+
+            *Output++ = IsMaxPool ? Aggregate : Aggregate * Scale;
+
+            ChannelOffset += 1;
+            c -= 1;
+        }
+
+        Input += KernelSize;
+        OutputCount -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasNhwcMaxPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasNhwcPoolFloat<true>(Input, Output, Channels, OutputCount, KernelSize);
+}
+
+void
+MLASCALL
+MlasNhwcAvgPool(
+    const float* const* Input,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+{
+    MlasNhwcPoolFloat<false>(Input, Output, Channels, OutputCount, KernelSize);
+}
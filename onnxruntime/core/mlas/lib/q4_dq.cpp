@@ -1872,3 +1872,119 @@ MlasQDQTransposeBlockwiseQuantized<MLAS_FP16, 4, false>(
     int quant_block_size,
     MLAS_THREADPOOL* thread_pool
 );
+
+template <typename Tout, bool signed_quant>
+void
+MlasDequantizeBlockwiseRun(
+    Tout* dst,
+    const uint8_t* src,
+    size_t src_offset,
+    const Tout* scales,
+    const uint8_t* zero_points,
+    size_t zero_point_offset,
+    size_t block_size,
+    size_t count
+    )
+{
+    //
+    // A block has at most 16 distinct quantized values, so build a table of the
+    // dequantized values once per block and translate each nibble through it.
+    // This replaces the per element subtract, convert and multiply (and for half
+    // precision, the per element conversion) with a table lookup.
+    //
+
+    Tout table[16];
+
+    for (size_t block_start = 0; block_start < count; block_start += block_size) {
+
+        const size_t block_idx = block_start / block_size;
+        const float scale = static_cast<float>(scales[block_idx]);
+
+        int32_t zp = 0;
+        if (zero_points != nullptr) {
+            const size_t zp_idx = zero_point_offset + block_idx;
+            zp = static_cast<int32_t>((zero_points[zp_idx >> 1] >> ((zp_idx & 1) * 4)) & 0x0F);
+            if constexpr (signed_quant) {
+                zp = (zp ^ 0x08) - 0x08;
+            }
+        }
+
+        for (int32_t q = 0; q < 16; q++) {
+            int32_t value = q;
+            if constexpr (signed_quant) {
+                value = (value ^ 0x08) - 0x08;
+            }
+            table[q] = static_cast<Tout>(static_cast<float>(value - zp) * scale);
+        }
+
+        const size_t block_count = std::min(block_size, count - block_start);
+        Tout* out = dst + block_start;
+        size_t idx = src_offset + block_start;
+        size_t i = 0;
+
+        if ((idx & 1) != 0 && block_count > 0) {
+            out[i++] = table[src[idx >> 1] >> 4];
+            idx++;
+        }
+
+        const uint8_t* packed = src + (idx >> 1);
+
+        for (; i + 2 <= block_count; i += 2) {
+            const uint8_t byte = *packed++;
+            out[i] = table[byte & 0x0F];
+            out[i + 1] = table[byte >> 4];
+        }
+
+        if (i < block_count) {
+            out[i] = table[*packed & 0x0F];
+        }
+    }
+}
+
+template void
+MlasDequantizeBlockwiseRun<float, true>(
+    float* dst,
+    const uint8_t* src,
+    size_t src_offset,
+    const float* scales,
+    const uint8_t* zero_points,
+    size_t zero_point_offset,
+    size_t block_size,
+    size_t count
+);
+
+template void
+MlasDequantizeBlockwiseRun<float, false>(
+    float* dst,
+    const uint8_t* src,
+    size_t src_offset,
+    const float* scales,
+    const uint8_t* zero_points,
+    size_t zero_point_offset,
+    size_t block_size,
+    size_t count
+);
+
+template void
+MlasDequantizeBlockwiseRun<MLAS_FP16, true>(
+    MLAS_FP16* dst,
+    const uint8_t* src,
+    size_t src_offset,
+    const MLAS_FP16* scales,
+    const uint8_t* zero_points,
+    size_t zero_point_offset,
+    size_t block_size,
+    size_t count
+);
+
+template void
+MlasDequantizeBlockwiseRun<MLAS_FP16, false>(
+    MLAS_FP16* dst,
+    const uint8_t* src,
+    size_t src_offset,
+    const MLAS_FP16* scales,
+    const uint8_t* zero_points,
+    size_t zero_point_offset,
+    size_t block_size,
+    size_t count
+);
@@ -0,0 +1,214 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    resize.cpp
+
+Abstract:
+
+    This module implements the separable interpolation kernels used by the
+    linear and cubic modes of the resize operation for NCHW and NHWC tensors.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasInterpolateRows(
+    const float* const* Rows,
+    const float* Weights,
+    size_t RowCount,
+    float* Output,
+    size_t Length
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the weighted sum of a set of input rows. This
+    implements the vertical pass of a separable interpolation filter.
+
+Arguments:
+
+    Rows - Supplies the addresses of the input rows.
+
+    Weights - Supplies a weight for each input row.
+
+    RowCount - Supplies the number of input rows.
+
+    Output - Supplies the output buffer.
+
+    Length - Supplies the number of elements in each row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t i = 0;
+
+    for (; i + 16 <= Length; i += 16) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator2 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator3 = MlasZeroFloat32x4();
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const float* row = Rows[r] + i;
+            MLAS_FLOAT32X4 WeightVector = MlasBroadcastFloat32x4(Weights[r]);
+
+            Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(row), WeightVector, Accumulator0);
+            Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(row + 4), WeightVector, Accumulator1);
+            Accumulator2 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(row + 8), WeightVector, Accumulator2);
+            Accumulator3 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(row + 12), WeightVector, Accumulator3);
+        }
+
+        MlasStoreFloat32x4(Output + i, Accumulator0);
+        MlasStoreFloat32x4(Output + i + 4, Accumulator1);
+        MlasStoreFloat32x4(Output + i + 8, Accumulator2);
+        MlasStoreFloat32x4(Output + i + 12, Accumulator3);
+    }
+
+    for (; i + 4 <= Length; i += 4) {
+
+        MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Rows[r] + i),
+                                                   MlasBroadcastFloat32x4(Weights[r]), Accumulator);
+        }
+
+        MlasStoreFloat32x4(Output + i, Accumulator);
+    }
+
+    for (; i < Length; i++) {
+
+        float Accumulator = 0.0f;
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulator += Rows[r][i] * Weights[r];
+        }
+
+        Output[i] = Accumulator;
+    }
+}
+
+void
+MLASCALL
+MlasInterpolateColumns(
+    const float* Input,
+    const int32_t* Indices,
+    const float* Weights,
+    size_t TapCount,
+    float* Output,
+    size_t OutputCount,
+    size_t Channels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes each output pixel as the weighted sum of a set of
+    input pixels from a single row. This implements the horizontal pass of a
+    separable interpolation filter. The pixels are vectorized across the
+    channels, so a single channel (NCHW) row is processed one output element at
+    a time.
+
+Arguments:
+
+    Input - Supplies the input row of (InputWidth x Channels) elements.
+
+    Indices - Supplies TapCount input pixel indices for each output pixel.
+
+    Weights - Supplies TapCount weights for each output pixel.
+
+    TapCount - Supplies the number of input pixels for each output pixel.
+
+    Output - Supplies the output row of (OutputCount x Channels) elements.
+
+    OutputCount - Supplies the number of output pixels.
+
+    Channels - Supplies the number of channels of each pixel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Channels == 1) {
+
+        for (size_t o = 0; o < OutputCount; o++) {
+
+            float Accumulator = 0.0f;
+
+            for (size_t t = 0; t < TapCount; t++) {
+                Accumulator += Input[Indices[t]] * Weights[t];
+            }
+
+            Output[o] = Accumulator;
+            Indices += TapCount;
+            Weights += TapCount;
+        }
+
+        return;
+    }
+
+    for (size_t o = 0; o < OutputCount; o++) {
+
+        size_t c = 0;
+
+        for (; c + 8 <= Channels; c += 8) {
+
+            MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+
+            for (size_t t = 0; t < TapCount; t++) {
+
+                const float* pixel = Input + size_t(Indices[t]) * Channels + c;
+                MLAS_FLOAT32X4 WeightVector = MlasBroadcastFloat32x4(Weights[t]);
+
+                Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(pixel), WeightVector, Accumulator0);
+                Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(pixel + 4), WeightVector, Accumulator1);
+            }
+
+            MlasStoreFloat32x4(Output + c, Accumulator0);
+            MlasStoreFloat32x4(Output + c + 4, Accumulator1);
+        }
+
+        for (; c + 4 <= Channels; c += 4) {
+
+            MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+            for (size_t t = 0; t < TapCount; t++) {
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Input + size_t(Indices[t]) * Channels + c),
+                                                       MlasBroadcastFloat32x4(Weights[t]), Accumulator);
+            }
+
+            MlasStoreFloat32x4(Output + c, Accumulator);
+        }
+
+        for (; c < Channels; c++) {
+
+            float Accumulator = 0.0f;
+
+            for (size_t t = 0; t < TapCount; t++) {
+                Accumulator += Input[size_t(Indices[t]) * Channels + c] * Weights[t];
+            }
+
+            Output[c] = Accumulator;
+        }
+
+        Output += Channels;
+        Indices += TapCount;
+        Weights += TapCount;
+    }
+}
@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <deque>
 #include "core/mlas/inc/mlas.h"
 #include "core/graph/graph_utils.h"
@@ -167,6 +168,98 @@ NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator,
           OpTransformInfo{nhwc_gavgpool_fp16.op_type_, nhwc_gavgpool_fp16.domain_, nhwc_gavgpool_fp16.version_, false});
     }
   }
+
+  // The fp32 channels last kernels only pay off where the NchwcTransformer is not
+  // active, as the NCHWc kernels are faster than GEMM based NHWC convolutions.
+  if (MlasNchwcGetBlockSize() <= 1) {
+    {
+      // fp32 conv -> fp32 nhwc conv
+      OpKernelRegistryId nhwc_conv_fp32{
+          "NhwcFusedConv", kMSDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_,
+          nhwc_conv_fp32.version_, nhwc_conv_fp32.type_constraints_, logger, &kernel_create_info);
+      if (status.IsOK() && kernel_create_info != nullptr) {
+        kernel_create_info = nullptr;
+        conv_table_.emplace(
+            OpIdInfo("Conv", kOnnxDomain, api::DataType::FLOAT),
+            OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+        conv_table_.emplace(
+            OpIdInfo("FusedConv", kMSDomain, api::DataType::FLOAT),
+            OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+      }
+    }
+
+    {
+      // fp32 MaxPool -> fp32 nhwc MaxPool
+      OpKernelRegistryId nhwc_maxpool_fp32{
+          "MaxPool", kMSInternalNHWCDomain, 12, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, nhwc_maxpool_fp32.op_type_, nhwc_maxpool_fp32.domain_,
+          nhwc_maxpool_fp32.version_, nhwc_maxpool_fp32.type_constraints_, logger, &kernel_create_info);
+      if (status.IsOK() && kernel_create_info != nullptr) {
+        kernel_create_info = nullptr;
+        conv_table_.emplace(
+            OpIdInfo("MaxPool", kOnnxDomain, api::DataType::FLOAT),
+            OpTransformInfo{nhwc_maxpool_fp32.op_type_, nhwc_maxpool_fp32.domain_, nhwc_maxpool_fp32.version_, false});
+      }
+    }
+
+    {
+      // fp32 AveragePool -> fp32 nhwc AveragePool
+      OpKernelRegistryId nhwc_avgpool_fp32{
+          "AveragePool", kMSInternalNHWCDomain, 11, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, nhwc_avgpool_fp32.op_type_, nhwc_avgpool_fp32.domain_,
+          nhwc_avgpool_fp32.version_, nhwc_avgpool_fp32.type_constraints_, logger, &kernel_create_info);
+      if (status.IsOK() && kernel_create_info != nullptr) {
+        kernel_create_info = nullptr;
+        conv_table_.emplace(
+            OpIdInfo("AveragePool", kOnnxDomain, api::DataType::FLOAT),
+            OpTransformInfo{nhwc_avgpool_fp32.op_type_, nhwc_avgpool_fp32.domain_, nhwc_avgpool_fp32.version_, false});
+      }
+    }
+
+    {
+      // fp32 GlobalAveragePool -> fp32 nhwc GlobalAveragePool
+      OpKernelRegistryId nhwc_gavgpool_fp32{
+          "GlobalAveragePool", kMSInternalNHWCDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, nhwc_gavgpool_fp32.op_type_, nhwc_gavgpool_fp32.domain_,
+          nhwc_gavgpool_fp32.version_, nhwc_gavgpool_fp32.type_constraints_, logger, &kernel_create_info);
+      if (status.IsOK() && kernel_create_info != nullptr) {
+        kernel_create_info = nullptr;
+        conv_table_.emplace(
+            OpIdInfo("GlobalAveragePool", kOnnxDomain, api::DataType::FLOAT),
+            OpTransformInfo{nhwc_gavgpool_fp32.op_type_, nhwc_gavgpool_fp32.domain_, nhwc_gavgpool_fp32.version_, false});
+      }
+    }
+
+    {
+      // fp32 BatchNormalization -> fp32 nhwc BatchNormalization
+      OpKernelRegistryId nhwc_bn_fp32{
+          "BatchNormalization", kMSInternalNHWCDomain, 15, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, nhwc_bn_fp32.op_type_, nhwc_bn_fp32.domain_,
+          nhwc_bn_fp32.version_, nhwc_bn_fp32.type_constraints_, logger, &kernel_create_info);
+      if (status.IsOK() && kernel_create_info != nullptr) {
+        kernel_create_info = nullptr;
+        conv_table_.emplace(
+            OpIdInfo("BatchNormalization", kOnnxDomain, api::DataType::FLOAT),
+            OpTransformInfo{nhwc_bn_fp32.op_type_, nhwc_bn_fp32.domain_, nhwc_bn_fp32.version_, false});
+      }
+    }
+  }
 };
 
 Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
@@ -204,6 +297,21 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       continue;
     }
 
+    // Skip if an optional output beyond the first is produced (MaxPool indices,
+    // BatchNormalization training statistics), only output 0 is transposed.
+    const auto outputs = node->Outputs();
+    if (outputs.size() > 1 &&
+        std::any_of(outputs.begin() + 1, outputs.end(), [](std::string_view output) { return !output.empty(); })) {
+      continue;
+    }
+
+    // Skip per activation BatchNormalization from before opset 9, and training mode BatchNormalization that only
+    // produces Y, the NHWC kernel only supports inference.
+    if (node->OpType() == "BatchNormalization" && (node->GetAttributeIntDefault("spatial", 1) == 0 ||
+                                                   node->GetAttributeIntDefault("training_mode", 0) != 0)) {
+      continue;
+    }
+
     // Skip if unknown rank
     auto shape = NodeFromApiNode(*node).InputDefs()[0]->Shape();
     if (shape == nullptr) {
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "core/optimizer/scaler_linear_fusion.h"
+#include "core/framework/op_node_proto_helper.h"
+#include "core/graph/graph_utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsLinearClassifier(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "LinearClassifier", {1}, kMLDomain);
+}
+
+bool IsLinearRegressor(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "LinearRegressor", {1}, kMLDomain);
+}
+
+// Number of rows of the coefficients of a linear node. LinearClassifier has one intercept per class,
+// LinearRegressor states the number of targets in an attribute.
+int64_t GetNumTargets(const Node& linear_node) {
+  ProtoHelperNodeContext helper_ctx(linear_node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> helper(&helper_ctx);
+  if (IsLinearClassifier(linear_node)) {
+    return static_cast<int64_t>(helper.GetAttrsOrDefault<float>("intercepts").size());
+  }
+
+  return helper.GetAttrOrDefault<int64_t>("targets", 1);
+}
+
+}  // namespace
+
+bool ScalerLinearFusion::SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Scaler", {1}, kMLDomain) ||
+      node.GetOutputEdgesCount() != 1 ||
+      !graph_utils::CanRemoveNode(graph, node, logger)) {
+    return false;
+  }
+
+  const Node& linear_node = *node.OutputNodesBegin();
+  const bool is_regressor = IsLinearRegressor(linear_node);
+  if ((!is_regressor && !IsLinearClassifier(linear_node)) ||
+      // Make sure the two nodes do not span execution providers.
+      linear_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return false;
+  }
+
+  // The Scaler accepts double and integer input but LinearRegressor only accepts float.
+  if (is_regressor) {
+    const auto* input_type = node.InputDefs()[0]->TypeAsProto();
+    if (input_type == nullptr ||
+        input_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      return false;
+    }
+  }
+
+  ProtoHelperNodeContext scaler_helper_ctx(node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> scaler_helper(&scaler_helper_ctx);
+  const std::vector<float> scale = scaler_helper.GetAttrsOrDefault<float>("scale");
+  const std::vector<float> offset = scaler_helper.GetAttrsOrDefault<float>("offset");
+
+  ProtoHelperNodeContext linear_helper_ctx(linear_node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> linear_helper(&linear_helper_ctx);
+  const std::vector<float> coefficients = linear_helper.GetAttrsOrDefault<float>("coefficients");
+  const int64_t num_targets = GetNumTargets(linear_node);
+
+  if (scale.empty() || scale.size() != offset.size() || num_targets <= 0 || coefficients.empty() ||
+      coefficients.size() % static_cast<size_t>(num_targets) != 0) {
+    return false;
+  }
+
+  // The Scaler broadcasts a single scale and offset, otherwise it needs one per feature.
+  const size_t num_features = coefficients.size() / static_cast<size_t>(num_targets);
+  return scale.size() == 1 || scale.size() == num_features;
+}
+
+Status ScalerLinearFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect,
+                                 const logging::Logger& /*logger*/) const {
+  Node& linear_node = *graph.GetNode(node.OutputNodesBegin()->Index());
+
+  ProtoHelperNodeContext scaler_helper_ctx(node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> scaler_helper(&scaler_helper_ctx);
+  const std::vector<float> scale = scaler_helper.GetAttrsOrDefault<float>("scale");
+  const std::vector<float> offset = scaler_helper.GetAttrsOrDefault<float>("offset");
+
+  ProtoHelperNodeContext linear_helper_ctx(linear_node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> linear_helper(&linear_helper_ctx);
+  std::vector<float> coefficients = linear_helper.GetAttrsOrDefault<float>("coefficients");
+  std::vector<float> intercepts = linear_helper.GetAttrsOrDefault<float>("intercepts");
+
+  const size_t num_targets = static_cast<size_t>(GetNumTargets(linear_node));
+  const size_t num_features = coefficients.size() / num_targets;
+  const bool broadcast = scale.size() == 1;
+
+  // LinearRegressor ignores intercepts which do not match the number of targets.
+  if (intercepts.size() != num_targets) {
+    intercepts.assign(num_targets, 0.f);
+  }
+
+  // coefficients * ((X - offset) * scale) + intercepts
+  //   = (coefficients * scale) * X + (intercepts - coefficients * (scale * offset))
+  for (size_t t = 0; t < num_targets; ++t) {
+    float* row = coefficients.data() + t * num_features;
+    double shift = 0.0;
+    for (size_t f = 0; f < num_features; ++f) {
+      const size_t i = broadcast ? 0 : f;
+      row[f] *= scale[i];
+      shift += static_cast<double>(row[f]) * offset[i];
+    }
+
+    intercepts[t] = static_cast<float>(intercepts[t] - shift);
+  }
+
+  linear_node.ClearAttribute("coefficients");
+  linear_node.AddAttribute("coefficients", coefficients);
+  linear_node.ClearAttribute("intercepts");
+  linear_node.AddAttribute("intercepts", intercepts);
+
+  if (graph_utils::RemoveNode(graph, node)) {
+    rule_effect = RewriteRuleEffect::kRemovedCurrentNode;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/rewrite_rule.h"
+
+namespace onnxruntime {
+/**
+@Class ScalerLinearFusion
+
+Rewrite rule that folds a Scaler node into the coefficients and intercepts of the
+LinearClassifier or LinearRegressor node consuming its output, and removes the Scaler.
+
+Since the Scaler computes (X - offset) * scale, the fused linear node uses
+coefficients[t, f] * scale[f] and intercepts[t] - sum_f(coefficients[t, f] * scale[f] * offset[f]).
+*/
+class ScalerLinearFusion : public RewriteRule {
+ public:
+  ScalerLinearFusion() noexcept : RewriteRule("ScalerLinearFusion") {}
+
+  std::vector<std::string> TargetOpTypes() const noexcept override {
+    return {"Scaler"};
+  }
+
+ private:
+  bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override;
+
+  Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -12,6 +12,7 @@
 #include "core/providers/cpu/controlflow/loop.h"
 #include "core/providers/cpu/controlflow/utils.h"
 
+#include "core/common/safeint.h"
 #include "core/framework/allocator.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
@@ -23,6 +24,9 @@
 #include "core/framework/TensorSeq.h"
 #include "core/providers/utils.h"
 
+#include <algorithm>
+#include <array>
+
 #include <gsl/gsl>
 
 #ifdef _MSC_VER
@@ -193,6 +197,16 @@ Loop::Info::Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
     auto& output = subgraph_outputs[i];
     subgraph_output_names.push_back(output->Name());
   }
+
+  // 'cond' is either returned directly or through an Identity node
+  const auto& cond_input_name = subgraph_input_names[1];
+  const auto& cond_output_name = subgraph_output_names[0];
+  const auto* cond_producer = subgraph.GetProducerNode(cond_output_name);
+  const bool cond_is_loop_invariant =
+      cond_output_name == cond_input_name ||
+      (cond_producer != nullptr && cond_producer->OpType() == "Identity" &&
+       cond_producer->InputDefs()[0]->Name() == cond_input_name);
+  has_fixed_trip_count = cond_is_loop_invariant && node.GetExecutionProviderType() == kCpuExecutionProvider;
 }
 
 class LoopImpl {
@@ -211,11 +225,29 @@ class LoopImpl {
 
  private:
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
-  void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
+  Status SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
 
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
 
+  // custom fetch allocators that let the subgraph write loop carried variables to loop_carried_buffers_
+  // and scan outputs to slices of the Loop outputs.
+  void CreateFetchAllocators(const std::vector<OrtValue>& feeds,
+                             std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+  Status AllocateLoopCarriedVar(int index, const TensorShape& shape, const OrtDevice& location,
+                                const std::vector<OrtValue>& feeds, OrtValue& ort_value, bool& allocated);
+  bool OverlapsLoopCarriedBuffers(const OrtValue& value) const;
+
+  // get the slice of the Loop output 'output_index' for the current iteration when the trip count is fixed.
+  // the Loop output is allocated by the first call.
+  Status GetScanOutputSlice(int output_index, const TensorShape& per_iteration_shape, OrtValue& slice);
+  // copy the scan outputs that the subgraph did not write in place to the Loop outputs
+  Status CopyScanOutputs(const std::vector<OrtValue>& fetches);
+
+  Status CopyTensor(const Tensor& src, Tensor& dst) const;
+
+  int64_t CurrentIteration() const { return *iter_num_mlvalue_.Get<Tensor>().Data<int64_t>(); }
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const Loop::Info& info_;
@@ -232,6 +264,15 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // the number of iterations is max_trip_count_, so the scan outputs are written directly to the Loop outputs
+  // in scan_outputs_ instead of being concatenated from loop_output_tensors_ at the end.
+  bool fixed_trip_count_ = false;
+  std::vector<OrtValue*> scan_outputs_;
+
+  // two buffers per loop carried variable. the subgraph writes the variable to the buffer which is not read by
+  // the current iteration, so the output of an iteration is fed to the next one without a new allocation.
+  std::vector<std::array<OrtValue, 2>> loop_carried_buffers_;
+
   const Loop::ConcatOutput& concat_output_func_;
 };
 
@@ -434,6 +475,10 @@ Status LoopImpl::Initialize() {
 
   loop_output_tensors_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
 
+  fixed_trip_count_ = info_.has_fixed_trip_count && max_trip_count_tensor && condition_ && max_trip_count_ > 0;
+  scan_outputs_.resize(loop_output_tensors_.size(), nullptr);
+  loop_carried_buffers_.resize(info_.num_loop_carried_vars);
+
   return status;
 }
 
@@ -455,8 +500,8 @@ void LoopImpl::CreateInitialFeeds(std::vector<OrtValue>& feeds) {
   }
 }
 
-void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
-                                         std::vector<OrtValue>& next_inputs) {
+Status LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs,
+                                           std::vector<OrtValue>& next_inputs) {
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
@@ -465,13 +510,207 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
     next_inputs[i] = last_outputs[i - 1];
   }
 
+  // the scan outputs were already written to the Loop outputs by CopyScanOutputs
+  if (fixed_trip_count_) {
+    return Status::OK();
+  }
+
   // save loop outputs as we have to concatenate at the end
   for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
-    ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
-    loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
+    const OrtValue& output = last_outputs[j + 1];  // skip 'cond' in output
+    ORT_ENFORCE(output.IsTensor(), "All scan outputs MUST be tensors");
+
+    if (OverlapsLoopCarriedBuffers(output)) {
+      // the subgraph returned a loop carried variable as a scan output without copying it. the buffer is
+      // overwritten by a later iteration so save a copy.
+      const auto& tensor = output.Get<Tensor>();
+      AllocatorPtr alloc;
+      ORT_RETURN_IF_ERROR(context_.GetTempSpaceAllocator(&alloc));
+      OrtValue copy;
+      Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), std::move(alloc), copy);
+      ORT_RETURN_IF_ERROR(CopyTensor(tensor, *copy.GetMutable<Tensor>()));
+      loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(std::move(copy));
+    } else {
+      loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(output);
+    }
+  }
+
+  return Status::OK();
+}
+
+static bool Overlaps(const OrtValue& value, const Tensor& buffer) {
+  if (!value.IsAllocated() || !value.IsTensor()) {
+    return false;
+  }
+
+  const auto* data = static_cast<const uint8_t*>(value.Get<Tensor>().DataRaw());
+  const auto* begin = static_cast<const uint8_t*>(buffer.DataRaw());
+  return data >= begin && data < begin + buffer.SizeInBytes();
+}
+
+bool LoopImpl::OverlapsLoopCarriedBuffers(const OrtValue& value) const {
+  for (const auto& buffers : loop_carried_buffers_) {
+    for (const auto& buffer : buffers) {
+      if (buffer.IsAllocated() && Overlaps(value, buffer.Get<Tensor>())) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void LoopImpl::CreateFetchAllocators(const std::vector<OrtValue>& feeds,
+                                     std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  const auto& subgraph_outputs = info_.subgraph.GetOutputs();
+
+  // fetch 0 is 'cond', the loop carried variables follow it. custom allocators are only used for tensors.
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    const auto* type = subgraph_outputs[static_cast<size_t>(i) + 1]->TypeAsProto();
+    if (type != nullptr && type->has_tensor_type()) {
+      fetch_allocators[static_cast<size_t>(i) + 1] = [this, i, &feeds](const TensorShape& shape,
+                                                                       const OrtDevice& location,
+                                                                       OrtValue& ort_value, bool& allocated) {
+        return AllocateLoopCarriedVar(i, shape, location, feeds, ort_value, allocated);
+      };
+    }
+  }
+
+  if (!fixed_trip_count_) {
+    return;
+  }
+
+  for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    fetch_allocators[static_cast<size_t>(i) + 1] = [this, i](const TensorShape& shape, const OrtDevice& location,
+                                                             OrtValue& ort_value, bool& allocated) {
+      OrtValue slice;
+      ORT_RETURN_IF_ERROR(GetScanOutputSlice(i, shape, slice));
+
+      // if the Loop output is on another device, CopyScanOutputs copies the value from the subgraph
+      if (slice.Get<Tensor>().Location().device == location) {
+        ort_value = std::move(slice);
+        allocated = true;
+      }
+
+      return Status::OK();
+    };
   }
 }
 
+Status LoopImpl::AllocateLoopCarriedVar(int index, const TensorShape& shape, const OrtDevice& location,
+                                        const std::vector<OrtValue>& feeds, OrtValue& ort_value,
+                                        bool& allocated) {
+  // the previous value of the variable provides the element type. +2 to skip iter_num and cond
+  const OrtValue& previous_value = feeds[static_cast<size_t>(index) + 2];
+  if (location.Type() != OrtDevice::CPU || !previous_value.IsAllocated() || !previous_value.IsTensor()) {
+    return Status::OK();
+  }
+
+  const auto* element_type = previous_value.Get<Tensor>().DataType();
+
+  // the last iteration of a fixed trip count writes the variable directly to the Loop output
+  if (fixed_trip_count_ && CurrentIteration() + 1 == max_trip_count_) {
+    Tensor* output = context_.Output(index, shape);
+    ORT_RETURN_IF(output == nullptr, "Failed to create output tensor for output #", index);
+    if (output->Location().device == location && output->DataType() == element_type) {
+      ort_value = *context_.GetOutputMLValue(index);
+      allocated = true;
+    }
+
+    return Status::OK();
+  }
+
+  for (auto& buffer : loop_carried_buffers_[index]) {
+    // skip the buffer if it is read by the current iteration, directly or through an alias of a feed
+    if (buffer.IsAllocated() &&
+        std::any_of(feeds.cbegin(), feeds.cend(),
+                    [&buffer](const OrtValue& feed) { return Overlaps(feed, buffer.Get<Tensor>()); })) {
+      continue;
+    }
+
+    if (!buffer.IsAllocated() || buffer.Get<Tensor>().Shape() != shape ||
+        buffer.Get<Tensor>().DataType() != element_type) {
+      AllocatorPtr alloc = session_state_.GetAllocator(location);
+      if (!alloc) {
+        return Status::OK();
+      }
+
+      Tensor::InitOrtValue(element_type, shape, std::move(alloc), buffer);
+    }
+
+    ort_value = buffer;
+    allocated = true;
+    break;
+  }
+
+  return Status::OK();
+}
+
+Status LoopImpl::GetScanOutputSlice(int output_index, const TensorShape& per_iteration_shape, OrtValue& slice) {
+  OrtValue*& output_value = scan_outputs_[static_cast<size_t>(output_index) - info_.num_loop_carried_vars];
+  if (output_value == nullptr) {
+    // first dimension is number of iterations
+    TensorShapeVector dims;
+    dims.reserve(per_iteration_shape.NumDimensions() + 1);
+    dims.push_back(max_trip_count_);
+    const auto per_iteration_dims = per_iteration_shape.GetDims();
+    dims.insert(dims.end(), per_iteration_dims.begin(), per_iteration_dims.end());
+
+    ORT_RETURN_IF(context_.Output(output_index, TensorShape(dims)) == nullptr,
+                  "Failed to create output tensor for output #", output_index);
+    output_value = context_.GetOutputMLValue(output_index);
+  }
+
+  auto& output = *output_value->GetMutable<Tensor>();
+  const auto expected_shape = output.Shape().Slice(1);
+  if (expected_shape != per_iteration_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output. ",
+                           " Expected:", expected_shape, " Got:", per_iteration_shape);
+  }
+
+  const size_t bytes_per_iteration = SafeInt<size_t>(per_iteration_shape.Size()) * output.DataType()->Size();
+  auto* data = static_cast<uint8_t*>(output.MutableDataRaw()) +
+               SafeInt<size_t>(CurrentIteration()) * bytes_per_iteration;
+  Tensor::InitOrtValue(output.DataType(), per_iteration_shape, data, output.Location(), slice);
+
+  return Status::OK();
+}
+
+Status LoopImpl::CopyScanOutputs(const std::vector<OrtValue>& fetches) {
+  for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    const auto& value = fetches[static_cast<size_t>(i) + 1];  // skip cond
+    ORT_RETURN_IF_NOT(value.IsTensor(), "All scan outputs MUST be tensors");
+
+    // values the subgraph did not allocate with the custom allocator, e.g. an implicit input or a value on
+    // another device, need a copy
+    const auto& tensor = value.Get<Tensor>();
+    OrtValue slice;
+    ORT_RETURN_IF_ERROR(GetScanOutputSlice(i, tensor.Shape(), slice));
+    auto& slice_tensor = *slice.GetMutable<Tensor>();
+    if (slice_tensor.DataRaw() != tensor.DataRaw()) {
+      ORT_RETURN_IF_ERROR(CopyTensor(tensor, slice_tensor));
+    }
+  }
+
+  return Status::OK();
+}
+
+Status LoopImpl::CopyTensor(const Tensor& src, Tensor& dst) const {
+  // Safely use the IDataTransfer abstraction as we only allow using
+  // Loop on CUDA if the copy stream is the same as the compute stream.
+  // So there is no explicit sync required between the compute and copy streams
+  // to avoid data races.
+  const auto* data_transfer = session_state_.GetDataTransferMgr().GetDataTransfer(src.Location().device,
+                                                                                  dst.Location().device);
+  ORT_RETURN_IF(data_transfer == nullptr, "No data transfer registered to copy from ",
+                src.Location().device.ToString(), " to ", dst.Location().device.ToString());
+  if (context_.GetComputeStream()) {
+    return data_transfer->CopyTensorAsync(src, dst, *context_.GetComputeStream());
+  }
+
+  return data_transfer->CopyTensor(src, dst);
+}
+
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
   const auto& first_output = per_iteration_output.front().Get<Tensor>();
   const auto& per_iteration_dims = first_output.Shape().GetDims();
@@ -497,18 +736,20 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   std::vector<OrtValue> feeds;
   std::vector<OrtValue> fetches;
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
   CreateInitialFeeds(feeds);
+  CreateFetchAllocators(feeds, fetch_allocators);
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
-      SaveOutputsAndUpdateFeeds(fetches, feeds);
+      ORT_RETURN_IF_ERROR(SaveOutputsAndUpdateFeeds(fetches, feeds));
       fetches.clear();
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
                                     context_.GetComputeStream(),
                                     // because the fetch[0] is the loop condition which we need to access on CPU,
@@ -516,13 +757,21 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
                                     true);
     ORT_RETURN_IF_ERROR(status);
 
+    if (fixed_trip_count_) {
+      ORT_RETURN_IF_ERROR(CopyScanOutputs(fetches));
+    }
+
     condition_mlvalue_ = fetches[0];
 
     ++iter_num_value;
   }
 
+  // the scan outputs have max_trip_count_ slices
+  ORT_RETURN_IF(fixed_trip_count_ && iter_num_value != max_trip_count_,
+                "Loop with a fixed trip count of ", max_trip_count_, " stopped after ", iter_num_value, " iterations");
+
   // As the loop carried variables may change shape across iterations there's no way to avoid a copy
-  // as we need the final shape.
+  // as we need the final shape, unless the last iteration of a fixed trip count wrote them to the outputs.
   auto copy_mlvalue_to_output = [this](OrtValue& input, int output_idx,
                                        int64_t iter_num_value, const TypeProto& tp) {
 #if !defined(DISABLE_OPTIONAL_TYPE)
@@ -542,15 +791,10 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 #endif
       const auto& input_tensor = input.Get<Tensor>();
       Tensor* output = context_.Output(output_idx, input_tensor.Shape());
-      // Safely use the IDataTransfer abstraction as we only allow using
-      // Loop on CUDA if the copy stream is the same as the compute stream.
-      // So there is no explicit sync required between the compute and copy streams
-      // to avoid data races.
-      auto* data_transer = session_state_.GetDataTransferMgr().GetDataTransfer(input_tensor.Location().device, output->Location().device);
-      if (context_.GetComputeStream())
-        ORT_RETURN_IF_ERROR(data_transer->CopyTensorAsync(input_tensor, *output, *context_.GetComputeStream()));
-      else
-        ORT_RETURN_IF_ERROR(data_transer->CopyTensor(input_tensor, *output));
+      // the last iteration may have written the value directly to the output
+      if (output->DataRaw() != input_tensor.DataRaw()) {
+        ORT_RETURN_IF_ERROR(CopyTensor(input_tensor, *output));
+      }
     } else if (input.IsTensorSequence()) {
       TensorSeq* output = context_.Output<TensorSeq>(output_idx);
 
@@ -568,15 +812,7 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
         ORT_RETURN_IF_ERROR(context_.GetTempSpaceAllocator(&alloc));
         for (auto it = data.begin(), end = data.end(); it != end; ++it) {
           Tensor tmp(it->Get<Tensor>().DataType(), it->Get<Tensor>().Shape(), alloc);
-          // Safely use the IDataTransfer abstraction as we only allow using
-          // Loop on CUDA if the copy stream is the same as the compute stream.
-          // So there is no explicit sync required between the compute and copy streams
-          // to avoid data races.
-          auto* data_transer = session_state_.GetDataTransferMgr().GetDataTransfer(it->Get<Tensor>().Location().device, tmp.Location().device);
-          if (context_.GetComputeStream())
-            ORT_RETURN_IF_ERROR(data_transer->CopyTensorAsync(it->Get<Tensor>(), tmp, *context_.GetComputeStream()));
-          else
-            ORT_RETURN_IF_ERROR(data_transer->CopyTensor(it->Get<Tensor>(), tmp));
+          ORT_RETURN_IF_ERROR(CopyTensor(it->Get<Tensor>(), tmp));
 
           output->Add(std::move(tmp));
         }
@@ -593,7 +829,7 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
       ORT_RETURN_IF_ERROR(copy_mlvalue_to_output(fetches[static_cast<ptrdiff_t>(i) + 1], i, iter_num_value, *info_.loop_carried_vars_types[static_cast<ptrdiff_t>(i)]));  // skip cond
     }
 
-    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    for (int i = info_.num_loop_carried_vars; !fixed_trip_count_ && i < info_.num_outputs; ++i) {
       // add last output
       auto& per_iteration_outputs = loop_output_tensors_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
       per_iteration_outputs.push_back(fetches[static_cast<ptrdiff_t>(i) + 1]);  // skip cond
@@ -38,6 +38,10 @@ class Loop : public controlflow::IControlFlowKernel {
     std::vector<std::string> subgraph_output_names;
 
     std::vector<const ONNX_NAMESPACE::TypeProto*> loop_carried_vars_types;
+
+    // true if the Loop node runs on CPU and the subgraph returns its 'cond' input unchanged, so a Loop with
+    // an 'M' input runs exactly 'M' iterations and the scan outputs can be written in place.
+    bool has_fixed_trip_count;
   };
 
   // function to concatenate the OrtValue instances from each Loop iteration into a single output buffer.
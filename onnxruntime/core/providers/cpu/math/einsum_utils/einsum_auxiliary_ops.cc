@@ -3,6 +3,9 @@
 
 #include "einsum_auxiliary_ops.h"
 
+#include "core/mlas/inc/mlas.h"
+#include "core/util/math_cpuonly.h"
+
 using namespace onnxruntime::common;
 
 namespace onnxruntime {
@@ -32,16 +35,53 @@ Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
-              void* /*einsum_cuda_assets*/) {
-  for (size_t i = 0; i < num_batches; ++i) {
-    math::MatMul<T>(
-        static_cast<int>(M),
-        static_cast<int>(N),
-        static_cast<int>(K),
-        input_1_data + i * left_stride,
-        input_2_data + i * right_stride,
-        output_data + i * output_stride, tp);
+              size_t num_batches, size_t M, size_t K, size_t N, bool trans_1, bool trans_2,
+              concurrency::ThreadPool* tp, void* /*einsum_cuda_assets*/) {
+  if constexpr (std::is_same<T, float>::value
+#ifdef MLAS_SUPPORTS_GEMM_DOUBLE
+                || std::is_same<T, double>::value
+#endif
+  ) {
+    // Let MLAS partition all the batches over the thread pool at once
+    using GemmDataParams = typename std::conditional<std::is_same<T, float>::value,
+                                                     MLAS_SGEMM_DATA_PARAMS, MLAS_DGEMM_DATA_PARAMS>::type;
+    std::vector<GemmDataParams> data(num_batches);
+    for (size_t i = 0; i < num_batches; ++i) {
+      data[i].A = input_1_data + i * left_stride;
+      data[i].lda = trans_1 ? M : K;
+      data[i].B = input_2_data + i * right_stride;
+      data[i].ldb = trans_2 ? K : N;
+      data[i].C = output_data + i * output_stride;
+      data[i].ldc = N;
+    }
+
+    MlasGemmBatch(trans_1 ? CblasTrans : CblasNoTrans, trans_2 ? CblasTrans : CblasNoTrans,
+                  M, N, K, data.data(), num_batches, tp);
+  } else {
+    for (size_t i = 0; i < num_batches; ++i) {
+      const T* input_1 = input_1_data + i * left_stride;
+      const T* input_2 = input_2_data + i * right_stride;
+      T* output = output_data + i * output_stride;
+
+      if (!trans_1 && !trans_2) {
+        math::MatMul<T>(static_cast<ptrdiff_t>(M), static_cast<ptrdiff_t>(N), static_cast<ptrdiff_t>(K),
+                        input_1, input_2, output, tp);
+        continue;
+      }
+
+      // The row major output is the column major [N, M] matrix input_2^T * input_1^T
+      auto output_mat = EigenMatrixMap<T>(output, N, M);
+      if (trans_1 && trans_2) {
+        output_mat.noalias() = ConstEigenMatrixMap<T>(input_2, K, N).transpose() *
+                               ConstEigenMatrixMap<T>(input_1, M, K).transpose();
+      } else if (trans_1) {
+        output_mat.noalias() = ConstEigenMatrixMap<T>(input_2, N, K) *
+                               ConstEigenMatrixMap<T>(input_1, M, K).transpose();
+      } else {
+        output_mat.noalias() = ConstEigenMatrixMap<T>(input_2, K, N).transpose() *
+                               ConstEigenMatrixMap<T>(input_1, K, M);
+      }
+    }
   }
 
   return Status::OK();
@@ -304,7 +344,8 @@ template <typename T>
 std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
                                const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
                                AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-                               const DeviceHelpers::MatMul<T>& device_matmul_func) {
+                               const DeviceHelpers::MatMul<T>& device_matmul_func,
+                               bool trans_1, bool trans_2) {
   // Sanity checks before the actual MatMul
   ORT_ENFORCE(input_1.DataType() == input_2.DataType(), "Data types of the inputs must match for MatMul");
   ORT_ENFORCE(input_shape_1_override.size() == 3 && input_shape_2_override.size() == 3, "Only 1 batch dimension is allowed for MatMul");
@@ -335,7 +376,8 @@ std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const gsl::span<const int6
   T* output_data = output->MutableData<T>();
 
   auto status = device_matmul_func(input_1_data, input_2_data, output_data,
-                                   left_offset, right_offset, output_offset, batches, M, K, N, tp, einsum_cuda_assets);
+                                   left_offset, right_offset, output_offset, batches, M, K, N, trans_1, trans_2,
+                                   tp, einsum_cuda_assets);
 
   if (!status.IsOK()) {
     ORT_THROW(ONNXRUNTIME, FAIL, "Einsum op: Exception during MatMul operation: ",
@@ -359,14 +401,15 @@ std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const TensorShape& input_
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
-    void* einsum_cuda_assets);
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_1, bool trans_2,
+    concurrency::ThreadPool* tp, void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<float>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<float>& device_matmul_func);
+    const DeviceHelpers::MatMul<float>& device_matmul_func,
+    bool trans_1, bool trans_2);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<float>(
     const Tensor& input, gsl::span<const int64_t> reduce_axes,
@@ -383,14 +426,15 @@ template std::unique_ptr<Tensor> ReduceSum<float>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int32_t>(
     const int32_t* input_1_data, const int32_t* input_2_data, int32_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
-    void* einsum_cuda_assets);
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_1, bool trans_2,
+    concurrency::ThreadPool* tp, void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<int32_t>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<int32_t>& device_matmul_func);
+    const DeviceHelpers::MatMul<int32_t>& device_matmul_func,
+    bool trans_1, bool trans_2);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<int32_t>(
     const Tensor& input, gsl::span<const int64_t> reduce_axes,
@@ -408,14 +452,15 @@ template std::unique_ptr<Tensor> ReduceSum<int32_t>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<double>(
     const double* input_1_data, const double* input_2_data, double* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
-    void* einsum_cuda_assets);
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_1, bool trans_2,
+    concurrency::ThreadPool* tp, void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<double>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<double>& device_matmul_func);
+    const DeviceHelpers::MatMul<double>& device_matmul_func,
+    bool trans_1, bool trans_2);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<double>(
     const Tensor& input, gsl::span<const int64_t> reduce_axes,
@@ -433,8 +478,8 @@ template std::unique_ptr<Tensor> ReduceSum<double>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int64_t>(
     const int64_t* input_1_data, const int64_t* input_2_data, int64_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
-    void* einsum_cuda_assets);
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_1, bool trans_2,
+    concurrency::ThreadPool* tp, void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<int64_t>(
     const Tensor& input, gsl::span<const int64_t> reduce_axes,
@@ -446,7 +491,8 @@ template std::unique_ptr<Tensor> MatMul<int64_t>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<int64_t>& device_matmul_func);
+    const DeviceHelpers::MatMul<int64_t>& device_matmul_func,
+    bool trans_1, bool trans_2);
 
 template std::unique_ptr<Tensor> ReduceSum<int64_t>(
     const Tensor& input, const TensorShape& input_shape_override,
@@ -458,7 +504,8 @@ template std::unique_ptr<Tensor> MatMul<MLFloat16>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
-    const DeviceHelpers::MatMul<MLFloat16>& device_matmul_func);
+    const DeviceHelpers::MatMul<MLFloat16>& device_matmul_func,
+    bool trans_1, bool trans_2);
 
 template std::unique_ptr<Tensor> ReduceSum<MLFloat16>(
     const Tensor& input, const TensorShape& input_shape_override,
@@ -48,6 +48,10 @@ const std::vector<TensorShape>& EinsumComputePreprocessor::GetHomogenizedInputDi
   return homogenized_input_dims_;
 }
 
+const std::vector<std::vector<size_t>>& EinsumComputePreprocessor::GetInputAxesOrders() const {
+  return input_axes_orders_;
+}
+
 const std::vector<int64_t>& EinsumComputePreprocessor::GetMappedSubscriptIndicesToLastInputIndex() const {
   return subscript_indices_to_last_input_;
 }
@@ -404,6 +408,7 @@ Status EinsumComputePreprocessor::CalculateOutputShape() {
 Status EinsumComputePreprocessor::PreprocessInputs() {
   preprocessed_inputs_.reserve(inputs_.size());
   homogenized_input_dims_.reserve(inputs_.size());
+  input_axes_orders_.reserve(inputs_.size());
   // As part of input preprocessing we "homogenize" them by
   // 1) Making them all of the same rank
   // 2) The axes order in all the inputs are to be made the same
@@ -453,11 +458,23 @@ Status EinsumComputePreprocessor::PreprocessInputs() {
       }
     }
 
+    std::vector<size_t> axes_order;
+
     // (Identify no-op transpose and prevent triggering the transpose)
-    if (EinsumOp::IsTransposeRequired(preprocessed ? preprocessed->Shape().GetDims().size() : inputs_[onnxruntime::narrow<size_t>(input_iter)]->Shape().GetDims().size(),
-                                      permutation)) {
-      preprocessed = EinsumOp::Transpose(preprocessed ? *preprocessed : *inputs_[onnxruntime::narrow<size_t>(input_iter)],
-                                         preprocessed ? preprocessed->Shape().GetDims() : inputs_[onnxruntime::narrow<size_t>(input_iter)]->Shape().GetDims(),
+    if (!preprocessed && EinsumOp::IsTransposeRequired(input_dims.size(), permutation)) {
+      // Don't transpose the raw input but record the order of its axes instead. Depending on the order the
+      // inputs are contracted in, the transpose may be avoided altogether (e.g.) by a transposed MatMul.
+      axes_order.reserve(onnxruntime::narrow<size_t>(num_subscript_indices_));
+      for (const auto& subscript_index : current_subscript_indices) {
+        axes_order.push_back(onnxruntime::narrow<size_t>(subscript_index));
+      }
+      for (size_t i = 0; i < subscript_indices_to_input_index.size(); ++i) {
+        if (subscript_indices_to_input_index[i] == -1) {
+          axes_order.push_back(i);
+        }
+      }
+    } else if (preprocessed && EinsumOp::IsTransposeRequired(preprocessed->Shape().GetDims().size(), permutation)) {
+      preprocessed = EinsumOp::Transpose(*preprocessed, preprocessed->Shape().GetDims(),
                                          permutation, allocator_, einsum_ep_assets_, device_transpose_func_);
     }
 
@@ -469,6 +486,7 @@ Status EinsumComputePreprocessor::PreprocessInputs() {
     }
     preprocessed_inputs_.push_back(std::move(preprocessed));
     homogenized_input_dims_.emplace_back(homogenized_input_dims);
+    input_axes_orders_.push_back(std::move(axes_order));
 
     ++input_iter;
   }
@@ -121,7 +121,8 @@ class EinsumComputePreprocessor final {
 
   // Pre-process inputs if needed - preprocessing includes -
   // 1) Parsing diagonals from raw inputs
-  // 2) Transposing some axes to match a chosen fixed ordering
+  // 2) Transposing some axes to match a chosen fixed ordering (only for inputs with diagonals,
+  //    the other inputs are transposed as late as possible, see GetInputAxesOrders())
   // This must be used in conjunction with its corresponding entry in homogenized_input_dims_
   // (returned by GetHomogenizedInputDims()).
   // If a particular entry is null, use raw inputs in conjunction with homogenized_input_dims_.
@@ -133,6 +134,11 @@ class EinsumComputePreprocessor final {
   // Get the "homogenized input dims" for each preprocessed/raw input
   const std::vector<TensorShape>& GetHomogenizedInputDims();
 
+  // For each input, the subscript indices in the order its raw data holds them (padded with the subscript indices
+  // the input doesn't have) if the transpose to the homogenized axes order was left to the consumer of the input.
+  // Empty if the preprocessed/raw input already follows the homogenized axes order.
+  const std::vector<std::vector<size_t>>& GetInputAxesOrders() const;
+
   // For each subscript index, hold the last input the subscript index was seen in
   const std::vector<int64_t>& GetMappedSubscriptIndicesToLastInputIndex() const;
 
@@ -180,6 +186,9 @@ class EinsumComputePreprocessor final {
   // Holds the preprocessed inputs' homogenized dims
   std::vector<TensorShape> homogenized_input_dims_;
 
+  // Holds the order of the subscript indices in the data of the raw inputs that were not transposed
+  std::vector<std::vector<size_t>> input_axes_orders_;
+
   // Count of unique subscript labels (subscript indices)
   // E.g. 1 : With equation -> 'ij, jk -> ik'
   // num_subscript_indices_ = 3 (i, j, k)
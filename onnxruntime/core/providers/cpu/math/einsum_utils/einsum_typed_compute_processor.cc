@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "einsum_typed_compute_processor.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
 
@@ -92,11 +97,55 @@ static bool IsTransposeReshapeForEinsum(const gsl::span<const size_t>& perm,
   return true;
 }
 
+// Returns the dims of a tensor whose data holds the axes in `axes_order` given its dims in the homogenized axes order
+static TensorShapeVector GetDimsInAxesOrder(gsl::span<const int64_t> homogenized_dims,
+                                            gsl::span<const size_t> axes_order) {
+  if (axes_order.empty()) {
+    return TensorShapeVector(homogenized_dims.begin(), homogenized_dims.end());
+  }
+
+  TensorShapeVector dims;
+  dims.reserve(axes_order.size());
+  for (size_t axis : axes_order) {
+    dims.push_back(homogenized_dims[axis]);
+  }
+  return dims;
+}
+
+// Turns a permutation of the homogenized axes into the permutation to apply to
+// a tensor whose data holds the axes in `axes_order`
+static void MapToAxesOrder(InlinedVector<size_t>& permutation, gsl::span<const size_t> axes_order) {
+  if (axes_order.empty()) {
+    return;
+  }
+
+  InlinedVector<size_t> position_of_axis(axes_order.size());
+  for (size_t i = 0; i < axes_order.size(); ++i) {
+    position_of_axis[axes_order[i]] = i;
+  }
+  for (auto& axis : permutation) {
+    axis = position_of_axis[axis];
+  }
+}
+
+// Appends the axes of each of the groups to `axes`
+template <typename... Groups>
+static void AppendAxes(InlinedVector<size_t>& axes, const Groups&... groups) {
+  auto append = [&axes](const auto& group) {
+    for (auto axis : group) {
+      axes.push_back(onnxruntime::narrow<size_t>(axis));
+    }
+  };
+  (append(groups), ...);
+}
+
 template <typename T>
 std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(const Tensor& left,
                                                                                const TensorShape& left_shape_override,
+                                                                               gsl::span<const size_t> left_axes_order,
                                                                                const Tensor& right,
                                                                                const TensorShape& right_shape_override,
+                                                                               gsl::span<const size_t> right_axes_order,
                                                                                const gsl::span<const int64_t>& reduce_dims,
                                                                                bool is_final_pair) {
   // Use the provided dim overrides instead of the actual shapes of the operands
@@ -160,12 +209,20 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
                     "Einsum op: Input dimensions must be equal along an axis to be reduced across all inputs");
         reduced_size *= left_dim;
       } else if (has_left_dim) {  // if the dim to be reduced is only in one of left and right, we can reduce right away
+        if (!left_axes_order.empty()) {
+          current_left = TransposeToHomogenizedOrder(left, left_shape_override, left_axes_order);
+          left_axes_order = {};
+        }
         const Tensor& tensor_to_be_reduced = current_left ? *current_left : left;
         auto tensor_to_be_reduced_dims = current_left ? current_left->Shape().GetDims() : left_dims;
 
         current_left = EinsumOp::ReduceSum<T>(
             tensor_to_be_reduced, tensor_to_be_reduced_dims, AsSpan({i}), allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
       } else if (has_right_dim) {
+        if (!right_axes_order.empty()) {
+          current_right = TransposeToHomogenizedOrder(right, right_shape_override, right_axes_order);
+          right_axes_order = {};
+        }
         const Tensor& tensor_to_be_reduced = current_right ? *current_right : right;
         auto tensor_to_be_reduced_dims = current_right ? current_right->Shape().GetDims() : right_dims;
 
@@ -194,62 +251,109 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   }
 
   // Permutate the left operand so that the axes order go like this: [lro, lo, reduce_dims, ro]
+  // unless its data is already laid out as [lro, reduce_dims, lo, ro] (ignoring dims with value 1),
+  // in which case it is fed to the MatMul as is and flagged as transposed.
   TensorShapeVector reshaped_dims;
   InlinedVector<size_t> left_permutation;
   left_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  left_permutation.insert(left_permutation.end(), lro.begin(), lro.end());
-  left_permutation.insert(left_permutation.end(), lo.begin(), lo.end());
-  //  left_permutation.insert(left_permutation.end(), reduce_dims.begin(), reduce_dims.end());
-  for (auto& a : reduce_dims) {
-    left_permutation.push_back(onnxruntime::narrow<size_t>(a));
-  }
-  left_permutation.insert(left_permutation.end(), ro.begin(), ro.end());
-  if (EinsumOp::IsTransposeRequired(current_left ? current_left->Shape().NumDimensions() : left_dims.size(),
-                                    left_permutation)) {
-    if (current_left && IsTransposeReshapeForEinsum(left_permutation,
-                                                    current_left->Shape().GetDims(),
-                                                    reshaped_dims)) {
+  AppendAxes(left_permutation, lro, lo, reduce_dims, ro);
+  bool trans_left = false;
+  const TensorShapeVector current_left_dims = current_left ? current_left->Shape().AsShapeVector()
+                                                           : GetDimsInAxesOrder(left_dims, left_axes_order);
+  MapToAxesOrder(left_permutation, left_axes_order);
+  if (EinsumOp::IsTransposeRequired(current_left_dims.size(), left_permutation)) {
+    InlinedVector<size_t> transposed_left_permutation;
+    transposed_left_permutation.reserve(left_permutation.size());
+    AppendAxes(transposed_left_permutation, lro, reduce_dims, lo, ro);
+    MapToAxesOrder(transposed_left_permutation, left_axes_order);
+
+    if (IsTransposeReshapeForEinsum(left_permutation, current_left_dims, reshaped_dims)) {
       // This can be done because current_* tensors (if they exist) and output tensors are
       // intermediate tensors and cannot be input tensors to the Einsum node itself
-      // (which are immutable).
+      // (which are immutable). The inputs of the node need no reshape as the MatMul only
+      // relies on the shape overrides.
       // Covered by ExplicitEinsumAsTensorContractionReshapeLeft.
-      current_left->Reshape(reshaped_dims);
+      if (current_left) {
+        current_left->Reshape(reshaped_dims);
+      }
+    } else if (IsTransposeReshapeForEinsum(transposed_left_permutation, current_left_dims, reshaped_dims)) {
+      // Covered by ExplicitEinsumAsMatmulWithTransposedLeft, ...
+      trans_left = true;
     } else {
       // Covered by ExplicitEinsumAsTensorContraction, DiagonalWithMatmul, ...
-      current_left = EinsumOp::Transpose(current_left ? *current_left : left,
-                                         current_left ? current_left->Shape().GetDims() : left_dims,
+      current_left = EinsumOp::Transpose(current_left ? *current_left : left, TensorShape(current_left_dims),
                                          left_permutation, allocator_, einsum_ep_assets_,
                                          device_transpose_func_);
     }
   }
 
   // Permutate the right operand so that the axes order go like this: [lro, reduce_dims, ro, lo]
+  // unless its data is already laid out as [lro, ro, reduce_dims, lo] (see above).
   InlinedVector<size_t> right_permutation;
   right_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  right_permutation.insert(right_permutation.end(), lro.begin(), lro.end());
-  //  right_permutation.insert(right_permutation.end(), reduce_dims.begin(), reduce_dims.end());
-  for (auto& a : reduce_dims) {
-    right_permutation.push_back(onnxruntime::narrow<size_t>(a));
-  }
-  right_permutation.insert(right_permutation.end(), ro.begin(), ro.end());
-  right_permutation.insert(right_permutation.end(), lo.begin(), lo.end());
-  if (EinsumOp::IsTransposeRequired(current_right ? current_right->Shape().GetDims().size() : right_dims.size(),
-                                    right_permutation)) {
-    if (current_right && IsTransposeReshapeForEinsum(right_permutation,
-                                                     current_right->Shape().GetDims(),
-                                                     reshaped_dims)) {
+  AppendAxes(right_permutation, lro, reduce_dims, ro, lo);
+  bool trans_right = false;
+  const TensorShapeVector current_right_dims = current_right ? current_right->Shape().AsShapeVector()
+                                                             : GetDimsInAxesOrder(right_dims, right_axes_order);
+  MapToAxesOrder(right_permutation, right_axes_order);
+  if (EinsumOp::IsTransposeRequired(current_right_dims.size(), right_permutation)) {
+    InlinedVector<size_t> transposed_right_permutation;
+    transposed_right_permutation.reserve(right_permutation.size());
+    AppendAxes(transposed_right_permutation, lro, ro, reduce_dims, lo);
+    MapToAxesOrder(transposed_right_permutation, right_axes_order);
+
+    if (IsTransposeReshapeForEinsum(right_permutation, current_right_dims, reshaped_dims)) {
       // See note following the previous call of function IsTransposeReshapeForEinsum.
       // Covered by ExplicitEinsumAsBatchedMatmulWithBroadcasting_1, ExplicitEinsumAsMatmul_2, ...
-      current_right->Reshape(reshaped_dims);
+      if (current_right) {
+        current_right->Reshape(reshaped_dims);
+      }
+    } else if (IsTransposeReshapeForEinsum(transposed_right_permutation, current_right_dims, reshaped_dims)) {
+      // Covered by ExplicitEinsumAsMatmulWithTransposedRight, ...
+      trans_right = true;
     } else {
       // Covered by DiagonalWithMatmul, ExplicitEinsumAsBatchedMatmul, ...
-      current_right = EinsumOp::Transpose(current_right ? *current_right : right,
-                                          current_right ? current_right->Shape().GetDims() : right_dims,
+      current_right = EinsumOp::Transpose(current_right ? *current_right : right, TensorShape(current_right_dims),
                                           right_permutation, allocator_, einsum_ep_assets_,
                                           device_transpose_func_);
     }
   }
 
+  // The MatMul produces [lro, lo, reduce_dims, ro] (the reduce_dims having a dim value of 1).
+  // If the order the result is consumed in (the subscript order for an intermediate result or the op's
+  // output order for the final pair) rather matches [lro, ro, reduce_dims, lo], compute the transposed
+  // product right^T * left^T instead so that no transpose of the result is required.
+  const std::vector<int64_t>& subscript_indices_to_output_indices =
+      einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+  auto is_in_consumer_order = [&](std::initializer_list<gsl::span<const size_t>> groups) {
+    int64_t last_rank = -1;
+    for (const auto& group : groups) {
+      for (size_t axis : group) {
+        int64_t dim = left_dims[axis] > 1 ? left_dims[axis] : right_dims[axis];
+        if (dim == 1) {
+          continue;
+        }
+        int64_t rank = is_final_pair ? subscript_indices_to_output_indices[axis] : static_cast<int64_t>(axis);
+        if (rank < last_rank) {
+          return false;
+        }
+        last_rank = rank;
+      }
+    }
+    return true;
+  };
+
+  const bool swap_operands = !is_in_consumer_order({lro, lo, ro}) && is_in_consumer_order({lro, ro, lo});
+
+  // Order of the axes in the MatMul output
+  InlinedVector<size_t> output_axes;
+  output_axes.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
+  if (swap_operands) {
+    AppendAxes(output_axes, lro, ro, reduce_dims, lo);
+  } else {
+    AppendAxes(output_axes, lro, lo, reduce_dims, ro);
+  }
+
   // Calculate output size
   // Output shape will be determined by rules of MatMul:
   // because we are multiplying two tensors of shapes [lro, lo, reduce_dims] , [lro, reduce_dims, ro]
@@ -257,21 +361,15 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   //  dim_value of `lo` dims,
   // `1` for each of the `reduce_dims`,
   // dim_value of `ro` dims]
+  // (the `lo` and `ro` dims being swapped if the operands are swapped)
   TensorShapeVector output_dims;
-  output_dims.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  for (size_t i = 0; i < lro.size(); ++i) {
-    output_dims.push_back(left_dims[lro[i]]);
-  }
-  for (size_t i = 0; i < lo.size(); ++i) {
-    output_dims.push_back(left_dims[lo[i]]);
-  }
-
-  for (size_t i = 0; i < reduce_dims.size(); ++i) {
-    output_dims.push_back(1);  // reduced dimensions will have a value 1 in it
-  }
-
-  for (size_t i = 0; i < ro.size(); ++i) {
-    output_dims.push_back(right_dims[ro[i]]);
+  output_dims.reserve(output_axes.size());
+  for (size_t axis : output_axes) {
+    if (std::find(reduce_dims.begin(), reduce_dims.end(), static_cast<int64_t>(axis)) != reduce_dims.end()) {
+      output_dims.push_back(1);  // reduced dimensions will have a value 1 in it
+    } else {
+      output_dims.push_back(left_dims[axis] > 1 ? left_dims[axis] : right_dims[axis]);
+    }
   }
 
   TensorShapeVector current_subscript_order;
@@ -279,36 +377,30 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   // Calculate output permutation
   // After the MatMul op, the because the two operands have been permutated,
   // the output is permutated as well with respect to the original ordering of the axes.
-  // The permutated order will be the dims in: [lro, lo, reduced_dims, ro]
+  // The permutated order will be the dims in `output_axes`
   // Hence invert the permutation by a permutation that puts the axes in the same ordering
   InlinedVector<size_t> output_permutation;
   if (!is_final_pair) {  // If this is not the final pair, we need to permutate the result to match the pre-fixed order for the next iteration
-    output_permutation.resize(lro.size() + lo.size() + reduce_dims.size() + ro.size(), 0);
-    size_t iter = 0;
-    for (size_t i = 0; i < lro.size(); ++i) {
-      output_permutation[lro[i]] = iter++;
-    }
-    for (size_t i = 0; i < lo.size(); ++i) {
-      output_permutation[lo[i]] = iter++;
-    }
-    for (size_t i = 0; i < reduce_dims.size(); ++i) {
-      output_permutation[onnxruntime::narrow<size_t>(reduce_dims[i])] = iter++;
-    }
-    for (size_t i = 0; i < ro.size(); ++i) {
-      output_permutation[ro[i]] = iter++;
+    output_permutation.resize(output_axes.size(), 0);
+    for (size_t i = 0; i < output_axes.size(); ++i) {
+      output_permutation[output_axes[i]] = i;
     }
   } else {
-    current_subscript_order.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-    current_subscript_order.insert(current_subscript_order.end(), lro.begin(), lro.end());
-    current_subscript_order.insert(current_subscript_order.end(), lo.begin(), lo.end());
-    current_subscript_order.insert(current_subscript_order.end(), reduce_dims.begin(), reduce_dims.end());
-    current_subscript_order.insert(current_subscript_order.end(), ro.begin(), ro.end());
+    current_subscript_order.assign(output_axes.begin(), output_axes.end());
   }
 
   // Multiply the mutated inputs
-  auto output = EinsumOp::MatMul<T>(current_left ? *current_left : left, TensorShapeVector{lro_size, lo_size, reduced_size},
-                                    current_right ? *current_right : right, TensorShapeVector{lro_size, reduced_size, ro_size},
-                                    allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
+  const Tensor& matmul_left = current_left ? *current_left : left;
+  const Tensor& matmul_right = current_right ? *current_right : right;
+  auto output = swap_operands
+                    ? EinsumOp::MatMul<T>(matmul_right, TensorShapeVector{lro_size, ro_size, reduced_size},
+                                          matmul_left, TensorShapeVector{lro_size, reduced_size, lo_size},
+                                          allocator_, tp_, einsum_ep_assets_, device_matmul_func_,
+                                          !trans_right, !trans_left)
+                    : EinsumOp::MatMul<T>(matmul_left, TensorShapeVector{lro_size, lo_size, reduced_size},
+                                          matmul_right, TensorShapeVector{lro_size, reduced_size, ro_size},
+                                          allocator_, tp_, einsum_ep_assets_, device_matmul_func_,
+                                          trans_left, trans_right);
 
   output->Reshape(output_dims);
 
@@ -332,6 +424,16 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   return output;
 }
 
+template <typename T>
+std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::TransposeToHomogenizedOrder(
+    const Tensor& input, const TensorShape& homogenized_shape, gsl::span<const size_t> axes_order) {
+  InlinedVector<size_t> permutation(axes_order.size());
+  std::iota(permutation.begin(), permutation.end(), size_t{0});
+  MapToAxesOrder(permutation, axes_order);
+  return EinsumOp::Transpose(input, TensorShape(GetDimsInAxesOrder(homogenized_shape.GetDims(), axes_order)),
+                             permutation, allocator_, einsum_ep_assets_, device_transpose_func_);
+}
+
 template <typename T>
 void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelpers::Transpose& device_transpose_func,
                                                       const EinsumOp::DeviceHelpers::MatMul<T>& device_matmul_func,
@@ -343,6 +445,112 @@ void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelp
   device_data_copy_func_ = device_data_copy_func;
 }
 
+// The contraction order is planned for up to this many inputs (the planning is exponential in the number of inputs)
+static constexpr size_t kMaxInputsToPlanContractionOrder = 10;
+
+// Chooses the order in which the inputs are contracted pair-wise, the first input in the order being
+// the initial left operand. This is the optimal left-deep contraction path (in the spirit of opt_einsum's
+// "optimal" strategy restricted to left-deep paths) with regard to the number of multiply-adds of the MatMuls:
+// contracting the current result with an input costs the product of the dim values of all the subscript
+// labels present (with a dim value other than 1) in either of them, and the result only keeps the labels
+// needed by the op's output or by the inputs yet to be contracted.
+// Returns the inputs in their order if it is already optimal or if there are too many inputs or labels to plan for.
+static InlinedVector<size_t> PlanContractionOrder(gsl::span<const TensorShape> homogenized_input_dims,
+                                                  gsl::span<const int64_t> subscript_indices_to_last_input) {
+  const size_t num_inputs = homogenized_input_dims.size();
+  const size_t num_labels = subscript_indices_to_last_input.size();
+
+  InlinedVector<size_t> order(num_inputs);
+  std::iota(order.begin(), order.end(), size_t{0});
+  if (num_inputs < 3 || num_inputs > kMaxInputsToPlanContractionOrder ||
+      num_labels > static_cast<size_t>(std::numeric_limits<uint64_t>::digits)) {
+    return order;
+  }
+
+  // Sets of labels are held as bit masks
+  uint64_t output_labels = 0;
+  InlinedVector<uint64_t> input_labels(num_inputs, 0);
+  InlinedVector<double> label_dims(num_labels, 1.0);
+  for (size_t label = 0; label < num_labels; ++label) {
+    if (subscript_indices_to_last_input[label] == -1) {
+      output_labels |= uint64_t{1} << label;
+    }
+    for (size_t input = 0; input < num_inputs; ++input) {
+      const int64_t dim = homogenized_input_dims[input][label];
+      if (dim > 1) {
+        input_labels[input] |= uint64_t{1} << label;
+        label_dims[label] = static_cast<double>(dim);
+      }
+    }
+  }
+
+  auto cost_of = [&](uint64_t labels) {
+    double cost = 1.0;
+    for (size_t label = 0; labels != 0; ++label, labels >>= 1) {
+      if (labels & 1) {
+        cost *= label_dims[label];
+      }
+    }
+    return cost;
+  };
+
+  // The labels of the result of contracting a subset of the inputs (subsets are bit masks as well)
+  const size_t num_subsets = size_t{1} << num_inputs;
+  const size_t all_inputs = num_subsets - 1;
+  std::vector<uint64_t> subset_labels(num_subsets, 0);
+  for (size_t subset = 1; subset < num_subsets; ++subset) {
+    size_t input = 0;
+    while (((subset >> input) & 1) == 0) {
+      ++input;
+    }
+    subset_labels[subset] = subset_labels[subset & (subset - 1)] | input_labels[input];
+  }
+  auto result_labels = [&](size_t subset) {
+    return subset_labels[subset] & (output_labels | subset_labels[all_inputs ^ subset]);
+  };
+
+  double cost_in_order = 0.0;
+  for (size_t input = 1; input < num_inputs; ++input) {
+    cost_in_order += cost_of(result_labels((size_t{1} << input) - 1) | input_labels[input]);
+  }
+
+  // best_cost[subset] is the cost of the cheapest left-deep path contracting `subset`,
+  // last_input[subset] the input that path contracts last
+  std::vector<double> best_cost(num_subsets, std::numeric_limits<double>::max());
+  std::vector<size_t> last_input(num_subsets, 0);
+  for (size_t input = 0; input < num_inputs; ++input) {
+    best_cost[size_t{1} << input] = 0.0;
+    last_input[size_t{1} << input] = input;
+  }
+  for (size_t subset = 1; subset < num_subsets; ++subset) {
+    if ((subset & (subset - 1)) == 0) {
+      continue;
+    }
+    for (size_t input = 0; input < num_inputs; ++input) {
+      const size_t input_bit = size_t{1} << input;
+      if ((subset & input_bit) == 0) {
+        continue;
+      }
+      const size_t rest = subset ^ input_bit;
+      const double cost = best_cost[rest] + cost_of(result_labels(rest) | input_labels[input]);
+      if (cost < best_cost[subset]) {
+        best_cost[subset] = cost;
+        last_input[subset] = input;
+      }
+    }
+  }
+
+  if (best_cost[all_inputs] < cost_in_order) {
+    size_t subset = all_inputs;
+    for (size_t position = num_inputs; position > 0; --position) {
+      order[position - 1] = last_input[subset];
+      subset ^= size_t{1} << last_input[subset];
+    }
+  }
+
+  return order;
+}
+
 template <typename T>
 Status EinsumTypedComputeProcessor<T>::Run() {
   const auto& mapped_indices_to_last_input_index = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToLastInputIndex();
@@ -353,38 +561,65 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   const auto& homogenized_input_dims = einsum_compute_preprocessor_.GetHomogenizedInputDims();
 
+  const auto& input_axes_orders = einsum_compute_preprocessor_.GetInputAxesOrders();
+
   auto num_subscript_labels = einsum_compute_preprocessor_.GetNumSubscriptIndices();
 
   auto num_inputs = context_->InputCount();
 
+  // Order in which the inputs are processed
+  const InlinedVector<size_t> input_order = PlanContractionOrder(homogenized_input_dims,
+                                                                 mapped_indices_to_last_input_index);
+
+  // For each subscript label, hold the position (in `input_order`) of the input after which it can be reduced
+  // (-1 if it appears in the output). That is the last input it appears in with a dim value other than 1 or
+  // the last input it appears in as per the equation, whichever comes later.
+  std::vector<int64_t> mapped_indices_to_last_position(mapped_indices_to_last_input_index.size(), -1);
+  for (size_t i = 0; i < mapped_indices_to_last_input_index.size(); ++i) {
+    if (mapped_indices_to_last_input_index[i] == -1) {
+      continue;
+    }
+    for (size_t position = 0; position < input_order.size(); ++position) {
+      const size_t input = input_order[position];
+      if (homogenized_input_dims[input][i] > 1 ||
+          static_cast<int64_t>(input) == mapped_indices_to_last_input_index[i]) {
+        mapped_indices_to_last_position[i] = static_cast<int64_t>(position);
+      }
+    }
+  }
+
+  const size_t first_input = input_order[0];
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
 
   {
     TensorShapeVector reduced_dims;
-    TensorShapeVector preserved_dims;                                           // dims which were not reduced
-    TensorShapeVector preserved_shape;                                          // shape pertaining to only the dims that were preserved (not reduced)
-    reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));    // num_subscript_labels is the upper bound. No harm in over-reserving.
-    preserved_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving.
+    reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving.
 
     for (size_t i = 0; i < onnxruntime::narrow<size_t>(num_subscript_labels); ++i) {
-      if (mapped_indices_to_last_input_index[i] == 0) {
+      if (mapped_indices_to_last_position[i] == 0) {
         reduced_dims.push_back(i);
-      } else {
-        preserved_dims.push_back(i);
       }
     }
 
     // Reduce the dims that are last seen in the first input alone
     if (reduced_dims.size() != 0) {
-      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
-                                      homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
+      std::unique_ptr<Tensor> transposed;
+      if (!input_axes_orders[first_input].empty()) {
+        transposed = TransposeToHomogenizedOrder(*raw_inputs[first_input], homogenized_input_dims[first_input],
+                                                 input_axes_orders[first_input]);
+      }
+      result = EinsumOp::ReduceSum<T>(transposed                          ? *transposed
+                                      : preprocessed_inputs[first_input] ? *preprocessed_inputs[first_input]
+                                                                          : *raw_inputs[first_input],
+                                      homogenized_input_dims[first_input].GetDims(), reduced_dims, allocator_, tp_,
                                       einsum_ep_assets_, device_reduce_sum_func_);
     } else {
       // Check if there is a pre-processed version of this input
       // If so assign it to result
-      if (preprocessed_inputs[0]) {
-        result = std::move(preprocessed_inputs[0]);
+      if (preprocessed_inputs[first_input]) {
+        result = std::move(preprocessed_inputs[first_input]);
       }
     }
 
@@ -392,7 +627,16 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     if (num_inputs == 1) {
       // Finalize the output by applying any transpose required to get
       // it to the required output ordering and move it to the op's output
-      FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
+      // (the candidate holds all the subscript labels, the reduced ones having a dim value of 1,
+      // in the homogenized order unless the raw input was left in its own order)
+      TensorShapeVector candidate_subscript_order;
+      if (!result && !input_axes_orders[0].empty()) {
+        candidate_subscript_order.assign(input_axes_orders[0].begin(), input_axes_orders[0].end());
+      } else {
+        candidate_subscript_order.resize(onnxruntime::narrow<size_t>(num_subscript_labels));
+        std::iota(candidate_subscript_order.begin(), candidate_subscript_order.end(), int64_t{0});
+      }
+      FinalizeOutput(result ? *result : *raw_inputs[0], candidate_subscript_order);
 
       return Status::OK();
     }
@@ -402,23 +646,26 @@ Status EinsumTypedComputeProcessor<T>::Run() {
   {
     bool is_final_pair = false;
     // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
+    for (int position = 1; position < num_inputs; ++position) {
+      const size_t input = input_order[position];
       TensorShapeVector reduced_dims;
       reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
       for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[onnxruntime::narrow<size_t>(dim)] == input) {
+        if (mapped_indices_to_last_position[onnxruntime::narrow<size_t>(dim)] == position) {
           // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
           reduced_dims.push_back(dim);
         }
       }
-      if (input == num_inputs - 1) {
+      if (position == num_inputs - 1) {
         is_final_pair = true;
       }
       // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
+      result = PairwiseOperandProcess(result ? *result : *raw_inputs[first_input],
+                                      result ? result->Shape() : homogenized_input_dims[first_input],
+                                      result ? gsl::span<const size_t>() : input_axes_orders[first_input],
                                       preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
                                       homogenized_input_dims[input],
+                                      input_axes_orders[input],
                                       reduced_dims, is_final_pair);
     }
   }
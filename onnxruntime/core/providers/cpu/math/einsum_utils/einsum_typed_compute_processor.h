@@ -41,13 +41,21 @@ class EinsumTypedComputeProcessor {
   // Processes Einsum operands in a pair-wise fashion
   // Employs Transpose, ReduceSum, and MatMul under the hood
   // to achieve MatMul(a, b) and reduces (by summing) along specified axes
+  // The shape overrides are in the homogenized axes order, `left_axes_order` and `right_axes_order` hold
+  // the order of the axes in the data of the operands if it differs (see GetInputAxesOrders())
   std::unique_ptr<Tensor> PairwiseOperandProcess(const Tensor& left,
                                                  const TensorShape& left_shape_override,
+                                                 gsl::span<const size_t> left_axes_order,
                                                  const Tensor& right,
                                                  const TensorShape& right_shape_override,
+                                                 gsl::span<const size_t> right_axes_order,
                                                  const gsl::span<const int64_t>& reduce_dims,
                                                  bool is_final_pair);
 
+  // Transposes an input whose data holds the axes in `axes_order` to the homogenized axes order
+  std::unique_ptr<Tensor> TransposeToHomogenizedOrder(const Tensor& input, const TensorShape& homogenized_shape,
+                                                      gsl::span<const size_t> axes_order);
+
   // Here we take a "candidate output"(candidate output is a tensor that is a permutation and / or a reshape away from the final output),
   // and after a few operations to get it to the required output structure, copy it to the op's output
   // The candidate output might contain dims that may not be part of the op's output (i.e.) the dims will have to be unsqueezed
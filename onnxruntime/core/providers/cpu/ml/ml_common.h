@@ -528,5 +528,24 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
     }
   }
 }
+
+// Writes lookup(input[i]) to output[i] for every element. The kernels mapping their input through a table built
+// from the attributes (CategoryMapper, LabelEncoder) use it to split large batches across the thread pool.
+template <typename TKey, typename TValue, typename Lookup>
+void parallel_lookup(concurrency::ThreadPool* threadpool, gsl::span<const TKey> input, gsl::span<TValue> output,
+                     const Lookup& lookup) {
+  ORT_ENFORCE(input.size() == output.size());
+  // one hash, one or two probes and a copy of the value
+  constexpr double lookup_cost = 40.0;
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(input.size()),
+      TensorOpCost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)), lookup_cost},
+      [&input, &output, &lookup](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (size_t i = static_cast<size_t>(first), end = static_cast<size_t>(last); i < end; ++i) {
+          output[i] = lookup(input[i]);
+        }
+      });
+}
+
 }  // namespace ml
 }  // namespace onnxruntime
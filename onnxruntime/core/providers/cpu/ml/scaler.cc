@@ -85,32 +85,51 @@ common::Status ScalerOp<T>::Compute(OpKernelContext* context) const {
 
   size_t x_size = onnxruntime::narrow<size_t>(x_shape.Size());
   int64_t stride = x_dims.size() == 1 ? x_dims[0] : x_dims[1];
-  auto* ttp = context->GetOperatorThreadPool();
-  auto conditional_batch_call = [ttp, x_size](std::function<void(ptrdiff_t)> f) {
-    if (x_size < kParallelizationThreshold) {  // TODO: tune this, arbitrary threshold
-      for (size_t i = 0; i < x_size; ++i) {
-        f(i);
+  const bool per_feature = static_cast<int64_t>(offset_.size()) == stride &&
+                           static_cast<int64_t>(scale_.size()) == stride;
+  if (!per_feature && !(offset_.size() == 1 && scale_.size() == 1)) {
+    std::ostringstream err_msg;
+    err_msg << "Either both scale and offset can be of feature size (" << stride << ") or 1";
+    return Status(ONNXRUNTIME, INVALID_ARGUMENT, err_msg.str());
+  }
+
+  if (x_size == 0) {
+    return Status::OK();
+  }
+
+  // The element count is a multiple of the stride as the stride is one of the dimensions, so the input is
+  // processed in rows of `stride` elements and the inner loop has no modulo and can be vectorized.
+  const size_t row_size = onnxruntime::narrow<size_t>(stride);
+  const float* offset = offset_.data();
+  const float* scale = scale_.data();
+  auto scale_rows = [x_data, y_data, row_size, per_feature, offset, scale](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t row = first; row < last; ++row) {
+      const T* x = x_data + row * row_size;
+      float* y = y_data + row * row_size;
+      if (per_feature) {
+        for (size_t j = 0; j < row_size; ++j) {
+          y[j] = static_cast<float>((x[j] - offset[j]) * scale[j]);
+        }
+      } else {
+        const float offset0 = offset[0];
+        const float scale0 = scale[0];
+        for (size_t j = 0; j < row_size; ++j) {
+          y[j] = static_cast<float>((x[j] - offset0) * scale0);
+        }
       }
-    } else {
-      concurrency::ThreadPool::TryBatchParallelFor(ttp, x_size, f, 0);
     }
   };
 
-  if (static_cast<int64_t>(offset_.size()) == stride &&
-      static_cast<int64_t>(scale_.size()) == stride) {
-    auto fn = [this, y_data, x_data, stride](ptrdiff_t i) {
-      y_data[i] = static_cast<float>((x_data[i] - offset_[i % stride]) * scale_[i % stride]);
-    };
-    conditional_batch_call(fn);
-  } else if (offset_.size() == 1 && scale_.size() == 1) {
-    auto fn = [this, y_data, x_data](ptrdiff_t i) {
-      y_data[i] = static_cast<float>((x_data[i] - offset_[0]) * scale_[0]);
-    };
-    conditional_batch_call(fn);
+  const std::ptrdiff_t num_rows = static_cast<std::ptrdiff_t>(x_size / row_size);
+  if (x_size < kParallelizationThreshold) {  // TODO: tune this, arbitrary threshold
+    scale_rows(0, num_rows);
   } else {
-    std::ostringstream err_msg;
-    err_msg << "Either both scale and offset can be of feature size (" << stride << ") or 1";
-    return Status(ONNXRUNTIME, INVALID_ARGUMENT, err_msg.str());
+    auto* ttp = context->GetOperatorThreadPool();
+    concurrency::ThreadPool::TryParallelFor(
+        ttp, num_rows,
+        TensorOpCost{static_cast<double>(row_size * sizeof(T)), static_cast<double>(row_size * sizeof(float)),
+                     static_cast<double>(row_size) * 2.0},
+        scale_rows);
   }
   return Status::OK();
 }
@@ -5,6 +5,8 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 #include "core/providers/cpu/math/gemm.h"
@@ -30,37 +32,97 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
+  // squared euclidean norm of each of the n rows of b. SVMClassifier and SVMRegressor compute them once for the
+  // support vectors so the RBF kernel only has to compute the norms of the inputs.
   template <typename T>
-  void batched_kernel_dot(const gsl::span<const T> a, const gsl::span<const T> b,
+  static std::vector<T> squared_norms(const gsl::span<const T> b, ptrdiff_t n, ptrdiff_t k) {
+    std::vector<T> norms(onnxruntime::narrow<size_t>(n));
+    for (ptrdiff_t i = 0; i < n; ++i) {
+      norms[i] = ConstEigenVectorArrayMap<T>(b.data() + i * k, k).square().sum();
+    }
+    return norms;
+  }
+
+  // centers the n rows of b on their mean in place and returns the mean. The RBF kernel only depends on the
+  // distances between inputs and support vectors, which do not change when both are shifted by the same vector.
+  template <typename T>
+  static std::vector<T> center_rows(const gsl::span<T> b, ptrdiff_t n, ptrdiff_t k) {
+    std::vector<T> mean(onnxruntime::narrow<size_t>(k), T{0});
+    auto rows = EigenMatrixMap<T>(b.data(), k, n);
+    auto mean_map = EigenVectorMap<T>(mean.data(), k);
+    if (n > 0) {
+      mean_map = rows.rowwise().mean();
+      rows.colwise() -= mean_map;
+    }
+    return mean;
+  }
+
+  // For the RBF kernel, b may already be centered on b_mean with b_squared_norms the squared norms of its centered
+  // rows, which SVMClassifier and SVMRegressor prepare once for the support vectors.
+  template <typename T>
+  void batched_kernel_dot(const gsl::span<const T> a, gsl::span<const T> b,
                           ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
                           float scalar_C,
                           const gsl::span<T> out,
-                          concurrency::ThreadPool* threadpool) const {
+                          concurrency::ThreadPool* threadpool,
+                          gsl::span<const T> b_mean = {},
+                          gsl::span<const T> b_squared_norms = {}) const {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
     if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
+      std::vector<T> centered_b;
+      std::vector<T> computed_mean;
+      std::vector<T> computed_norms;
+      if (b_mean.empty()) {
+        centered_b.assign(b.begin(), b.end());
+        computed_mean = center_rows<T>(centered_b, n, k);
+        computed_norms = squared_norms<T>(centered_b, n, k);
+        b = centered_b;
+        b_mean = computed_mean;
+        b_squared_norms = computed_norms;
+      }
+      assert(b_mean.size() == size_t(k) && b_squared_norms.size() == size_t(n));
 
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
+      // the inputs are centered on the support vector mean as well. ||a - b||^2 = ||a||^2 + ||b||^2 - 2 a.b loses
+      // precision when the norms are large compared with the distance, centering keeps the norms small so the
+      // distances between every input and every support vector come from a single GEMM followed by an element-wise
+      // transform of each row.
+      std::vector<T> centered_a(a.begin(), a.end());
+      EigenMatrixMap<T>(centered_a.data(), k, m).colwise() -= ConstEigenVectorMap<T>(b_mean.data(), k);
 
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
-        for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        -2.f, centered_a.data(), b.data(), 0.f,
+                                        nullptr, nullptr,
+                                        out.data(),
+                                        threadpool);
 
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
+      const T neg_gamma = static_cast<T>(-gamma_);
+      auto transform_rows = [&](ptrdiff_t first, ptrdiff_t last) {
+        auto b_norms = ConstEigenVectorArrayMap<T>(b_squared_norms.data(), n);
+        for (ptrdiff_t batch = first; batch < last; ++batch) {
+          auto cur_a = ConstEigenVectorArrayMap<T>(centered_a.data() + batch * k, k);
+          auto cur_out = EigenVectorArrayMap<T>(out.data() + batch * n, n);
+          cur_out += b_norms + cur_a.square().sum();
+
+          // a distance that rounded below zero is computed again from the difference of the two vectors
+          for (ptrdiff_t support_vector = 0; support_vector < n; ++support_vector) {
+            if (cur_out[support_vector] < 0) {
+              cur_out[support_vector] =
+                  (cur_a - ConstEigenVectorArrayMap<T>(b.data() + support_vector * k, k)).square().sum();
+            }
           }
 
-          *cur_out++ = std::exp(-gamma_ * sum);
+          cur_out *= neg_gamma;
+          MlasComputeExp(cur_out.data(), cur_out.data(), onnxruntime::narrow<size_t>(n));
         }
+      };
 
-        cur_batch += k;  // move to start of next batch
-      }
+      concurrency::ThreadPool::TryParallelFor(
+          threadpool, m,
+          TensorOpCost{static_cast<double>((n + k) * sizeof(T)), static_cast<double>(n * sizeof(T)),
+                       static_cast<double>(n * 8 + k * 2)},
+          transform_rows);
     } else {
       float alpha = 1.f;
       float beta = 1.f;
@@ -104,8 +166,10 @@ class SVMCommon {
 
 class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
+  using SVMCommon::center_rows;
   using SVMCommon::get_kernel_type;
   using SVMCommon::set_kernel_type;
+  using SVMCommon::squared_norms;
 
  public:
   SVMClassifier(const OpKernelInfo& info);
@@ -126,6 +190,8 @@ class SVMClassifier final : public OpKernel, private SVMCommon {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<float> support_vectors_mean_;   // only used by the RBF kernel
+  std::vector<float> support_vectors_norms_;  // only used by the RBF kernel
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
@@ -31,6 +31,11 @@ SVMRegressor<T>::SVMRegressor(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  // length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    if (get_kernel_type() == KERNEL::RBF) {
+      // the RBF kernel works on support vectors centered on their mean, see SVMCommon::batched_kernel_dot
+      support_vectors_mean_ = center_rows<float>(support_vectors_, vector_count_, feature_count_);
+      support_vectors_norms_ = squared_norms<float>(support_vectors_, vector_count_, feature_count_);
+    }
   } else {
     feature_count_ = coefficients_.size();
     mode_ = SVM_TYPE::SVM_LINEAR;
@@ -68,7 +73,7 @@ Status SVMRegressor<T>::Compute(OpKernelContext* ctx) const {
     // combine the input data with the support vectors and apply the kernel type
     // output is {num_batches, vector_count_}
     batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, tmp_data_span,
-                              threadpool);
+                              threadpool, support_vectors_mean_, support_vectors_norms_);
 
     static const TensorShape rho_shape({1});
 
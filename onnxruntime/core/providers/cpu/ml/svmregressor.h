@@ -15,8 +15,10 @@ namespace ml {
 template <typename T>
 class SVMRegressor final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
+  using SVMCommon::center_rows;
   using SVMCommon::get_kernel_type;
   using SVMCommon::set_kernel_type;
+  using SVMCommon::squared_norms;
 
  public:
   SVMRegressor(const OpKernelInfo& info);
@@ -29,6 +31,8 @@ class SVMRegressor final : public OpKernel, private SVMCommon {
   std::vector<float> rho_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<float> support_vectors_mean_;   // only used by the RBF kernel
+  std::vector<float> support_vectors_norms_;  // only used by the RBF kernel
   POST_EVAL_TRANSFORM post_transform_;
   SVM_TYPE mode_;  // how are we computing SVM? 0=LibSVC, 1=LibLinear
 };
@@ -8,6 +8,7 @@
 #include "tree_ensemble_helper.h"
 #include "tree_ensemble_attribute.h"
 #include "tree_ensemble_aggregator.h"
+#include "tree_ensemble_compact.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -38,6 +39,7 @@ class TreeEnsembleCommonAttributes {
   int parallel_tree_;    // starts parallelizing the computing by trees if n_tree >= parallel_tree_
   int parallel_tree_N_;  // batch size if parallelizing by trees
   int parallel_N_;       // starts parallelizing the computing by rows if n_rows <= parallel_N_
+  int compact_N_;        // evaluates a block of rows with the compact layout if it has at least compact_N_ rows
 };
 
 // TI: input type
@@ -53,6 +55,11 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   // `ThresholdType` is used as well for output type (double as well for lightgbm) and not `OutputType`.
   std::vector<SparseValue<ThresholdType>> weights_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
+  // Number of trees evaluated at once on a single row with the compact layout.
+  static constexpr size_t kRowTreeBlock = 64;
+  // Same trees as roots_, only built if all nodes share the same comparison rule and trees are not too deep.
+  TreeEnsembleCompactLayout<ThresholdType> compact_;
+  NODE_MODE_ORT compact_mode_;
 
  public:
   TreeEnsembleCommon() {}
@@ -69,6 +76,21 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Evaluates tree j on n_rows rows and stores the index in nodes_ of the leaf reached by each row.
+  void ProcessTreeNodeLeaves(size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+                             uint32_t* leaf_ids) const;
+
+  // Evaluates trees [begin, end) on one row with the compact layout and stores the index in nodes_ of the leaf
+  // reached in each tree.
+  void ProcessRowNodeLeaves(size_t begin, size_t end, const InputType* x_data, uint32_t* leaf_ids) const;
+
+  bool UseCompactLayout(int64_t n_rows) const { return !compact_.empty() && n_rows >= compact_N_; }
+
+  // Number of rows per block when parallelizing by rows with the compact layout, small enough to keep all threads busy.
+  int64_t ComputeCompactBlockSize(int64_t N, int max_num_threads) const {
+    return std::max<int64_t>(compact_N_, std::min<int64_t>(parallel_tree_N_, (N + max_num_threads - 1) / max_num_threads));
+  }
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
 
@@ -288,6 +310,19 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
     }
   }
 
+  compact_N_ = 16;
+  compact_mode_ = NODE_MODE_ORT::BRANCH_LEQ;
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf()) {
+      compact_mode_ = node.mode();
+      break;
+    }
+  }
+  if (same_mode_ && (compact_mode_ == NODE_MODE_ORT::BRANCH_LEQ || compact_mode_ == NODE_MODE_ORT::BRANCH_LT ||
+                     compact_mode_ == NODE_MODE_ORT::BRANCH_GTE || compact_mode_ == NODE_MODE_ORT::BRANCH_GT)) {
+    compact_.Build(roots_, nodes_, max_feature_id_, has_missing_tracks_);
+  }
+
   return Status::OK();
 }
 
@@ -484,7 +519,16 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
   if (n_targets_or_classes_ == 1) {
     if (N == 1) {
       ScoreValue<ThresholdType> score = {0, 0};
-      if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A: 1 output, 1 row and not enough trees to parallelize */
+      if ((n_trees_ <= parallel_tree_ || max_num_threads == 1) && !compact_.empty()) { /* section A with the compact layout */
+        uint32_t leaf_ids[kRowTreeBlock];
+        for (size_t begin = 0; begin < static_cast<size_t>(n_trees_); begin += kRowTreeBlock) {
+          const size_t end = std::min(static_cast<size_t>(n_trees_), begin + kRowTreeBlock);
+          ProcessRowNodeLeaves(begin, end, x_data, leaf_ids);
+          for (size_t j = begin; j < end; ++j) {
+            agg.ProcessTreeNodePrediction1(score, nodes_[leaf_ids[j - begin]]);
+          }
+        }
+      } else if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A: 1 output, 1 row and not enough trees to parallelize */
         for (int64_t j = 0; j < n_trees_; ++j) {
           agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data));
         }
@@ -515,6 +559,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       // split into batch so that every batch holds on caches, then loop on trees and finally loop
       // on the batch rows.
       std::vector<ScoreValue<ThresholdType>> scores(parallel_tree_N_);
+      std::vector<uint32_t> leaf_ids(parallel_tree_N_);
       size_t j;
       int64_t i, batch, batch_end;
 
@@ -524,8 +569,9 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           scores[SafeInt<ptrdiff_t>(i - batch)] = {0, 0};
         }
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+          ProcessTreeNodeLeaves(j, x_data + batch * stride, stride, batch_end - batch, leaf_ids.data());
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], nodes_[leaf_ids[SafeInt<ptrdiff_t>(i - batch)]]);
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -544,13 +590,15 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             num_threads,
             [this, &agg, &scores, num_threads, x_data, N, begin_n, end_n, stride](ptrdiff_t batch_num) {
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(this->n_trees_));
+              std::vector<uint32_t> leaf_ids(onnxruntime::narrow<size_t>(end_n - begin_n));
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i] = {0, 0};
               }
               for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + begin_n * stride, stride, end_n - begin_n, leaf_ids.data());
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                 *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+                                                 nodes_[leaf_ids[SafeInt<ptrdiff_t>(i - begin_n)]]);
                 }
               }
             });
@@ -569,6 +617,28 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
                                   label_data == nullptr ? nullptr : (label_data + i));
             }
           });
+    } else if (UseCompactLayout(parallel_tree_N_)) { /* section E: 1 output, 2+ rows, parallelization by blocks of rows */
+      const int64_t block_size = ComputeCompactBlockSize(N, max_num_threads);
+      concurrency::ThreadPool::TryBatchParallelFor(
+          ttp,
+          SafeInt<int32_t>((N + block_size - 1) / block_size),
+          [this, &agg, x_data, z_data, stride, label_data, N, block_size](ptrdiff_t block) {
+            const int64_t begin_n = block * block_size;
+            const int64_t end_n = std::min(N, begin_n + block_size);
+            std::vector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(end_n - begin_n), {0, 0});
+            std::vector<uint32_t> leaf_ids(onnxruntime::narrow<size_t>(end_n - begin_n));
+            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+              ProcessTreeNodeLeaves(j, x_data + begin_n * stride, stride, end_n - begin_n, leaf_ids.data());
+              for (int64_t i = begin_n; i < end_n; ++i) {
+                agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - begin_n)], nodes_[leaf_ids[SafeInt<ptrdiff_t>(i - begin_n)]]);
+              }
+            }
+            for (int64_t i = begin_n; i < end_n; ++i) {
+              agg.FinalizeScores1(z_data + i, scores[SafeInt<ptrdiff_t>(i - begin_n)],
+                                  label_data == nullptr ? nullptr : (label_data + i));
+            }
+          },
+          max_num_threads);
     } else { /* section E: 1 output, 2+ rows, parallelization by rows */
       concurrency::ThreadPool::TryBatchParallelFor(
           ttp,
@@ -588,8 +658,19 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
     if (N == 1) {                                               /* section A2: 2+ outputs, 1 row, not enough trees to parallelize */
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A2 */
         InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
-        for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data), weights_);
+        if (!compact_.empty()) {
+          uint32_t leaf_ids[kRowTreeBlock];
+          for (size_t begin = 0; begin < static_cast<size_t>(n_trees_); begin += kRowTreeBlock) {
+            const size_t end = std::min(static_cast<size_t>(n_trees_), begin + kRowTreeBlock);
+            ProcessRowNodeLeaves(begin, end, x_data, leaf_ids);
+            for (size_t j = begin; j < end; ++j) {
+              agg.ProcessTreeNodePrediction(scores, nodes_[leaf_ids[j - begin]], weights_);
+            }
+          }
+        } else {
+          for (int64_t j = 0; j < n_trees_; ++j) {
+            agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data), weights_);
+          }
         }
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else { /* section B2: 2+ outputs, 1 row, enough trees to parallelize */
@@ -612,6 +693,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       }
     } else if (N <= parallel_N_ || max_num_threads == 1) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
       std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(parallel_tree_N_);
+      std::vector<uint32_t> leaf_ids(parallel_tree_N_);
       size_t j, limit;
       int64_t i, batch, batch_end;
       batch_end = std::min(N, static_cast<int64_t>(parallel_tree_N_));
@@ -624,8 +706,9 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           std::fill(scores[SafeInt<ptrdiff_t>(i - batch)].begin(), scores[SafeInt<ptrdiff_t>(i - batch)].end(), ScoreValue<ThresholdType>({0, 0}));
         }
         for (j = 0, limit = roots_.size(); j < limit; ++j) {
+          ProcessTreeNodeLeaves(j, x_data + batch * stride, stride, batch_end - batch, leaf_ids.data());
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], nodes_[leaf_ids[SafeInt<ptrdiff_t>(i - batch)]], weights_);
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -645,13 +728,15 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             num_threads,
             [this, &agg, &scores, num_threads, x_data, N, stride, begin_n, end_n](ptrdiff_t batch_num) {
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(this->n_trees_));
+              std::vector<uint32_t> leaf_ids(onnxruntime::narrow<size_t>(end_n - begin_n));
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               }
               for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + begin_n * stride, stride, end_n - begin_n, leaf_ids.data());
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                                                nodes_[leaf_ids[SafeInt<ptrdiff_t>(i - begin_n)]], weights_);
                 }
               }
             });
@@ -670,6 +755,30 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
                                  label_data == nullptr ? nullptr : (label_data + i));
             }
           });
+    } else if (UseCompactLayout(parallel_tree_N_)) { /* section E2: 2+ outputs, 2+ rows, parallelization by blocks of rows */
+      const int64_t block_size = ComputeCompactBlockSize(N, max_num_threads);
+      concurrency::ThreadPool::TryBatchParallelFor(
+          ttp,
+          SafeInt<int32_t>((N + block_size - 1) / block_size),
+          [this, &agg, x_data, z_data, stride, label_data, N, block_size](ptrdiff_t block) {
+            const int64_t begin_n = block * block_size;
+            const int64_t end_n = std::min(N, begin_n + block_size);
+            std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(
+                onnxruntime::narrow<size_t>(end_n - begin_n),
+                InlinedVector<ScoreValue<ThresholdType>>(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0}));
+            std::vector<uint32_t> leaf_ids(onnxruntime::narrow<size_t>(end_n - begin_n));
+            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+              ProcessTreeNodeLeaves(j, x_data + begin_n * stride, stride, end_n - begin_n, leaf_ids.data());
+              for (int64_t i = begin_n; i < end_n; ++i) {
+                agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - begin_n)], nodes_[leaf_ids[SafeInt<ptrdiff_t>(i - begin_n)]], weights_);
+              }
+            }
+            for (int64_t i = begin_n; i < end_n; ++i) {
+              agg.FinalizeScores(scores[SafeInt<ptrdiff_t>(i - begin_n)], z_data + i * n_targets_or_classes_, -1,
+                                 label_data == nullptr ? nullptr : (label_data + i));
+            }
+          },
+          max_num_threads);
     } else { /* section E2: 2+ outputs, 2+ rows, parallelization by rows */
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
       concurrency::ThreadPool::TrySimpleParallelFor(
@@ -814,6 +923,61 @@ TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
   return root;
 }
 
+#define TREE_FIND_LEAVES_COMPACT(MODE)                                                                     \
+  if (has_missing_tracks_) {                                                                               \
+    compact_.template Evaluate<NODE_MODE_ORT::MODE, true>(j, x_data, stride, n_rows, leaf_ids);            \
+  } else {                                                                                                 \
+    compact_.template Evaluate<NODE_MODE_ORT::MODE, false>(j, x_data, stride, n_rows, leaf_ids);           \
+  }                                                                                                        \
+  return;
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    size_t j, const InputType* x_data, int64_t stride, int64_t n_rows, uint32_t* leaf_ids) const {
+  if (UseCompactLayout(n_rows)) {
+    switch (compact_mode_) {
+      case NODE_MODE_ORT::BRANCH_LEQ:
+        TREE_FIND_LEAVES_COMPACT(BRANCH_LEQ)
+      case NODE_MODE_ORT::BRANCH_LT:
+        TREE_FIND_LEAVES_COMPACT(BRANCH_LT)
+      case NODE_MODE_ORT::BRANCH_GTE:
+        TREE_FIND_LEAVES_COMPACT(BRANCH_GTE)
+      case NODE_MODE_ORT::BRANCH_GT:
+        TREE_FIND_LEAVES_COMPACT(BRANCH_GT)
+      default:
+        break;
+    }
+  }
+  for (int64_t i = 0; i < n_rows; ++i) {
+    leaf_ids[i] = static_cast<uint32_t>(ProcessTreeNodeLeave(roots_[j], x_data + i * stride) - nodes_.data());
+  }
+}
+
+#define TREE_FIND_ROW_LEAVES_COMPACT(MODE)                                                                 \
+  if (has_missing_tracks_) {                                                                               \
+    compact_.template EvaluateRow<NODE_MODE_ORT::MODE, true>(begin, end, x_data, leaf_ids);                \
+  } else {                                                                                                 \
+    compact_.template EvaluateRow<NODE_MODE_ORT::MODE, false>(begin, end, x_data, leaf_ids);               \
+  }                                                                                                        \
+  break;
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessRowNodeLeaves(
+    size_t begin, size_t end, const InputType* x_data, uint32_t* leaf_ids) const {
+  switch (compact_mode_) {
+    case NODE_MODE_ORT::BRANCH_LEQ:
+      TREE_FIND_ROW_LEAVES_COMPACT(BRANCH_LEQ)
+    case NODE_MODE_ORT::BRANCH_LT:
+      TREE_FIND_ROW_LEAVES_COMPACT(BRANCH_LT)
+    case NODE_MODE_ORT::BRANCH_GTE:
+      TREE_FIND_ROW_LEAVES_COMPACT(BRANCH_GTE)
+    case NODE_MODE_ORT::BRANCH_GT:
+      TREE_FIND_ROW_LEAVES_COMPACT(BRANCH_GT)
+    default:
+      ORT_THROW("Unexpected mode for the compact layout: ", static_cast<int>(compact_mode_));
+  }
+}
+
 // TI: input type
 // TH: threshold type, double if T==double, float otherwise
 // TO: output type
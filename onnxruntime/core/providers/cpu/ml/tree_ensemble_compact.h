@@ -0,0 +1,341 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "tree_ensemble_aggregator.h"
+#include "tree_ensemble_attribute.h"
+
+namespace onnxruntime {
+namespace ml {
+namespace detail {
+
+/**
+ * Structure-of-arrays layout of the trees of an ensemble used to evaluate a block of rows at once.
+ * Every tree is stored as a complete binary tree in breadth-first order, the children of node k are
+ * 2k+1 (true branch) and 2k+2 (false branch), so no child pointer is stored and a node only holds a 16-bit
+ * feature id and a threshold. A leaf above the depth of its tree is padded with nodes whose subtrees all lead
+ * to that leaf. The traversal has no data-dependent branch: rows are evaluated side by side in lanes and
+ * every lane moves down one level per step until all of them reach the leaves.
+ * A single row is evaluated with kernels specialized for the depth of every tree. When all nodes of each level of
+ * a tree share the same feature and threshold (oblivious tree), the leaf is found from the comparisons of
+ * every level without following the path.
+ */
+template <typename ThresholdType>
+class TreeEnsembleCompactLayout {
+ public:
+  // Trees deeper than kMaxDepth are not converted.
+  static constexpr int kMaxDepth = 16;
+  // The layout is not built if padding makes it more than kMaxInflation times larger than the original trees.
+  static constexpr size_t kMaxInflation = 4;
+  // Number of rows evaluated side by side.
+  static constexpr int64_t kLanes = 8;
+
+  bool empty() const { return depths_.empty(); }
+
+  // Builds the layout. Returns false and leaves the layout empty if the trees are not suitable.
+  bool Build(const std::vector<TreeNodeElement<ThresholdType>*>& roots,
+             const std::vector<TreeNodeElement<ThresholdType>>& nodes,
+             int64_t max_feature_id, bool has_missing_tracks);
+
+  // Evaluates tree `tree` on n_rows rows and stores the index in `nodes` of the leaf reached by each row.
+  template <NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+  void Evaluate(size_t tree, const InputType* x_data, int64_t stride, int64_t n_rows, uint32_t* leaf_ids) const;
+
+  // Evaluates trees [begin, end) on one row and stores the index in `nodes` of the leaf reached in each tree.
+  template <NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+  void EvaluateRow(size_t begin, size_t end, const InputType* x_data, uint32_t* leaf_ids) const;
+
+ private:
+  // Depth of the trees evaluated with a kernel specialized for their depth.
+  static constexpr int kMaxUnrolledDepth = 8;
+
+  static int Depth(const TreeNodeElement<ThresholdType>* node, int limit);
+  void Fill(const TreeNodeElement<ThresholdType>* node, const TreeNodeElement<ThresholdType>* nodes,
+            size_t k, int level, int depth, size_t node_offset, size_t leaf_offset, std::vector<uint8_t>& padding);
+  bool MakeOblivious(size_t tree, const std::vector<uint8_t>& padding);
+
+  // A negative depth means the depth of the tree is only known at runtime.
+  template <int depth, NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+  uint32_t EvaluateTree(size_t tree, const InputType* x_data) const;
+  template <int depth, NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+  uint32_t EvaluateObliviousTree(size_t tree, const InputType* x_data) const;
+
+  template <int64_t n_lanes, NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+  void EvaluateLanes(size_t tree, const InputType* x_data, int64_t stride, uint32_t* leaf_ids) const;
+
+  std::vector<uint16_t> feature_ids_;
+  std::vector<ThresholdType> thresholds_;
+  std::vector<uint8_t> missing_tracks_true_;  // empty if no node tracks missing values
+  std::vector<uint32_t> leaves_;
+  std::vector<size_t> node_offsets_;
+  std::vector<size_t> leaf_offsets_;
+  std::vector<int> depths_;
+  std::vector<uint8_t> oblivious_;
+};
+
+template <typename ThresholdType>
+int TreeEnsembleCompactLayout<ThresholdType>::Depth(const TreeNodeElement<ThresholdType>* node, int limit) {
+  if (!node->is_not_leaf()) {
+    return 0;
+  }
+  if (limit == 0) {
+    return 1;
+  }
+  return 1 + std::max(Depth(node + 1, limit - 1), Depth(node->truenode_or_weight.ptr, limit - 1));
+}
+
+template <typename ThresholdType>
+void TreeEnsembleCompactLayout<ThresholdType>::Fill(const TreeNodeElement<ThresholdType>* node,
+                                                    const TreeNodeElement<ThresholdType>* nodes,
+                                                    size_t k, int level, int depth,
+                                                    size_t node_offset, size_t leaf_offset,
+                                                    std::vector<uint8_t>& padding) {
+  if (level == depth) {
+    leaves_[leaf_offset + k - ((size_t{1} << depth) - 1)] = narrow<uint32_t>(node - nodes);
+    return;
+  }
+  if (node->is_not_leaf()) {
+    feature_ids_[node_offset + k] = static_cast<uint16_t>(node->feature_id);
+    thresholds_[node_offset + k] = node->value_or_unique_weight;
+    if (!missing_tracks_true_.empty()) {
+      missing_tracks_true_[node_offset + k] = node->is_missing_track_true() ? 1 : 0;
+    }
+    Fill(node->truenode_or_weight.ptr, nodes, 2 * k + 1, level + 1, depth, node_offset, leaf_offset, padding);
+    Fill(node + 1, nodes, 2 * k + 2, level + 1, depth, node_offset, leaf_offset, padding);
+  } else {
+    // Padding, feature 0 and threshold 0 do not matter as both subtrees lead to the same leaf.
+    padding[node_offset + k] = 1;
+    Fill(node, nodes, 2 * k + 1, level + 1, depth, node_offset, leaf_offset, padding);
+    Fill(node, nodes, 2 * k + 2, level + 1, depth, node_offset, leaf_offset, padding);
+  }
+}
+
+template <typename ThresholdType>
+bool TreeEnsembleCompactLayout<ThresholdType>::MakeOblivious(size_t tree, const std::vector<uint8_t>& padding) {
+  const size_t offset = node_offsets_[tree];
+  for (size_t first = 0, last = 1; first < (size_t{1} << depths_[tree]) - 1; first = last, last = 2 * last + 1) {
+    size_t ref = first;
+    while (ref < last && padding[offset + ref]) {
+      ++ref;
+    }
+    for (size_t k = ref; k < last; ++k) {
+      if (!padding[offset + k] &&
+          (feature_ids_[offset + k] != feature_ids_[offset + ref] ||
+           thresholds_[offset + k] != thresholds_[offset + ref] ||
+           (!missing_tracks_true_.empty() && missing_tracks_true_[offset + k] != missing_tracks_true_[offset + ref]))) {
+        return false;
+      }
+    }
+  }
+  // Both subtrees of a padding node lead to the same leaf, it can take the rule of its level.
+  for (size_t first = 0, last = 1; first < (size_t{1} << depths_[tree]) - 1; first = last, last = 2 * last + 1) {
+    size_t ref = first;
+    while (ref < last && padding[offset + ref]) {
+      ++ref;
+    }
+    if (ref == last) {
+      continue;
+    }
+    for (size_t k = first; k < last; ++k) {
+      feature_ids_[offset + k] = feature_ids_[offset + ref];
+      thresholds_[offset + k] = thresholds_[offset + ref];
+      if (!missing_tracks_true_.empty()) {
+        missing_tracks_true_[offset + k] = missing_tracks_true_[offset + ref];
+      }
+    }
+  }
+  return true;
+}
+
+template <typename ThresholdType>
+bool TreeEnsembleCompactLayout<ThresholdType>::Build(const std::vector<TreeNodeElement<ThresholdType>*>& roots,
+                                                     const std::vector<TreeNodeElement<ThresholdType>>& nodes,
+                                                     int64_t max_feature_id, bool has_missing_tracks) {
+  depths_.clear();
+  if (roots.empty() || max_feature_id > std::numeric_limits<uint16_t>::max() ||
+      nodes.size() > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  std::vector<int> depths;
+  depths.reserve(roots.size());
+  size_t n_nodes = 0;
+  size_t n_leaves = 0;
+  for (const auto* root : roots) {
+    int depth = Depth(root, kMaxDepth);
+    if (depth > kMaxDepth) {
+      return false;
+    }
+    depths.push_back(depth);
+    n_nodes += (size_t{1} << depth) - 1;
+    n_leaves += size_t{1} << depth;
+  }
+  if (n_nodes + n_leaves > kMaxInflation * nodes.size()) {
+    return false;
+  }
+
+  feature_ids_.assign(n_nodes, 0);
+  thresholds_.assign(n_nodes, 0);
+  missing_tracks_true_.assign(has_missing_tracks ? n_nodes : 0, 0);
+  leaves_.assign(n_leaves, 0);
+  node_offsets_.resize(roots.size());
+  leaf_offsets_.resize(roots.size());
+  std::vector<uint8_t> padding(n_nodes, 0);
+  size_t node_offset = 0;
+  size_t leaf_offset = 0;
+  for (size_t j = 0; j < roots.size(); ++j) {
+    node_offsets_[j] = node_offset;
+    leaf_offsets_[j] = leaf_offset;
+    Fill(roots[j], nodes.data(), 0, 0, depths[j], node_offset, leaf_offset, padding);
+    node_offset += (size_t{1} << depths[j]) - 1;
+    leaf_offset += size_t{1} << depths[j];
+  }
+  depths_ = std::move(depths);
+
+  oblivious_.resize(roots.size());
+  for (size_t j = 0; j < roots.size(); ++j) {
+    oblivious_[j] = MakeOblivious(j, padding) ? 1 : 0;
+  }
+  return true;
+}
+
+template <NODE_MODE_ORT mode, typename InputType, typename ThresholdType>
+inline bool CompactCompare(InputType val, ThresholdType threshold) {
+  if constexpr (mode == NODE_MODE_ORT::BRANCH_LEQ) {
+    return val <= threshold;
+  } else if constexpr (mode == NODE_MODE_ORT::BRANCH_LT) {
+    return val < threshold;
+  } else if constexpr (mode == NODE_MODE_ORT::BRANCH_GTE) {
+    return val >= threshold;
+  } else {
+    static_assert(mode == NODE_MODE_ORT::BRANCH_GT, "Unsupported mode for the compact layout.");
+    return val > threshold;
+  }
+}
+
+template <typename ThresholdType>
+template <int64_t n_lanes, NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+void TreeEnsembleCompactLayout<ThresholdType>::EvaluateLanes(size_t tree, const InputType* x_data, int64_t stride,
+                                                             uint32_t* leaf_ids) const {
+  const int depth = depths_[tree];
+  const uint16_t* feature_ids = feature_ids_.data() + node_offsets_[tree];
+  const ThresholdType* thresholds = thresholds_.data() + node_offsets_[tree];
+  const uint8_t* missing_tracks_true = has_missing_tracks ? missing_tracks_true_.data() + node_offsets_[tree] : nullptr;
+
+  uint32_t k[n_lanes] = {};
+  for (int level = 0; level < depth; ++level) {
+    for (int64_t l = 0; l < n_lanes; ++l) {
+      const InputType val = x_data[l * stride + feature_ids[k[l]]];
+      bool go_true = CompactCompare<mode>(val, thresholds[k[l]]);
+      if constexpr (has_missing_tracks) {
+        go_true = go_true || (missing_tracks_true[k[l]] && _isnan_(val));
+      }
+      k[l] = 2 * k[l] + 2 - static_cast<uint32_t>(go_true);
+    }
+  }
+
+  const uint32_t* leaves = leaves_.data() + leaf_offsets_[tree];
+  const uint32_t first_leaf = (uint32_t{1} << depth) - 1;
+  for (int64_t l = 0; l < n_lanes; ++l) {
+    leaf_ids[l] = leaves[k[l] - first_leaf];
+  }
+}
+
+template <typename ThresholdType>
+template <NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+void TreeEnsembleCompactLayout<ThresholdType>::Evaluate(size_t tree, const InputType* x_data, int64_t stride,
+                                                        int64_t n_rows, uint32_t* leaf_ids) const {
+  int64_t i = 0;
+  for (; i + kLanes <= n_rows; i += kLanes) {
+    EvaluateLanes<kLanes, mode, has_missing_tracks>(tree, x_data + i * stride, stride, leaf_ids + i);
+  }
+  for (; i < n_rows; ++i) {
+    EvaluateLanes<1, mode, has_missing_tracks>(tree, x_data + i * stride, stride, leaf_ids + i);
+  }
+}
+
+template <typename ThresholdType>
+template <int depth, NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+uint32_t TreeEnsembleCompactLayout<ThresholdType>::EvaluateTree(size_t tree, const InputType* x_data) const {
+  const int tree_depth = depth < 0 ? depths_[tree] : depth;
+  const uint16_t* feature_ids = feature_ids_.data() + node_offsets_[tree];
+  const ThresholdType* thresholds = thresholds_.data() + node_offsets_[tree];
+  const uint8_t* missing_tracks_true = has_missing_tracks ? missing_tracks_true_.data() + node_offsets_[tree] : nullptr;
+
+  uint32_t k = 0;
+  for (int level = 0; level < tree_depth; ++level) {
+    const InputType val = x_data[feature_ids[k]];
+    bool go_true = CompactCompare<mode>(val, thresholds[k]);
+    if constexpr (has_missing_tracks) {
+      go_true = go_true || (missing_tracks_true[k] && _isnan_(val));
+    }
+    k = 2 * k + 2 - static_cast<uint32_t>(go_true);
+  }
+  return leaves_[leaf_offsets_[tree] + k - ((uint32_t{1} << tree_depth) - 1)];
+}
+
+template <typename ThresholdType>
+template <int depth, NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+uint32_t TreeEnsembleCompactLayout<ThresholdType>::EvaluateObliviousTree(size_t tree, const InputType* x_data) const {
+  const int tree_depth = depth < 0 ? depths_[tree] : depth;
+  const uint16_t* feature_ids = feature_ids_.data() + node_offsets_[tree];
+  const ThresholdType* thresholds = thresholds_.data() + node_offsets_[tree];
+  const uint8_t* missing_tracks_true = has_missing_tracks ? missing_tracks_true_.data() + node_offsets_[tree] : nullptr;
+
+  // The comparisons do not depend on each other, every one gives one bit of the position of the leaf.
+  uint32_t slot = 0;
+  for (int level = 0; level < tree_depth; ++level) {
+    const size_t k = (size_t{1} << level) - 1;
+    const InputType val = x_data[feature_ids[k]];
+    bool go_true = CompactCompare<mode>(val, thresholds[k]);
+    if constexpr (has_missing_tracks) {
+      go_true = go_true || (missing_tracks_true[k] && _isnan_(val));
+    }
+    slot = (slot << 1) | static_cast<uint32_t>(!go_true);
+  }
+  return leaves_[leaf_offsets_[tree] + slot];
+}
+
+#define TREE_EVALUATE_ROW_DEPTH(DEPTH)                                                                     \
+  case DEPTH:                                                                                              \
+    leaf_ids[j - begin] = oblivious_[j] ? EvaluateObliviousTree<DEPTH, mode, has_missing_tracks>(j, x_data) \
+                                        : EvaluateTree<DEPTH, mode, has_missing_tracks>(j, x_data);         \
+    break;
+
+template <typename ThresholdType>
+template <NODE_MODE_ORT mode, bool has_missing_tracks, typename InputType>
+void TreeEnsembleCompactLayout<ThresholdType>::EvaluateRow(size_t begin, size_t end, const InputType* x_data,
+                                                           uint32_t* leaf_ids) const {
+  static_assert(kMaxUnrolledDepth == 8, "Update the cases below.");
+  for (size_t j = begin; j < end; ++j) {
+    switch (depths_[j]) {
+      case 0:
+        leaf_ids[j - begin] = leaves_[leaf_offsets_[j]];
+        break;
+      TREE_EVALUATE_ROW_DEPTH(1)
+      TREE_EVALUATE_ROW_DEPTH(2)
+      TREE_EVALUATE_ROW_DEPTH(3)
+      TREE_EVALUATE_ROW_DEPTH(4)
+      TREE_EVALUATE_ROW_DEPTH(5)
+      TREE_EVALUATE_ROW_DEPTH(6)
+      TREE_EVALUATE_ROW_DEPTH(7)
+      TREE_EVALUATE_ROW_DEPTH(8)
+      default:
+        leaf_ids[j - begin] = oblivious_[j] ? EvaluateObliviousTree<-1, mode, has_missing_tracks>(j, x_data)
+                                            : EvaluateTree<-1, mode, has_missing_tracks>(j, x_data);
+        break;
+    }
+  }
+}
+
+#undef TREE_EVALUATE_ROW_DEPTH
+
+}  // namespace detail
+}  // namespace ml
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/zipmap.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 /**
 https://github.com/onnx/onnx/blob/main/onnx/defs/traditionalml/defs.cc
@@ -35,6 +36,47 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+// Maps every label to 0 and records, in the order of the map, the column of X holding the value of each entry.
+// A repeated label gets the value of its last column as it would by inserting the columns one after the other.
+template <typename TKey>
+static void BuildRowTemplate(const std::vector<TKey>& labels, std::map<TKey, float>& row_template,
+                             std::vector<size_t>& value_indices) {
+  std::map<TKey, size_t> columns;
+  for (size_t j = 0; j < labels.size(); ++j) {
+    columns[labels[j]] = j;
+  }
+  value_indices.reserve(columns.size());
+  for (const auto& column : columns) {
+    row_template.emplace_hint(row_template.end(), column.first, 0.f);
+    value_indices.push_back(column.second);
+  }
+}
+
+// Copying the template only allocates the nodes, it does not compare keys, and the values are then written
+// walking the map in order. Rows are independent so they are built in parallel.
+template <typename TKey>
+static void FillRows(const std::map<TKey, float>& row_template, gsl::span<const size_t> value_indices,
+                     const float* x_data, int64_t batch_size, int64_t features_per_batch,
+                     std::vector<std::map<TKey, float>>& y_data, concurrency::ThreadPool* threadpool) {
+  y_data.resize(onnxruntime::narrow<size_t>(batch_size));
+  const double entries = static_cast<double>(value_indices.size());
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, onnxruntime::narrow<std::ptrdiff_t>(batch_size),
+      TensorOpCost{static_cast<double>(features_per_batch * sizeof(float)),
+                   entries * (sizeof(TKey) + sizeof(float)), entries * 64.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t n = first; n < last; ++n) {
+          auto& row = y_data[onnxruntime::narrow<size_t>(n)];
+          row = row_template;
+          const float* x_row = x_data + n * features_per_batch;
+          auto entry = row.begin();
+          for (size_t column : value_indices) {
+            (entry++)->second = x_row[column];
+          }
+        }
+      });
+}
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +84,11 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  if (using_strings_) {
+    BuildRowTemplate(classlabels_strings_, string_row_template_, value_indices_);
+  } else {
+    BuildRowTemplate(classlabels_int64s_, int64_row_template_, value_indices_);
+  }
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -66,6 +113,7 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
   }
 
   const auto* x_data = X.Data<float>();
+  concurrency::ThreadPool* threadpool = context->GetOperatorThreadPool();
 
   if (using_strings_) {
     if (features_per_batch != static_cast<int64_t>(classlabels_strings_.size())) {
@@ -77,17 +125,7 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
 
-    // auto* y_data = Y->MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(onnxruntime::narrow<size_t>(batch_size));
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[onnxruntime::narrow<size_t>(j)]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[onnxruntime::narrow<size_t>(n)] = std::move(map1);
-    }
+    FillRows(string_row_template_, value_indices_, x_data, batch_size, features_per_batch, *y_data, threadpool);
   } else {
     if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
       return Status(ONNXRUNTIME,
@@ -97,17 +135,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     }
     auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    // auto* y_data = Y->MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(onnxruntime::narrow<size_t>(batch_size));
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+
+    FillRows(int64_row_template_, value_indices_, x_data, batch_size, features_per_batch, *y_data, threadpool);
   }
   return common::Status::OK();
 }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <map>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 namespace onnxruntime {
@@ -16,6 +17,11 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+  // One output map with every label mapped to 0. The output maps are copies of it with the values written in
+  // the order of the map, X[value_indices_[i]] is the value of its i-th entry.
+  std::map<std::string, float> string_row_template_;
+  std::map<std::int64_t, float> int64_row_template_;
+  std::vector<size_t> value_indices_;
 };
 
 }  // namespace ml
@@ -3,6 +3,7 @@
 
 #include "tfidfvectorizer.h"
 #include "core/common/common.h"
+#include "core/common/hash_combine.h"
 #include "core/common/inlined_containers.h"
 #include <core/common/safeint.h>
 #include "core/framework/tensor.h"
@@ -25,66 +26,87 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
+// NgramTrie implements a Trie like structure
+// for a unigram (1) it would insert a child of the root with a valid id.
 // for (1,2,3) node 2 would be a child of 1 but have id == 0
 // because (1,2) does not exists. Node 3 would have a valid id.
+// The nodes are stored in one array and the edges of all the nodes in a single flat hash table
+// keyed by (parent node, item) so walking an n-gram probes one table instead of following pointers
+// through a separate map per node.
 template <class T>
-struct NgramPart;
+class NgramTrie {
+ public:
+  static constexpr size_t kRoot = 0;
 
-template <>
-struct NgramPart<int64_t>;
+  NgramTrie() : nodes_(1) {}
 
-template <>
-struct NgramPart<std::string>;
+  // True if the trie does not contain any n-gram.
+  bool Empty() const { return edges_.empty(); }
 
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
+  // Returns the child of node for item, it is created if it does not exist yet.
+  size_t Insert(size_t node, const T& item) {
+    auto p = edges_.emplace(Edge{node, item}, nodes_.size());
+    if (p.second) {
+      nodes_[node].has_children_ = true;
+      nodes_.emplace_back();
+    }
+    return p.first->second;
+  }
+
+  // Returns the child of node for item or kRoot if there is none, the root is never a child.
+  size_t Find(size_t node, const T& item) const {
+    auto hit = edges_.find(Edge{node, item});
+    return hit == edges_.end() ? kRoot : hit->second;
+  }
+
+  bool HasChildren(size_t node) const { return nodes_[node].has_children_; }
+  size_t Id(size_t node) const { return nodes_[node].id_; }
+  void SetId(size_t node, size_t id) { nodes_[node].id_ = id; }
+
+ private:
+  struct Node {
+    size_t id_ = 0;  // 0 - means no entry, search for a bigger N
+    bool has_children_ = false;
+  };
+
+  struct Edge {
+    size_t parent;
+    T item;
+    bool operator==(const Edge& other) const { return parent == other.parent && item == other.item; }
+  };
 
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = InlinedHashMap<int64_t, std::unique_ptr<NgramPartInt>>;
+  struct EdgeHash {
+    size_t operator()(const Edge& edge) const {
+      size_t seed = std::hash<T>{}(edge.item);
+      HashCombineWithHashValue(edge.parent, seed);
+      return seed;
+    }
+  };
 
 #ifndef DISABLE_ABSEIL
-using StrMap = absl::flat_hash_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                   std::hash<std::string>, std::equal_to<std::string>>;
+  absl::flat_hash_map<Edge, size_t, EdgeHash> edges_;
 #else
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
+  std::unordered_map<Edge, size_t, EdgeHash> edges_;
 #endif
-
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+  std::vector<Node> nodes_;
 };
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+// The items of string n-grams are views of the pool_strings attribute.
+using NgramTrieInt = NgramTrie<int64_t>;
+using NgramTrieString = NgramTrie<std::string_view>;
 
 // Returns next ngram_id
-template <class K, class ForwardIter, class Map>
+template <class ForwardIter, class Trie>
 inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
+                            Trie& trie) {
   for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
-      }
-      ++n;
-      m = &p.first->second->leafs_;
+    size_t node = Trie::kRoot;
+    for (size_t n = 0; n < ngram_size; ++n, ++first) {
+      node = trie.Insert(node, *first);
     }
+    ORT_ENFORCE(trie.Id(node) == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+    trie.SetId(node, ngram_id);
+    ++ngram_id;
   }
   return ngram_id;
 }
@@ -134,11 +156,11 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float> weights_;
 
-  // This map contains references to pool_string_ entries
+  // This trie contains views of the entries
   // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  NgramTrieString str_trie_;
+  // This trie contains pool_int64s entries
+  NgramTrieInt int64_trie_;
 
   size_t output_size_ = 0;
 
@@ -212,10 +234,15 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
   }
 
   gsl::span<const int64_t> pool_int64s;
-  std::vector<std::reference_wrapper<const std::string>> pool_strings;
-  status = info.GetAttrsStringRefs("pool_strings", pool_strings);
+  std::vector<std::reference_wrapper<const std::string>> pool_string_refs;
+  std::vector<std::string_view> pool_strings;
+  status = info.GetAttrsStringRefs("pool_strings", pool_string_refs);
   if (status.IsOK()) {
-    ORT_ENFORCE(!pool_strings.empty(), "pool_strings must not be empty if specified");
+    ORT_ENFORCE(!pool_string_refs.empty(), "pool_strings must not be empty if specified");
+    pool_strings.reserve(pool_string_refs.size());
+    for (const std::string& str : pool_string_refs) {
+      pool_strings.push_back(str);
+    }
   } else {
     status = info.GetAttrsAsSpan("pool_int64s", pool_int64s);
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
@@ -241,9 +268,9 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = PopulateGrams(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_trie_);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = PopulateGrams(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_trie_);
         }
       } else {
         ngram_id += ngrams;
@@ -281,39 +308,39 @@ void TfIdfVectorizer::ComputeImpl(const void* x_data_raw, size_t elem_size, ptrd
       auto ngram_item = ngram_start;
       if (is_input_string) {
         const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
+        const NgramTrieString& str_trie = impl.str_trie_;
+        size_t node = NgramTrieString::kRoot;
         for (auto ngram_size = 1;
-             !str_map->empty() &&
+             str_trie.HasChildren(node) &&
              ngram_size <= max_gram_length &&
              str_item < ngram_row_end;
              ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
+          node = str_trie.Find(node, *str_item);
+          if (node == NgramTrieString::kRoot) {
             break;
           }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
+          if (ngram_size >= start_ngram_size && str_trie.Id(node) != 0) {
+            output_idx = impl.OutputIdToIncrement(str_trie.Id(node));
             fn_weight(output_idx, output_data);
           }
-          str_map = &hit->second->leafs_;
         }
       } else {
-        const IntMap* int_map = &impl.int64_map_;
+        const NgramTrieInt& int_trie = impl.int64_trie_;
+        size_t node = NgramTrieInt::kRoot;
         for (auto ngram_size = 1;
-             !int_map->empty() &&
+             int_trie.HasChildren(node) &&
              ngram_size <= max_gram_length &&
              ngram_item < ngram_row_end;
              ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
           int64_t val = (elem_size == 4) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
+          node = int_trie.Find(node, val);
+          if (node == NgramTrieInt::kRoot) {
             break;
           }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
+          if (ngram_size >= start_ngram_size && int_trie.Id(node) != 0) {
+            output_idx = impl.OutputIdToIncrement(int_trie.Id(node));
             fn_weight(output_idx, output_data);
           }
-          int_map = &hit->second->leafs_;
         }
       }
       // Sliding window shift
@@ -373,8 +400,8 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   const bool is_input_string = X->IsDataTypeString();
 
   if (total_items == 0 ||
-      (is_input_string && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+      (is_input_string && impl_->str_trie_.Empty()) ||
+      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_trie_.Empty())) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
@@ -13,10 +13,12 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -118,6 +120,198 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+// Corners and areas of boxes in separate arrays, so the IoU of a candidate against a block of selected boxes is
+// computed in one vectorizable loop.
+struct BoxCorners {
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+
+  void Resize(size_t size) {
+    x_min.resize(size);
+    y_min.resize(size);
+    x_max.resize(size);
+    y_max.resize(size);
+    area.resize(size);
+  }
+
+  void Clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  size_t Size() const { return area.size(); }
+
+  void Set(size_t i, const float* box, int64_t center_point_box) {
+    // center_point_box_ only support 0 or 1
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2],
+      MaxMin(box[1], box[3], x_min[i], x_max[i]);
+      MaxMin(box[0], box[2], y_min[i], y_max[i]);
+    } else {
+      // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      x_min[i] = box[0] - width_half;
+      x_max[i] = box[0] + width_half;
+      y_min[i] = box[1] - height_half;
+      y_max[i] = box[1] + height_half;
+    }
+    area[i] = (x_max[i] - x_min[i]) * (y_max[i] - y_min[i]);
+  }
+
+  void PushBack(const BoxCorners& boxes, size_t i) {
+    x_min.push_back(boxes.x_min[i]);
+    y_min.push_back(boxes.y_min[i]);
+    x_max.push_back(boxes.x_max[i]);
+    y_max.push_back(boxes.y_max[i]);
+    area.push_back(boxes.area[i]);
+  }
+};
+
+struct ScoreIndex {
+  float score;
+  int index;
+};
+
+// Highest score first, ties broken by the lowest box index.
+inline bool HigherScore(const ScoreIndex& lhs, const ScoreIndex& rhs) {
+  return lhs.score > rhs.score || (lhs.score == rhs.score && lhs.index < rhs.index);
+}
+
+// Same result as SuppressByIOU against each selected box. The selected boxes are checked in blocks without early
+// exit inside a block so the compiler can vectorize the IoU computation.
+bool SuppressedBySelected(const BoxCorners& boxes, size_t candidate, const BoxCorners& selected,
+                          float iou_threshold) {
+  constexpr size_t kBlockSize = 16;
+
+  const float x1_min = boxes.x_min[candidate];
+  const float y1_min = boxes.y_min[candidate];
+  const float x1_max = boxes.x_max[candidate];
+  const float y1_max = boxes.y_max[candidate];
+  const float area1 = boxes.area[candidate];
+  const float* x2_min = selected.x_min.data();
+  const float* y2_min = selected.y_min.data();
+  const float* x2_max = selected.x_max.data();
+  const float* y2_max = selected.y_max.data();
+  const float* area2 = selected.area.data();
+
+  const size_t count = selected.Size();
+  for (size_t begin = 0; begin < count; begin += kBlockSize) {
+    const size_t end = std::min(begin + kBlockSize, count);
+    int suppressed = 0;
+    for (size_t j = begin; j < end; ++j) {
+      const float intersection_x_min = std::max(x1_min, x2_min[j]);
+      const float intersection_x_max = std::min(x1_max, x2_max[j]);
+      const float intersection_y_min = std::max(y1_min, y2_min[j]);
+      const float intersection_y_max = std::min(y1_max, y2_max[j]);
+      const float intersection_area = (intersection_x_max - intersection_x_min) *
+                                      (intersection_y_max - intersection_y_min);
+      const float union_area = area1 + area2[j] - intersection_area;
+      suppressed |= static_cast<int>(intersection_x_max > intersection_x_min) &
+                    static_cast<int>(intersection_y_max > intersection_y_min) &
+                    static_cast<int>(intersection_area > .0f) &
+                    static_cast<int>(area1 > .0f) &
+                    static_cast<int>(area2[j] > .0f) &
+                    static_cast<int>(union_area > .0f) &
+                    static_cast<int>(intersection_area / union_area > iou_threshold);
+    }
+    if (suppressed != 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace
+
+void NonMaxSuppression::SelectBoxes(const PrepareContext& pc, int64_t center_point_box,
+                                    int64_t max_output_boxes_per_class, float iou_threshold, float score_threshold,
+                                    concurrency::ThreadPool* thread_pool,
+                                    std::vector<SelectedIndex>& selected_indices) {
+  // The first candidates sorted by score, more are sorted only when suppression consumes them.
+  constexpr size_t kMinSortedCandidates = 64;
+
+  const size_t num_boxes = static_cast<size_t>(pc.num_boxes_);
+  const int64_t num_tasks = pc.num_batches_ * pc.num_classes_;
+  const size_t max_selected = static_cast<size_t>(std::min<int64_t>(max_output_boxes_per_class, pc.num_boxes_));
+  const bool has_score_threshold = pc.score_threshold_ != nullptr;
+
+  // The corners of the boxes of a batch are shared by all its classes.
+  BoxCorners boxes;
+  boxes.Resize(narrow<size_t>(pc.num_batches_) * num_boxes);
+  for (size_t i = 0; i < boxes.Size(); ++i) {
+    boxes.Set(i, pc.boxes_data_ + 4 * i, center_point_box);
+  }
+
+  // Every (batch, class) pair is independent and keeps the indices of its selected boxes.
+  std::vector<std::vector<int>> selected_boxes_per_class(narrow<size_t>(num_tasks));
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, narrow<std::ptrdiff_t>(num_tasks),
+      TensorOpCost{static_cast<double>(num_boxes * sizeof(float)), 0.0, static_cast<double>(num_boxes) * 16.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<ScoreIndex> candidates;
+        candidates.reserve(num_boxes);
+        BoxCorners selected_boxes_inside_class;
+
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const size_t batch_offset = static_cast<size_t>(task / pc.num_classes_) * num_boxes;
+
+          // Filter by score_threshold_
+          candidates.clear();
+          const float* class_scores = pc.scores_data_ + static_cast<size_t>(task) * num_boxes;
+          for (size_t box_index = 0; box_index < num_boxes; ++box_index) {
+            if (!has_score_threshold || class_scores[box_index] > score_threshold) {
+              candidates.push_back({class_scores[box_index], static_cast<int>(box_index)});
+            }
+          }
+
+          selected_boxes_inside_class.Clear();
+          auto& selected_boxes = selected_boxes_per_class[static_cast<size_t>(task)];
+          size_t sorted_end = 0;
+          size_t sorted_chunk = std::max(kMinSortedCandidates, 2 * max_selected);
+
+          // Get the next box with top score, filter by iou_threshold
+          for (size_t next = 0; next < candidates.size() && selected_boxes.size() < max_selected; ++next) {
+            if (next == sorted_end) {
+              sorted_end = std::min(candidates.size(), sorted_end + sorted_chunk);
+              std::partial_sort(candidates.begin() + next, candidates.begin() + sorted_end, candidates.end(),
+                                HigherScore);
+              sorted_chunk *= 2;
+            }
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
+            const size_t box = batch_offset + static_cast<size_t>(candidates[next].index);
+            if (!SuppressedBySelected(boxes, box, selected_boxes_inside_class, iou_threshold)) {
+              selected_boxes_inside_class.PushBack(boxes, box);
+              selected_boxes.push_back(candidates[next].index);
+            }
+          }
+        }
+      });
+
+  size_t num_selected = 0;
+  for (const auto& selected_boxes : selected_boxes_per_class) {
+    num_selected += selected_boxes.size();
+  }
+
+  selected_indices.clear();
+  selected_indices.reserve(num_selected);
+  for (int64_t task = 0; task < num_tasks; ++task) {
+    for (int box_index : selected_boxes_per_class[static_cast<size_t>(task)]) {
+      selected_indices.emplace_back(task / pc.num_classes_, task % pc.num_classes_, box_index);
+    }
+  }
+}
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -133,70 +327,9 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  const auto* const boxes_data = pc.boxes_data_;
-  const auto* const scores_data = pc.scores_data_;
-
-  struct BoxInfoPtr {
-    float score_{};
-    int64_t index_{};
-
-    BoxInfoPtr() = default;
-    explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
-    inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
-    }
-  };
-
-  const auto center_point_box = GetCenterPointBox();
-
   std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
-          }
-        }
-
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  // while
-    }  // for class_index
-  }  // for batch_index
+  SelectBoxes(pc, GetCenterPointBox(), max_output_boxes_per_class, iou_threshold, score_threshold,
+              ctx->GetOperatorThreadPool(), selected_indices);
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
@@ -3,12 +3,19 @@
 
 #pragma once
 
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
 
+namespace concurrency {
+class ThreadPool;
+}
+
 struct PrepareContext;
+struct SelectedIndex;
 
 class NonMaxSuppressionBase {
  protected:
@@ -38,5 +45,10 @@ class NonMaxSuppression final : public OpKernel, public NonMaxSuppressionBase {
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+  // Selects the boxes of every batch and class in (batch, class, score) order. Public for the microbenchmark.
+  static void SelectBoxes(const PrepareContext& pc, int64_t center_point_box, int64_t max_output_boxes_per_class,
+                          float iou_threshold, float score_threshold, concurrency::ThreadPool* thread_pool,
+                          std::vector<SelectedIndex>& selected_indices);
 };
 }  // namespace onnxruntime
@@ -497,16 +497,35 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
                                     activation_funcs_.Entries()[0],
                                     activation_funcs_.Entries()[1],
                                     clip_, thread_pool);
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1, recurrent_weights_H_1,
-               output_1, hidden_output_1);
 
     detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_ != 0, Direction::kReverse, bias_2, initial_hidden_2,
                                     activation_funcs_.Entries()[2],
                                     activation_funcs_.Entries()[3],
                                     clip_, thread_pool);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_ZR_2, recurrent_weights_H_2,
-               output_2, hidden_output_2);
+
+    if (rnn::detail::RunDirectionsConcurrently(thread_pool, batch_size, hidden_size_, 3)) {
+      // the input projections use the whole thread pool. the recurrent loops, which are too small per step to be
+      // split across the pool, then run side by side with one direction per thread.
+      fw.ComputeInputProjection(input, sequence_lens_span, num_directions_, input_weights_1, output_1, hidden_output_1);
+      bw.ComputeInputProjection(input, sequence_lens_span, num_directions_, input_weights_2, output_2, hidden_output_2);
+
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, 2, [&](std::ptrdiff_t direction) {
+        if (direction == 0) {
+          fw.ComputeRecurrence(recurrent_weights_ZR_1, recurrent_weights_H_1, nullptr);
+        } else {
+          bw.ComputeRecurrence(recurrent_weights_ZR_2, recurrent_weights_H_2, nullptr);
+        }
+      });
+
+      fw.FinalizeOutputs();
+      bw.FinalizeOutputs();
+    } else {
+      fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1,
+                 recurrent_weights_H_1, output_1, hidden_output_1);
+      bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_ZR_2,
+                 recurrent_weights_H_2, output_2, hidden_output_2);
+    }
   } else {
     detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
                                        linear_before_reset_ != 0, direction_, bias_1, initial_hidden_1,
@@ -640,6 +659,17 @@ void UniDirectionalGru<T>::Compute(gsl::span<const T> inputs_arg,
               outputs, final_hidden_state, zrh);
 }
 
+template <typename T>
+void UniDirectionalGru<T>::ComputeInputProjection(gsl::span<const T> inputs_arg,
+                                                  gsl::span<const int> sequence_lengths_arg,
+                                                  const int num_directions,
+                                                  const GemmWeights<T>& input_weights_s,
+                                                  gsl::span<T>& outputs,
+                                                  gsl::span<T>& final_hidden_state) {
+  ComputeInputProjectionImpl(inputs_arg, sequence_lengths_arg, num_directions, input_weights_s,
+                             outputs, final_hidden_state, outputZRH_);
+}
+
 template <typename T>
 void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
                                        gsl::span<const int> sequence_lengths_arg,
@@ -650,9 +680,20 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
                                        gsl::span<T>& outputs,
                                        gsl::span<T>& final_hidden_state,
                                        gsl::span<T>& zrh) {
-  using span_T_const_iter = typename gsl::span<const T>::iterator;
-  using span_T_iter = typename gsl::span<T>::iterator;
+  ComputeInputProjectionImpl(inputs_arg, sequence_lengths_arg, num_directions, input_weights_s,
+                             outputs, final_hidden_state, zrh);
+  ComputeRecurrence(recurrent_weightsZR_s, recurrent_weightsH_s, ttp_);
+  FinalizeOutputs();
+}
 
+template <typename T>
+void UniDirectionalGru<T>::ComputeInputProjectionImpl(gsl::span<const T> inputs_arg,
+                                                      gsl::span<const int> sequence_lengths_arg,
+                                                      const int num_directions,
+                                                      const GemmWeights<T>& input_weights_s,
+                                                      gsl::span<T>& outputs,
+                                                      gsl::span<T>& final_hidden_state,
+                                                      gsl::span<T>& zrh) {
   // copy inputs_arg as we may change it to point to inputs_reverse_
   gsl::span<const T> inputs = inputs_arg;
   gsl::span<const int> sequence_lengths = sequence_lengths_arg;
@@ -668,19 +709,10 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
     input_weights = input_weights_s.GetUnpackedSpan();
     DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
     DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
-    DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
   }
 
-  gsl::span<const T> recurrent_weightsZR;
-  if (!recurrent_weightsZR_s.is_prepacked_)
-    recurrent_weightsZR = recurrent_weightsZR_s.GetUnpackedSpan();
-
-  gsl::span<const T> recurrent_weightsH;
-  if (!recurrent_weightsH_s.is_prepacked_)
-    recurrent_weightsH = recurrent_weightsH_s.GetUnpackedSpan();
-
-  gsl::span<T> original_outputs = outputs;
-  const bool output_sequence = !outputs.empty();
+  state_.original_outputs = outputs;
+  state_.outputs = outputs;
 
   if (direction_ == kReverse) {
     ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, ttp_);
@@ -688,8 +720,8 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
 
     inputs = inputs_reverse_;
 
-    if (output_sequence) {
-      outputs = outputs_reverse_;
+    if (!outputs.empty()) {
+      state_.outputs = outputs_reverse_;
     }
   }
 
@@ -698,7 +730,6 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
   int32_t min_sequence_length = std::min(seq_length_, *std::min_element(sequence_lengths.begin(),
                                                                         sequence_lengths.end()));
 
-  const int hidden_size_x2 = 2 * hidden_size_;
   const int hidden_size_x3 = 3 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
@@ -740,6 +771,43 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
   if (direction_ == kForward && num_directions == 2)
     output_step_length = 2 * batch_size_ * hidden_size_;
 
+  state_.sequence_lengths = sequence_lengths;
+  state_.final_hidden_state = final_hidden_state;
+  state_.zrh = zrh;
+  state_.num_directions = num_directions;
+  state_.output_step_length = output_step_length;
+  state_.min_sequence_length = min_sequence_length;
+  state_.max_sequence_length = max_sequence_length;
+}
+
+template <typename T>
+void UniDirectionalGru<T>::ComputeRecurrence(const GemmWeights<T>& recurrent_weightsZR_s,
+                                             const GemmWeights<T>& recurrent_weightsH_s,
+                                             onnxruntime::concurrency::ThreadPool* ttp) {
+  using span_T_const_iter = typename gsl::span<const T>::iterator;
+  using span_T_iter = typename gsl::span<T>::iterator;
+
+  const gsl::span<const int> sequence_lengths = state_.sequence_lengths;
+  gsl::span<T> outputs = state_.outputs;
+  gsl::span<T> final_hidden_state = state_.final_hidden_state;
+  gsl::span<T> zrh = state_.zrh;
+  const int output_step_length = state_.output_step_length;
+  const int min_sequence_length = state_.min_sequence_length;
+  const int max_sequence_length = state_.max_sequence_length;
+  const bool output_sequence = !outputs.empty();
+
+  gsl::span<const T> recurrent_weightsZR;
+  if (!recurrent_weightsZR_s.is_prepacked_)
+    recurrent_weightsZR = recurrent_weightsZR_s.GetUnpackedSpan();
+
+  gsl::span<const T> recurrent_weightsH;
+  if (!recurrent_weightsH_s.is_prepacked_)
+    recurrent_weightsH = recurrent_weightsH_s.GetUnpackedSpan();
+
+  const int hidden_size_x2 = 2 * hidden_size_;
+  const int hidden_size_x3 = 3 * hidden_size_;
+  const float alpha = 1.0f;
+
   // convenience end iterators we use in the loops below to detect any bounds issues
   span_T_const_iter batched_bias_WRz_local_end = batched_bias_WRz_.end();
   span_T_const_iter batched_bias_WRr_local_end = batched_bias_WRr_.end();
@@ -777,7 +845,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
     // below.  This lets the runtime system amortize loop entry/exit
     // costs over a series of short kernels, and promotes cache
     // affinity between iterations of successive loops.
-    onnxruntime::concurrency::ThreadPool::ParallelSection ps(ttp_);
+    onnxruntime::concurrency::ThreadPool::ParallelSection ps(ttp);
 
     // for each item in sequence run all calculations
     for (int step = 0; step < max_sequence_length; step++) {
@@ -797,7 +865,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
                     recurrent_weightsZR.begin(), recurrent_weightsZR.end(),
                     hidden_size_, 1.f,  // beta == 1 so we add existing values in zrh
                     zrh.begin() + out_added_offset, zrh.end(),
-                    hidden_size_x3, ttp_);
+                    hidden_size_x3, ttp);
       } else {
         MlasGemm(
             CblasNoTrans,
@@ -807,7 +875,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
             recurrent_weightsZR_s.buffer_,
             1.f,
             &*(zrh.begin() + out_added_offset),
-            static_cast<size_t>(hidden_size_x3), ttp_);
+            static_cast<size_t>(hidden_size_x3), ttp);
       }
 
       DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
@@ -831,7 +899,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
                       use_bias_ ? 1.f : 0.f,  // don't add values in linear_output_ if no bias input
                       linear_output_.begin(),
                       linear_output_.end(),  // pre: Rbh if use_bias_, post:output
-                      hidden_size_, ttp_);
+                      hidden_size_, ttp);
         } else {
           MlasGemm(
               CblasNoTrans,
@@ -841,7 +909,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
               recurrent_weightsH_s.buffer_,
               use_bias_ ? 1.f : 0.f,  // don't add values in linear_output_ if no bias input
               &*linear_output_.begin(),
-              static_cast<size_t>(hidden_size_), ttp_);
+              static_cast<size_t>(hidden_size_), ttp);
         }
 
         DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
@@ -868,6 +936,11 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
           // calculate rt (.) (Ht-1 * (Rh^T) + Rbh) using p_linear_output. write to p_cur_h
           reset_gate_(p_linear_output, p_rt, p_cur_h, hidden_size_, zr_alpha_, zr_beta_);
 
+          // add it to Xt*(Wh^T) while the row is still in cache.
+          // post: p_ht == Xt*(Wh^T) + (rt (.) (Ht-1*(Rh^T) + Rbh))
+          T* p_ht = SafeRawPointer(zrh, out_added_offset + r * hidden_size_x3 + hidden_size_x2, hidden_size_);
+          deepcpu::elementwise_sum1(p_cur_h, p_ht, hidden_size_);
+
         } else {
           const T* p_prev_Ht = SafeRawConstPointer<T>(prev_Ht + r * hidden_size_, prev_Ht_end, hidden_size_);
           T* p_cur_h = SafeRawPointer<T>(cur_h_local + r * hidden_size_, cur_h_local_end, hidden_size_);
@@ -883,22 +956,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
 #endif
       DumpMatrix(label + seqno_str, &*cur_h_local, batch_size_, hidden_size_);
 
-      if (linear_before_reset_) {
-        // input contains rt (.) (Ht-1*(Rh^T) + Rbh)
-        auto input = cur_h_local;
-        // out_H currently contains Xt*(W[zrh]^T).
-        auto out_H = zrh.begin() + out_added_offset;
-
-        for (int r = 0; r < batch_size_; r++) {
-          // skip over the inputs with Z and R weights
-          out_H += hidden_size_x2;
-          for (int h = 0; h < hidden_size_; ++h) {
-            *out_H += *input;
-            ++out_H;
-            ++input;
-          }
-        }
-      } else {
+      if (!linear_before_reset_) {
 #if defined(DUMP_MATRIXES)
         label += " * Rh^T";
 #endif
@@ -914,7 +972,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
                       recurrent_weightsH.begin(), recurrent_weightsH.end(),  // Rh^T
                       hidden_size_, 1.f,                                     // beta == 1 to add Xt*(Wh^T) from out_H
                       out_H, zrh.end(),
-                      hidden_size_x3, ttp_);
+                      hidden_size_x3, ttp);
         } else {
           MlasGemm(
               CblasNoTrans,
@@ -924,7 +982,7 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
               recurrent_weightsH_s.buffer_,
               1.f,  // beta == 1 to add Xt*(Wh^T) from out_H
               &*out_H,
-              static_cast<size_t>(hidden_size_x3), ttp_);
+              static_cast<size_t>(hidden_size_x3), ttp);
         }
       }
 
@@ -1008,6 +1066,16 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
       prev_Ht_end = output_end;
     }
   }  // End parallel section
+}
+
+template <typename T>
+void UniDirectionalGru<T>::FinalizeOutputs() {
+  const gsl::span<const int> sequence_lengths = state_.sequence_lengths;
+  gsl::span<T> outputs = state_.outputs;
+  gsl::span<T> final_hidden_state = state_.final_hidden_state;
+  const int output_step_length = state_.output_step_length;
+  const int max_sequence_length = state_.max_sequence_length;
+  const bool output_sequence = !outputs.empty();
 
   // copy last output to final_hidden_state
   for (int i = 0; i < batch_size_; i++) {
@@ -1040,9 +1108,9 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
   }
 
   if (output_sequence && direction_ == kReverse) {
-    ReverseSequence<T>(outputs, original_outputs,
+    ReverseSequence<T>(outputs, state_.original_outputs,
                        sequence_lengths, seq_length_,
-                       batch_size_, hidden_size_, num_directions, ttp_);
+                       batch_size_, hidden_size_, state_.num_directions, ttp_);
   }
 }
 
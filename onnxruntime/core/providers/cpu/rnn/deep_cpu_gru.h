@@ -123,9 +123,39 @@ class UniDirectionalGru {
                gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
                gsl::span<T>& zrh);
 
+  // The stages of Compute. They are exposed so a bidirectional GRU can compute the input projections of both
+  // directions with the whole thread pool and then run the two recurrent loops concurrently.
+  void ComputeInputProjection(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
+                              const rnn::detail::GemmWeights<T>& input_weights,
+                              gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
+
+  // Runs the recurrent loop using ttp, which may be nullptr when called from a thread pool thread.
+  void ComputeRecurrence(const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
+                         const rnn::detail::GemmWeights<T>& recurrent_weights_H,
+                         onnxruntime::concurrency::ThreadPool* ttp);
+
+  void FinalizeOutputs();
+
   ~UniDirectionalGru() = default;
 
  private:
+  // State shared by the stages of a Compute call.
+  struct ComputeState {
+    gsl::span<const int> sequence_lengths;
+    gsl::span<T> outputs;  // outputs_reverse_ for the reverse direction
+    gsl::span<T> original_outputs;
+    gsl::span<T> final_hidden_state;
+    gsl::span<T> zrh;
+    int num_directions;
+    int output_step_length;
+    int min_sequence_length;
+    int max_sequence_length;
+  };
+
+  void ComputeInputProjectionImpl(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths,
+                                  int num_directions, const rnn::detail::GemmWeights<T>& input_weights,
+                                  gsl::span<T>& outputs, gsl::span<T>& final_hidden_state, gsl::span<T>& zrh);
+
   void ComputeImpl(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
                    const rnn::detail::GemmWeights<T>& input_weights,
                    const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
@@ -193,6 +223,8 @@ class UniDirectionalGru {
 
   onnxruntime::concurrency::ThreadPool* ttp_;
 
+  ComputeState state_;
+
   const bool training_mode_ = false;
 };
 }  // namespace detail
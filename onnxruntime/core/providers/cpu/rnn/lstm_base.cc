@@ -153,10 +153,31 @@ Status LSTMBase::ComputeImpl(OpKernelContext& context,
                                         initial_cell_2, activation_funcs_.Entries()[3], activation_funcs_.Entries()[4],
                                         activation_funcs_.Entries()[5], clip_, thread_pool);
 
-    fw.Compute(input, sequence_lens_span, num_directions_, W_1, R_1, output_1,
-               hidden_output_1, last_cell_1);
-    bw.Compute(input, sequence_lens_span, num_directions_, W_2, R_2, output_2,
-               hidden_output_2, last_cell_2);
+    if (rnn::detail::RunDirectionsConcurrently(thread_pool, batch_size, hidden_size_, 4) &&
+        !fw.IsBatchParallel()) {
+      // the input projections use the whole thread pool. the recurrent loops, which are too small per step to be
+      // split across the pool, then run side by side with one direction per thread.
+      fw.ComputeInputProjection(input, sequence_lens_span, num_directions_, W_1, output_1,
+                                hidden_output_1, last_cell_1);
+      bw.ComputeInputProjection(input, sequence_lens_span, num_directions_, W_2, output_2,
+                                hidden_output_2, last_cell_2);
+
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, 2, [&](std::ptrdiff_t direction) {
+        if (direction == 0) {
+          fw.ComputeRecurrence(R_1, nullptr);
+        } else {
+          bw.ComputeRecurrence(R_2, nullptr);
+        }
+      });
+
+      fw.FinalizeOutputs();
+      bw.FinalizeOutputs();
+    } else {
+      fw.Compute(input, sequence_lens_span, num_directions_, W_1, R_1, output_1,
+                 hidden_output_1, last_cell_1);
+      bw.Compute(input, sequence_lens_span, num_directions_, W_2, R_2, output_2,
+                 hidden_output_2, last_cell_2);
+    }
   } else {
     lstm::UniDirectionalLstm<InputT> fw(alloc, logger, seq_length, batch_size, input_size, hidden_size_, direction_,
                                         input_forget_, bias_1, peephole_weights_1, initial_hidden_1, initial_cell_1,
@@ -103,6 +103,19 @@ Status ValidateCommonRnnInputs(const Tensor& X,
   return Status::OK();
 }  // namespace detail
 
+bool RunDirectionsConcurrently(concurrency::ThreadPool* thread_pool, int batch_size, int hidden_size, int num_gates) {
+  if (concurrency::ThreadPool::DegreeOfParallelism(thread_pool) < 2) {
+    return false;
+  }
+
+  // MLAS uses one thread per 64K multiply-adds of a GEMM, so a step below this size is split across at most
+  // 8 threads and the fork/join cost of every step dominates. Running the directions side by side on
+  // one thread each halves the number of sequential steps instead.
+  constexpr double max_step_complexity = 8.0 * 64 * 1024;
+  const double step_complexity = static_cast<double>(batch_size) * num_gates * hidden_size * hidden_size;
+  return step_complexity <= max_step_complexity;
+}
+
 // map of arg name and whether the alpha and/or beta arguments are required
 static std::unordered_map<std::string, std::pair<bool, bool>> NameToArgUsageMap{
     {"affine", {true, true}},
@@ -79,6 +79,12 @@ Status ValidateCommonRnnInputs(const Tensor& X,
                                int64_t num_directions,
                                int64_t hidden_size);
 
+// Returns true if the recurrent loops of the forward and reverse directions of a bidirectional RNN should run
+// concurrently, one direction per thread, instead of one after the other with each step using the whole pool.
+// This is the case when the per step GEMM ([batch_size, hidden_size] x [hidden_size, num_gates * hidden_size])
+// is too small to be split across more than a few threads.
+bool RunDirectionsConcurrently(concurrency::ThreadPool* thread_pool, int batch_size, int hidden_size, int num_gates);
+
 /// Copy an input array repeatedly to an output array
 /// @param input_begin Beginning of input
 /// @param input_end End of input
@@ -103,10 +103,11 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   }
 
   if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+    bias_WR_ = Allocate(allocator_, 4 * hidden_size_, bias_WR_ptr_);
+    bias_WRi_ = bias_WR_.subspan(0 * hidden_size_, hidden_size_);
+    bias_WRo_ = bias_WR_.subspan(1 * hidden_size_, hidden_size_);
+    bias_WRf_ = bias_WR_.subspan(2 * hidden_size_, hidden_size_);
+    bias_WRc_ = bias_WR_.subspan(3 * hidden_size_, hidden_size_);
   }
 
   if (direction_ == kReverse) {
@@ -222,12 +223,13 @@ void UniDirectionalLstm<T>::AllocateQuantizeBuffers(int max_sequence_length) {
 
 template <typename T>
 template <typename WeightT>
-void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
-                                        const gsl::span<const int>& sequence_lengths_arg, const int num_directions,
-                                        const GemmWeights<WeightT>& input_weights, const GemmWeights<WeightT>& recurrent_weights,
-                                        gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
-                                        gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
-                                        gsl::span<T>& output_iofc) {
+void UniDirectionalLstm<T>::ComputeInputProjectionImpl(const gsl::span<const T>& inputs_arg,
+                                                       const gsl::span<const int>& sequence_lengths_arg,
+                                                       const int num_directions,
+                                                       const GemmWeights<WeightT>& input_weights,
+                                                       gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
+                                                       gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
+                                                       gsl::span<T>& output_iofc) {
   // copy spans (just T* and size, not data in span) as we may change them
   gsl::span<const T> inputs = inputs_arg;
   gsl::span<const int> sequence_lengths = sequence_lengths_arg;
@@ -238,11 +240,6 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
     sequence_lengths = sequence_lengths_;
   }
 
-  // LSTM Layer
-  gsl::span<const T> batched_hidden_state_one_step = batched_hidden0_;
-  gsl::span<T> batched_internal_state_prev_one_step = batched_internal_memory_prev_;
-  gsl::span<T> batched_internal_state_clipped_one_step = batched_internal_memory_clipped_;
-
   int output_step_length = batch_size_ * hidden_size_;
 
   // The bidirectional LSTM wrapper wraps this LSTM class and produces bi-directional output
@@ -255,15 +252,15 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   if (direction_ == kForward && num_directions == 2)
     output_step_length = 2 * batch_size_ * hidden_size_;
 
-  gsl::span<T> original_outputs = outputs;
-  const bool output_sequence = !outputs.empty();
+  state_.original_outputs = outputs;
+  state_.outputs = outputs;
 
   if (direction_ == kReverse) {
     ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, thread_pool_);
     inputs = inputs_reverse_;
 
-    if (output_sequence)
-      outputs = outputs_reverse_;
+    if (!outputs.empty())
+      state_.outputs = outputs_reverse_;
   }
 
   // DumpMatrix("Input", inputs.data(), seq_length_, batch_size_ * input_size_);
@@ -273,26 +270,58 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   int max_sequence_length = *min_max_pair.second;
   int min_sequence_length = std::min(seq_length_, *min_max_pair.first);
 
-  ///**************************LSTM Calculations****************************/
-  float alpha = 1.0f;
-  float beta = 0.0f;  // first call to ComputeGemm zeros out any existing data
+  state_.sequence_lengths = sequence_lengths;
+  state_.final_hidden_state = final_hidden_state;
+  state_.final_cell_state = final_cell_state;
+  state_.all_cell_states = all_cell_states;
+  state_.output_iofc = output_iofc;
+  state_.num_directions = num_directions;
+  state_.output_step_length = output_step_length;
+  state_.min_sequence_length = min_sequence_length;
+  state_.max_sequence_length = max_sequence_length;
 
+  ///**************************LSTM Calculations****************************/
   const int hidden_size_x4 = 4 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
   AllocateQuantizeBuffers<WeightT>(max_sequence_length);
 
   // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha, inputs,
+  // first call to ComputeGemm zeros out any existing data
+  ComputeGemm(total_rows, hidden_size_x4, input_size_, 1.0f, inputs,
               input_weights,
-              beta, output_iofc, hidden_size_x4,
+              0.0f, output_iofc, hidden_size_x4,
               quantized_input_or_a_.data(),
               nullptr,
               thread_pool_);
 
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc.data(), total_rows, hidden_size_x4);
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ComputeRecurrence(const GemmWeights<WeightT>& recurrent_weights,
+                                              concurrency::ThreadPool* thread_pool) {
+  const gsl::span<const int> sequence_lengths = state_.sequence_lengths;
+  gsl::span<T> outputs = state_.outputs;
+  gsl::span<T> final_hidden_state = state_.final_hidden_state;
+  gsl::span<T> final_cell_state = state_.final_cell_state;
+  gsl::span<T> all_cell_states = state_.all_cell_states;
+  gsl::span<T> output_iofc = state_.output_iofc;
+  const int output_step_length = state_.output_step_length;
+  const int min_sequence_length = state_.min_sequence_length;
+  const int max_sequence_length = state_.max_sequence_length;
+  const bool output_sequence = !outputs.empty();
+
+  // LSTM Layer
+  gsl::span<const T> batched_hidden_state_one_step = batched_hidden0_;
+  gsl::span<T> batched_internal_state_prev_one_step = batched_internal_memory_prev_;
+  gsl::span<T> batched_internal_state_clipped_one_step = batched_internal_memory_clipped_;
+
+  const float alpha = 1.0f;
+  const float beta = 1.0f;  // calls to ComputeGemm now add to existing data
 
-  beta = 1.0f;  // calls to ComputeGemm now add to existing data
+  const int hidden_size_x4 = 4 * hidden_size_;
 
   // NOTE: we could refine the bounds checking in the calls below that use these values to instead
   // explicitly check just the range for each iteration, however if it's going to run over
@@ -301,8 +330,11 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   const span_T_iter C_prev_end = batched_internal_state_prev_one_step.end();
   const span_T_iter C_prev_clipped_end = batched_internal_state_clipped_one_step.end();
 
+  // without a thread pool the rows are processed as one block so each step is a single GEMM
+  const bool batch_parallel = batch_parallel_ && thread_pool != nullptr;
+
   int num_seq_to_compute = batch_size_;
-  if (batch_parallel_) {
+  if (batch_parallel) {
     num_seq_to_compute = batch_size_ / num_threads_;
     if (batch_size_ % num_threads_ != 0)
       num_seq_to_compute++;
@@ -400,13 +432,24 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
     }
   };
 
-  if (batch_parallel_) {
+  if (batch_parallel) {
     double gemm_cost = num_seq_to_compute * hidden_size_x4 * hidden_size_;
     double cost = max_sequence_length * (gemm_cost + num_seq_to_compute);
-    ExecuteLambdaInParallel(sequences_calculator, batch_size_, num_seq_to_compute, cost, thread_pool_);
+    ExecuteLambdaInParallel(sequences_calculator, batch_size_, num_seq_to_compute, cost, thread_pool);
   } else {
-    sequences_calculator(0, thread_pool_);
+    sequences_calculator(0, thread_pool);
   }
+}
+
+template <typename T>
+void UniDirectionalLstm<T>::FinalizeOutputs() {
+  const gsl::span<const int> sequence_lengths = state_.sequence_lengths;
+  gsl::span<T> outputs = state_.outputs;
+  gsl::span<T> final_hidden_state = state_.final_hidden_state;
+  gsl::span<T> all_cell_states = state_.all_cell_states;
+  const int output_step_length = state_.output_step_length;
+  const int max_sequence_length = state_.max_sequence_length;
+  const bool output_sequence = !outputs.empty();
 
   for (int i = 0; i < batch_size_; i++) {
     const int seq_len = sequence_lengths[i];
@@ -448,8 +491,22 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   }
 
   if (output_sequence && direction_ == Direction::kReverse)
-    ReverseSequence<T>(outputs, original_outputs, sequence_lengths, seq_length_, batch_size_, hidden_size_,
-                       num_directions, thread_pool_);
+    ReverseSequence<T>(outputs, state_.original_outputs, sequence_lengths, seq_length_, batch_size_, hidden_size_,
+                       state_.num_directions, thread_pool_);
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs,
+                                        const gsl::span<const int>& sequence_lengths, const int num_directions,
+                                        const GemmWeights<WeightT>& input_weights, const GemmWeights<WeightT>& recurrent_weights,
+                                        gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
+                                        gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
+                                        gsl::span<T>& output_iofc) {
+  ComputeInputProjectionImpl(inputs, sequence_lengths, num_directions, input_weights, outputs, final_hidden_state,
+                             final_cell_state, all_cell_states, output_iofc);
+  ComputeRecurrence(recurrent_weights, thread_pool_);
+  FinalizeOutputs();
 }
 
 // #define PREVIOUS_BROKEN_VERSION
@@ -497,6 +554,30 @@ void UniDirectionalLstm<T>::GateComputations(
 
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
+    if (!use_peepholes_ && !input_forget_) {
+      // None of the gates depend on the cell state, so the bias and clip of all four gates and the f() activation
+      // of the i, o and f gates, which are contiguous in the row, are each done in a single pass.
+      const float* pB = use_bias_ ? SafeRawConstPointer<T>(bias_WR_, 0, hidden_size_x4) : nullptr;
+      clip_with_bias_ptr_(clip_, pB, pi, hidden_size_x4);
+      activation_f_.func(pi, 3 * hidden_size_, activation_f_.alpha, activation_f_.beta);
+      activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
+
+      float* pC_cur = pCprev_hidden_size;
+      deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size, pi, pf, pc, pC_cur, hidden_size_);
+
+      if (training_mode_) {
+        float* pC = SafeRawPointer<T>(batched_cell_states + row * hidden_size_ + b * hidden_size_,
+                                      batched_cell_states_end, hidden_size_);
+        std::copy_n(pC_cur, hidden_size_, pC);
+      }
+
+      float* pH =
+          SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end, hidden_size_);
+      float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_, C_prev_clipped_end, hidden_size_);
+      activation_h_.func(pC_cur, pC_prev_clipped, po, pH, hidden_size_, activation_h_.alpha, activation_h_.beta);
+      continue;
+    }
+
     // Input Gate
     if (use_peepholes_) {
       deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_), pi,
@@ -639,6 +720,18 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs, const gsl:
               final_hidden_state, final_cell_state, all_cell_states, iofc);
 }
 
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ComputeInputProjection(const gsl::span<const T>& inputs,
+                                                   const gsl::span<const int>& sequence_lengths,
+                                                   const int num_directions,
+                                                   const GemmWeights<WeightT>& input_weights, gsl::span<T>& outputs,
+                                                   gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state) {
+  gsl::span<T> dummy_all_cell_states = gsl::span<T>();
+  ComputeInputProjectionImpl(inputs, sequence_lengths, num_directions, input_weights, outputs, final_hidden_state,
+                             final_cell_state, dummy_all_cell_states, output_iofc_);
+}
+
 template class UniDirectionalLstm<float>;
 template void UniDirectionalLstm<float>::Compute<float>(
     const gsl::span<const float>& inputs_arg,
@@ -654,5 +747,21 @@ template void UniDirectionalLstm<float>::Compute<uint8_t>(
     gsl::span<float>& outputs,
     gsl::span<float>& final_hidden_state, gsl::span<float>& final_cell_state);
 
+template void UniDirectionalLstm<float>::ComputeInputProjection<float>(
+    const gsl::span<const float>& inputs, const gsl::span<const int>& sequence_lengths, const int num_directions,
+    const GemmWeights<float>& input_weights, gsl::span<float>& outputs,
+    gsl::span<float>& final_hidden_state, gsl::span<float>& final_cell_state);
+
+template void UniDirectionalLstm<float>::ComputeInputProjection<uint8_t>(
+    const gsl::span<const float>& inputs, const gsl::span<const int>& sequence_lengths, const int num_directions,
+    const GemmWeights<uint8_t>& input_weights, gsl::span<float>& outputs,
+    gsl::span<float>& final_hidden_state, gsl::span<float>& final_cell_state);
+
+template void UniDirectionalLstm<float>::ComputeRecurrence<float>(
+    const GemmWeights<float>& recurrent_weights, concurrency::ThreadPool* thread_pool);
+
+template void UniDirectionalLstm<float>::ComputeRecurrence<uint8_t>(
+    const GemmWeights<uint8_t>& recurrent_weights, concurrency::ThreadPool* thread_pool);
+
 }  // namespace lstm
 }  // namespace onnxruntime
@@ -47,11 +47,41 @@ class UniDirectionalLstm {
                gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
                gsl::span<T>& iofc);
 
+  // The stages of Compute. They are exposed so a bidirectional LSTM can compute the input projections of both
+  // directions with the whole thread pool and then run the two recurrent loops concurrently.
+  template <typename WeightT>
+  void ComputeInputProjection(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
+                              int num_directions, const GemmWeights<WeightT>& input_weights, gsl::span<T>& outputs,
+                              gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state);
+
+  // Runs the recurrent loop using thread_pool, which may be nullptr when called from a thread pool thread.
+  template <typename WeightT>
+  void ComputeRecurrence(const GemmWeights<WeightT>& recurrent_weights, concurrency::ThreadPool* thread_pool);
+
+  void FinalizeOutputs();
+
+  bool IsBatchParallel() const { return batch_parallel_; }
+
   ~UniDirectionalLstm() = default;
 
  private:
   using span_T_iter = typename gsl::span<T>::iterator;
 
+  // State shared by the stages of a Compute call.
+  struct ComputeState {
+    gsl::span<const int> sequence_lengths;
+    gsl::span<T> outputs;  // outputs_reverse_ for the reverse direction
+    gsl::span<T> original_outputs;
+    gsl::span<T> final_hidden_state;
+    gsl::span<T> final_cell_state;
+    gsl::span<T> all_cell_states;
+    gsl::span<T> output_iofc;
+    int num_directions;
+    int output_step_length;
+    int min_sequence_length;
+    int max_sequence_length;
+  };
+
   void SetNumThreads();
 
   void GateComputations(span_T_iter& out, span_T_iter& out_end, span_T_iter& C_prev,
@@ -68,6 +98,13 @@ class UniDirectionalLstm {
   void LoadPeepholeWeights(const gsl::span<const T>& peephole_weights);
   void LoadBias(const gsl::span<const T>& WbRb_values);
 
+  template <typename WeightT>
+  void ComputeInputProjectionImpl(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
+                                  int num_directions, const GemmWeights<WeightT>& input_weights,
+                                  gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
+                                  gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
+                                  gsl::span<T>& output_iofc);
+
   template <typename WeightT>
   void ComputeImpl(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
                    const GemmWeights<WeightT>& input_weights, const GemmWeights<WeightT>& recurrent_weights, gsl::span<T>& outputs,
@@ -106,9 +143,12 @@ class UniDirectionalLstm {
   gsl::span<T> internal_memory_prev_, batched_internal_memory_prev_;
   gsl::span<T> batched_internal_memory_clipped_;
 
-  IAllocatorUniquePtr<T> bias_WRi_ptr_, bias_WRf_ptr_, bias_WRo_ptr_, bias_WRc_ptr_;
+  // Wb + Rb for the i, o, f and c gates stored back to back, in the same order as the gates in output_iofc_,
+  // so the bias of all the gates of a row is added in a single pass.
+  IAllocatorUniquePtr<T> bias_WR_ptr_;
   IAllocatorUniquePtr<T> peephole_i_ptr_, peephole_f_ptr_, peephole_o_ptr_;
   IAllocatorUniquePtr<T> inputs_reverse_ptr_, outputs_reverse_ptr_;
+  gsl::span<T> bias_WR_;
   gsl::span<T> bias_WRi_, bias_WRf_, bias_WRo_, bias_WRc_;
   gsl::span<T> inputs_reverse_, outputs_reverse_;
 
@@ -140,6 +180,8 @@ class UniDirectionalLstm {
   IAllocatorUniquePtr<int32_t> quantized_C_buffer_ptr_;
   gsl::span<int32_t> quantized_C_buffer_;
 
+  ComputeState state_;
+
   const bool training_mode_ = false;
 };
 
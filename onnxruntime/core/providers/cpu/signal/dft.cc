@@ -3,10 +3,13 @@
 
 #include "core/providers/cpu/signal/dft.h"
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <type_traits>
 #include <vector>
 #include <core/common/safeint.h>
 
@@ -35,7 +38,6 @@ ONNX_CPU_OPERATOR_KERNEL(DFT, 20,
 
 ONNX_CPU_OPERATOR_KERNEL(STFT, 17,
                          KernelDefBuilder()
-                             .MayInplace(0, 0)
                              .TypeConstraint("T1", BuildKernelDefConstraints<float, double>())
                              .TypeConstraint("T2", BuildKernelDefConstraints<int32_t, int64_t>()),
                          STFT);
@@ -85,239 +87,276 @@ static inline T bit_reverse(T num, unsigned significant_bits) {
 }
 
 template <typename T>
-static T compute_angular_velocity(size_t number_of_samples, bool inverse) {
-  // Calculate fundamental angular velocity
-  static constexpr T pi = static_cast<T>(M_PI);
-  static constexpr T tau = 2 * pi;
-  T inverse_switch = inverse ? 1.f : -1.f;
-  T angular_velocity = inverse_switch * tau / number_of_samples;
-  return angular_velocity;
+T next_power_of_2(T in) {
+  in--;
+  T out = 1;
+  while (out <= in) {
+    out <<= 1;
+  }
+  return out;
 }
 
+namespace signal {
+
 template <typename T>
-static std::complex<T> compute_exponential(size_t index, const T angular_velocity) {
-  const T angle = static_cast<T>(index) * angular_velocity;
-  return std::complex<T>(cos(angle), sin(angle));
+struct DftPlan {
+  size_t length = 0;
+  bool inverse = false;
+  // Length of the radix-2 transform: the DFT length when it is a power of 2, otherwise the length of the
+  // Bluestein convolution.
+  size_t fft_length = 0;
+  // Bit reversal permutations of the radix-2 transform and of the half length transform used for real input.
+  std::vector<size_t> bit_reversed;
+  std::vector<size_t> half_bit_reversed;
+  // Twiddle factors of all the butterfly stages. The stage merging transforms of size h uses exp(-+i * pi * k / h)
+  // for k < h, stored contiguously at offset h - 1, so a plan also serves every smaller power of 2.
+  std::vector<std::complex<T>> twiddles;
+  // Bluestein chirp exp(-+i * pi * n^2 / length) and the transform of its conjugate scaled by 1 / fft_length.
+  std::vector<std::complex<T>> chirp;
+  std::vector<std::complex<T>> b_fft;
+
+  bool IsPowerOf2() const { return fft_length == length; }
+};
+
+}  // namespace signal
+
+static std::vector<size_t> bit_reversal_permutation(size_t size) {
+  const unsigned significant_bits = static_cast<unsigned>(log2(size));
+  std::vector<size_t> permutation(size);
+  for (size_t i = 0; i < size; i++) {
+    permutation[i] = bit_reverse(i, significant_bits);
+  }
+  return permutation;
 }
 
-template <typename T, typename U>
-static Status fft_radix2(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, size_t X_offset, size_t X_stride,
-                         size_t Y_offset, size_t Y_stride, int64_t axis, size_t dft_length, const Tensor* window,
-                         bool is_onesided, bool inverse, InlinedVector<std::complex<T>>& V,
-                         InlinedVector<std::complex<T>>& temp_output) {
-  // Get shape and significant bits
-  const auto& X_shape = X->Shape();
-  size_t number_of_samples = static_cast<size_t>(X_shape[onnxruntime::narrow<size_t>(axis)]);
-  unsigned significant_bits = static_cast<unsigned>(log2(dft_length));
+template <typename T>
+static std::vector<std::complex<T>> stage_twiddles(size_t size, bool inverse) {
+  // Computed in double so float plans do not accumulate the error of the angles.
+  const double direction = inverse ? 1. : -1.;
+  std::vector<std::complex<T>> twiddles(size > 1 ? size - 1 : 0);
+  for (size_t h = 1; h < size; h <<= 1) {
+    for (size_t k = 0; k < h; k++) {
+      const double angle = direction * M_PI * static_cast<double>(k) / static_cast<double>(h);
+      twiddles[h - 1 + k] = std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+    }
+  }
+  return twiddles;
+}
 
-  // Get data
-  auto* X_data = const_cast<U*>(reinterpret_cast<const U*>(X->DataRaw())) + X_offset;
-  // Get window
-  U* window_data = nullptr;
-  if (window) {
-    window_data = const_cast<U*>(reinterpret_cast<const U*>(window->DataRaw()));
+// std::complex multiplication checks for NaN and infinities, which prevents the loops from being vectorized.
+template <typename T>
+static inline std::complex<T> complex_multiply(const std::complex<T>& a, const std::complex<T>& b) {
+  return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+// Runs the butterflies of an in-place radix-2 decimation in time FFT of `size` values stored in bit reversed order.
+// The loops work on the interleaved real and imaginary parts and are contiguous in k so they can be vectorized.
+template <typename T>
+static void radix2_butterflies(std::complex<T>* data, size_t size, const std::complex<T>* twiddles) {
+  T* values = reinterpret_cast<T*>(data);
+
+  // The twiddle factor of the first stage is 1.
+  for (size_t j = 0; j + 1 < size; j += 2) {
+    T* even = values + 2 * j;
+    const T even_real = even[0];
+    const T even_imag = even[1];
+    even[0] = even_real + even[2];
+    even[1] = even_imag + even[3];
+    even[2] = even_real - even[2];
+    even[3] = even_imag - even[3];
   }
 
-  size_t Y_data_stride = 1;
-  std::complex<T>* Y_data;
-  if (is_onesided) {
-    if (temp_output.size() != dft_length) {
-      temp_output.resize(dft_length);
+  for (size_t h = 2; h < size; h <<= 1) {
+    const T* w = reinterpret_cast<const T*>(twiddles + (h - 1));
+    for (size_t j = 0; j < size; j += 2 * h) {
+      T* even = values + 2 * j;
+      T* odd = even + 2 * h;
+      for (size_t k = 0; k < 2 * h; k += 2) {
+        const T t_real = odd[k] * w[k] - odd[k + 1] * w[k + 1];
+        const T t_imag = odd[k] * w[k + 1] + odd[k + 1] * w[k];
+        const T even_real = even[k];
+        const T even_imag = even[k + 1];
+        even[k] = even_real + t_real;
+        even[k + 1] = even_imag + t_imag;
+        odd[k] = even_real - t_real;
+        odd[k + 1] = even_imag - t_imag;
+      }
     }
-    Y_data = temp_output.data();
-  } else {
-    Y_data = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw()) + Y_offset;
-    Y_data_stride = Y_stride;
   }
+}
 
-  auto angular_velocity = compute_angular_velocity<T>(dft_length, inverse);
-
-  // Create vandermonde matrix V ordered with the bit-reversed permutation
-  if (V.size() != dft_length) {
-    V.resize(dft_length);
-    for (size_t i = 0; i < dft_length; i++) {
-      size_t bit_reversed_index = bit_reverse(i, significant_bits);
-      V[bit_reversed_index] = compute_exponential(i, angular_velocity);
+template <typename T>
+static std::shared_ptr<const signal::DftPlan<T>> create_dft_plan(size_t dft_length, bool inverse) {
+  auto plan = std::make_shared<signal::DftPlan<T>>();
+  plan->length = dft_length;
+  plan->inverse = inverse;
+
+  if (is_power_of_2(dft_length)) {
+    plan->fft_length = dft_length;
+    plan->bit_reversed = bit_reversal_permutation(dft_length);
+    if (dft_length >= 2) {
+      plan->half_bit_reversed = bit_reversal_permutation(dft_length >> 1);
     }
+    plan->twiddles = stage_twiddles<T>(dft_length, inverse);
+    return plan;
   }
 
-  for (size_t i = 0; i < dft_length; i++) {
-    size_t bit_reversed_index = bit_reverse(i, significant_bits);
-    auto x = (bit_reversed_index < number_of_samples) ? *(X_data + bit_reversed_index * X_stride) : 0;
-    auto window_element = window_data ? *(window_data + bit_reversed_index) : 1;
-    *(Y_data + i * Y_data_stride) = std::complex<T>(1, 0) * x * window_element;
+  // Bluestein's algorithm computes the DFT as a circular convolution of radix-2 transforms of length M >= 2N - 1.
+  const size_t N = dft_length;
+  const size_t M = next_power_of_2(2 * N - 1);
+  plan->fft_length = M;
+  plan->bit_reversed = bit_reversal_permutation(M);
+  plan->twiddles = stage_twiddles<T>(M, false);
+
+  const double direction = inverse ? 1. : -1.;
+  plan->chirp.resize(N);
+  for (size_t n = 0; n < N; n++) {
+    // n^2 is reduced modulo 2N to keep the angle exact for long signals.
+    const double angle = direction * M_PI * static_cast<double>((n * n) % (2 * N)) / static_cast<double>(N);
+    plan->chirp[n] = std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
   }
 
-  // Run fft_radix2
-  unsigned current_significant_bits = 0;
-  for (size_t i = 2; i <= dft_length; i <<= 1) {
-    size_t midpoint = i >> 1;
-    current_significant_bits++;
-
-    for (size_t k = 0; k < midpoint; k++) {
-      auto first_idx = bit_reverse(k, current_significant_bits);
-      auto second_idx = bit_reverse(midpoint + k, current_significant_bits);
-      for (size_t j = 0; j < dft_length; j += i) {
-        auto even_index = k + j;
-        auto odd_index = k + j + midpoint;
-        std::complex<T>* even = (Y_data + even_index * Y_data_stride);
-        std::complex<T>* odd = (Y_data + odd_index * Y_data_stride);
-        std::complex<T> first = *even + (V[first_idx] * *odd);
-        std::complex<T> second = *even + (V[second_idx] * *odd);
-        *even = first;
-        *odd = second;
-      }
-    }
+  // b is the conjugated chirp, made symmetric around 0 for the circular convolution.
+  std::vector<std::complex<T>> b(M);
+  for (size_t n = 0; n < N; n++) {
+    b[n] = std::conj(plan->chirp[n]);
+  }
+  for (size_t n = 1; n < N; n++) {
+    b[M - n] = b[n];
   }
 
-  // Scale the output if inverse
-  if (inverse) {
-    for (size_t i = 0; i < dft_length; i++) {
-      std::complex<T>& val = *(Y_data + i * Y_data_stride);
-      val /= static_cast<T>(dft_length);
-    }
+  plan->b_fft.resize(M);
+  for (size_t i = 0; i < M; i++) {
+    plan->b_fft[i] = b[plan->bit_reversed[i]];
   }
+  radix2_butterflies(plan->b_fft.data(), M, plan->twiddles.data());
 
-  if (is_onesided) {
-    const size_t output_size = (dft_length >> 1) + 1;
-    auto destination = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw()) + Y_offset;
-    for (size_t i = 0; i < output_size; i++) {
-      *(destination + Y_stride * i) = *(Y_data + i * Y_data_stride);
-    }
+  // Fold the scaling of the inverse transform of the convolution.
+  const T inverse_m = static_cast<T>(1) / static_cast<T>(M);
+  for (auto& value : plan->b_fft) {
+    value *= inverse_m;
   }
 
-  return Status::OK();
+  return plan;
 }
 
+namespace signal {
+
 template <typename T>
-T next_power_of_2(T in) {
-  in--;
-  T out = 1;
-  while (out <= in) {
-    out <<= 1;
+std::shared_ptr<const DftPlan<T>> DftPlanCache<T>::Get(size_t dft_length, bool inverse) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (plan_ == nullptr || plan_->length != dft_length || plan_->inverse != inverse) {
+    plan_ = create_dft_plan<T>(dft_length, inverse);
   }
-  return out;
+  return plan_;
 }
 
+}  // namespace signal
+
+template <typename T>
+static double dft_compute_cost(const signal::DftPlan<T>& plan) {
+  const double size = static_cast<double>(plan.fft_length);
+  const double fft_cost = 5.0 * size * std::max(1.0, std::log2(size));
+  // Bluestein runs a forward and an inverse transform plus the chirp multiplications.
+  return plan.IsPowerOf2() ? fft_cost : 2.0 * fft_cost + 8.0 * size;
+}
+
+// Computes one transform of `number_of_samples` input values spaced by `X_stride`, zero padded or truncated to the
+// plan length and multiplied by the optional window, and writes the first `output_size` values spaced by `Y_stride`.
 template <typename T, typename U>
-static Status dft_bluestein_z_chirp(
-    OpKernelContext* ctx, const Tensor* X, Tensor* Y, Tensor& b_fft, Tensor& chirp, size_t X_offset, size_t X_stride, size_t Y_offset, size_t Y_stride,
-    int64_t axis, size_t dft_length, const Tensor* window, bool inverse, InlinedVector<std::complex<T>>& V,
-    InlinedVector<std::complex<T>>& temp_output) {
-  static constexpr T pi = static_cast<T>(M_PI);
-
-  AllocatorPtr alloc;
-  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
-
-  size_t N = static_cast<size_t>(dft_length);
-  size_t M = next_power_of_2(2 * N - 1);
-  auto dft_input_shape = onnxruntime::TensorShape({1, (int64_t)M, 2});
-  T scale = inverse ? 1.f / N : 1.f;
-  T direction = inverse ? 1.f : -1.f;
-
-  bool should_recreate_b_fft = b_fft.Shape().Size() != dft_input_shape.Size();
-  bool should_recreate_chirp = chirp.Shape().Size() != dft_input_shape.Size();
-  bool should_recreate = should_recreate_b_fft || should_recreate_chirp;
-  if (should_recreate) {
-    auto b = onnxruntime::Tensor(X->DataType(), dft_input_shape, alloc);
-    b_fft = onnxruntime::Tensor(Y->DataType(), dft_input_shape, alloc);
-    chirp = onnxruntime::Tensor(X->DataType(), dft_input_shape, alloc);
-
-    std::complex<T>* b_data = reinterpret_cast<std::complex<T>*>(b.MutableDataRaw());
-    std::complex<T>* b_fft_data = reinterpret_cast<std::complex<T>*>(b_fft.MutableDataRaw());
-    std::complex<T>* chirp_data = reinterpret_cast<std::complex<T>*>(chirp.MutableDataRaw());
-    memset(reinterpret_cast<void*>(b_data), 0, b.SizeInBytes());
-    memset(reinterpret_cast<void*>(b_fft_data), 0, b_fft.SizeInBytes());
-    memset(reinterpret_cast<void*>(chirp_data), 0, chirp.SizeInBytes());
-
-    for (size_t n = 0; n < N; n++) {
-      std::complex<T>& chirp_n = *(chirp_data + n);
-      // chirp
-      auto exponent = direction * pi * n * n / N;
-      chirp_n = std::complex<T>(cos(exponent), sin(exponent));
-
-      // b
-      std::complex<T>& b_n = *(b_data + n);
-      b_n = std::conj(chirp_n);
+static void dft_one(const signal::DftPlan<T>& plan, const U* X_data, size_t X_stride, size_t number_of_samples,
+                    const T* window_data, std::complex<T>* Y_data, size_t Y_stride, size_t output_size,
+                    std::vector<std::complex<T>>& scratch, std::vector<std::complex<T>>& scratch2) {
+  const size_t N = plan.length;
+  const size_t valid_samples = std::min(number_of_samples, N);
+  const T scale = plan.inverse ? static_cast<T>(1) / static_cast<T>(N) : static_cast<T>(1);
+  auto sample = [&](size_t n) -> std::complex<T> {
+    if (n >= valid_samples) {
+      return std::complex<T>();
     }
-
-    for (size_t n = M - N + 1; n < M; n++) {
-      std::complex<T>& b_n = *(b_data + n);
-      std::complex<T>& b_m_minus_n = *(b_data + M - n);
-      b_n = b_m_minus_n;
+    const std::complex<T> x(X_data[n * X_stride]);
+    return window_data ? x * window_data[n] : x;
+  };
+
+  if (!plan.IsPowerOf2()) {
+    const size_t M = plan.fft_length;
+    scratch.resize(M);
+    scratch2.resize(M);
+
+    // A = FFT(x * chirp)
+    for (size_t i = 0; i < M; i++) {
+      const size_t n = plan.bit_reversed[i];
+      scratch[i] = n < N ? complex_multiply(sample(n), plan.chirp[n]) : std::complex<T>();
     }
+    radix2_butterflies(scratch.data(), M, plan.twiddles.data());
 
-    // Forward FFT radix2 for the "b" signal
-    // This will be cached and reused!
-    ORT_RETURN_IF_ERROR((fft_radix2<T, std::complex<T>>(ctx, &b, &b_fft, 0, 1, 0, 1, 1, M, nullptr,
-                                                        false, false, V, temp_output)));
-  }
+    // The inverse transform of A * B is the conjugate of the forward transform of its conjugate.
+    for (size_t i = 0; i < M; i++) {
+      const size_t n = plan.bit_reversed[i];
+      scratch2[i] = std::conj(complex_multiply(scratch[n], plan.b_fft[n]));
+    }
+    radix2_butterflies(scratch2.data(), M, plan.twiddles.data());
 
-  // Get data
-  auto* X_data = const_cast<U*>(reinterpret_cast<const U*>(X->DataRaw())) + X_offset;
-  auto* Y_data = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw()) + Y_offset;
-  U* window_data = nullptr;
-  if (window) {
-    window_data = const_cast<U*>(reinterpret_cast<const U*>(window->DataRaw()));
+    for (size_t k = 0; k < output_size; k++) {
+      Y_data[k * Y_stride] = complex_multiply(std::conj(scratch2[k]), plan.chirp[k]) * scale;
+    }
+    return;
   }
 
-  auto a = onnxruntime::Tensor(X->DataType(), dft_input_shape, alloc);
-  auto a_fft = onnxruntime::Tensor(Y->DataType(), dft_input_shape, alloc);
-  std::complex<T>* a_data = reinterpret_cast<std::complex<T>*>(a.MutableDataRaw());
-  std::complex<T>* a_fft_data = reinterpret_cast<std::complex<T>*>(a_fft.MutableDataRaw());
-  std::complex<T>* b_fft_data = reinterpret_cast<std::complex<T>*>(b_fft.MutableDataRaw());
-  std::complex<T>* chirp_data = reinterpret_cast<std::complex<T>*>(chirp.MutableDataRaw());
-  memset(reinterpret_cast<void*>(a_data), 0, a.SizeInBytes());
+  if constexpr (std::is_same_v<U, T>) {
+    if (N >= 2) {
+      // A real signal of length N is transformed as a complex signal of length N / 2 made of its even and odd
+      // samples, the two interleaved transforms are then split using the conjugate symmetry of real transforms.
+      const size_t half = N >> 1;
+      scratch.resize(half);
+      for (size_t i = 0; i < half; i++) {
+        const size_t m = plan.half_bit_reversed[i];
+        scratch[i] = std::complex<T>(sample(2 * m).real(), sample(2 * m + 1).real());
+      }
+      radix2_butterflies(scratch.data(), half, plan.twiddles.data());
+
+      // The last stage of the plan holds exp(-+2i * pi * k / N) for k < N / 2.
+      const std::complex<T>* w = plan.twiddles.data() + (half - 1);
+      const size_t unique_size = std::min(output_size, half + 1);
+      for (size_t k = 0; k < unique_size; k++) {
+        std::complex<T> value;
+        if (k == 0 || k == half) {
+          const T even = scratch[0].real();
+          const T odd = scratch[0].imag();
+          value = std::complex<T>(k == 0 ? even + odd : even - odd, 0);
+        } else {
+          const std::complex<T> z = scratch[k];
+          const std::complex<T> z_conj = std::conj(scratch[half - k]);
+          const std::complex<T> even = (z + z_conj) * static_cast<T>(0.5);
+          const std::complex<T> difference = z - z_conj;
+          const std::complex<T> odd(difference.imag() * static_cast<T>(0.5), -difference.real() * static_cast<T>(0.5));
+          value = even + complex_multiply(w[k], odd);
+        }
+        Y_data[k * Y_stride] = value * scale;
+      }
 
-  const auto& X_shape = X->Shape();
-  size_t number_of_samples = static_cast<size_t>(X_shape[onnxruntime::narrow<size_t>(axis)]);
-
-  // Prepare "a" signal
-  for (size_t n = 0; n < number_of_samples; n++) {
-    std::complex<T>& a_n = *(a_data + n);
-    std::complex<T>& chirp_n = *(chirp_data + n);
-    auto window_n = window_data ? *(window_data + n) : 1;
-    a_n = *(X_data + n * X_stride);  // input
-    a_n *= window_n;
-    a_n *= chirp_n;
+      // The remaining values of the transform of a real signal are the conjugates of the first ones.
+      for (size_t k = unique_size; k < output_size; k++) {
+        Y_data[k * Y_stride] = std::conj(Y_data[(N - k) * Y_stride]);
+      }
+      return;
+    }
   }
 
-  // Forward FFT radix2 for the "a" signal
-  ORT_RETURN_IF_ERROR((fft_radix2<T, std::complex<T>>(ctx, &a, &a_fft, 0, 1, 0, 1, 1, M, nullptr,
-                                                      false, false, V, temp_output)));
-
-  for (size_t i = 0; i < M; i++) {
-    std::complex<T>& a_i = *(a_fft_data + i);
-    std::complex<T>& b_i = *(b_fft_data + i);
-    a_i *= b_i;
+  scratch.resize(N);
+  for (size_t i = 0; i < N; i++) {
+    scratch[i] = sample(plan.bit_reversed[i]);
   }
+  radix2_butterflies(scratch.data(), N, plan.twiddles.data());
 
-  // Inverse FFT radix2 for the "a" signal
-  ORT_RETURN_IF_ERROR((fft_radix2<T, std::complex<T>>(ctx, &a_fft, &a, 0, 1, 0, 1, 1, M, nullptr,
-                                                      false, true, V, temp_output)));
-  const auto& Y_shape = Y->Shape();
-  size_t dft_output_size = static_cast<size_t>(Y_shape[onnxruntime::narrow<size_t>(axis)]);
-
-  for (size_t i = 0; i < dft_output_size; i++) {
-    std::complex<T>& chirp_i = *(chirp_data + i);
-    std::complex<T>& out = *(Y_data + i * Y_stride);
-    std::complex<T>& c_i = *(a_data + i);
-    if (i > 0) {
-      // The inverse fft is computed using the same cached vandermonde matrix (V) created by the
-      // forward fft. This reversal causes the output to be reversed as well.
-      // Therefore we undo the reversal when writing the output back out.
-      c_i = *(a_data + M - i);
-    }
-    out = c_i * chirp_i * scale;
+  for (size_t k = 0; k < output_size; k++) {
+    Y_data[k * Y_stride] = scratch[k] * scale;
   }
-  return Status::OK();
 }
 
 template <typename T, typename U>
-static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X, Tensor* Y, Tensor& b_fft, Tensor& chirp,
-                                         int64_t axis, int64_t dft_length, const Tensor* window, bool is_onesided, bool inverse,
-                                         InlinedVector<std::complex<T>>& V,
-                                         InlinedVector<std::complex<T>>& temp_output) {
+static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X, Tensor* Y, int64_t axis,
+                                         int64_t dft_length, bool inverse, signal::DftPlanCache<T>& plans) {
   // Get shape
   const auto& X_shape = X->Shape();
   const auto& Y_shape = Y->Shape();
@@ -332,49 +371,61 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
     batch_and_signal_rank -= 1;
   }
 
-  // Calculate x/y offsets/strides
-  for (size_t i = 0; i < total_dfts; i++) {
-    size_t X_offset = 0;
-    size_t X_stride = onnxruntime::narrow<size_t>(X_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / complex_input_factor);
-    size_t cumulative_packed_stride = total_dfts;
-    size_t temp = i;
-    for (size_t r = 0; r < batch_and_signal_rank; r++) {
-      if (r == static_cast<size_t>(axis)) {
-        continue;
-      }
-      cumulative_packed_stride /= onnxruntime::narrow<size_t>(X_shape[r]);
-      auto index = temp / cumulative_packed_stride;
-      temp -= (index * cumulative_packed_stride);
-      X_offset += index * SafeInt<size_t>(X_shape.SizeFromDimension(r + 1)) / complex_input_factor;
-    }
-
-    size_t Y_offset = 0;
-    size_t Y_stride = onnxruntime::narrow<size_t>(Y_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / 2);
-    cumulative_packed_stride = total_dfts;
-    temp = i;
-    for (size_t r = 0; r < batch_and_signal_rank; r++) {
-      if (r == static_cast<size_t>(axis)) {
-        continue;
-      }
-      cumulative_packed_stride /= onnxruntime::narrow<size_t>(X_shape[r]);
-      auto index = temp / cumulative_packed_stride;
-      temp -= (index * cumulative_packed_stride);
-      Y_offset += index * SafeInt<size_t>(Y_shape.SizeFromDimension(r + 1)) / 2;
-    }
-
-    if (is_power_of_2(onnxruntime::narrow<size_t>(dft_length))) {
-      ORT_RETURN_IF_ERROR((fft_radix2<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window,
-                                            is_onesided, inverse, V, temp_output)));
-    } else {
-      ORT_RETURN_IF_ERROR(
-          (dft_bluestein_z_chirp<T, U>(ctx, X, Y, b_fft, chirp, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window, inverse, V, temp_output)));
-    }
-  }
+  const auto plan = plans.Get(onnxruntime::narrow<size_t>(dft_length), inverse);
+  const size_t number_of_samples = onnxruntime::narrow<size_t>(X_shape[onnxruntime::narrow<size_t>(axis)]);
+  const size_t output_size = onnxruntime::narrow<size_t>(Y_shape[onnxruntime::narrow<size_t>(axis)]);
+  const size_t X_stride = onnxruntime::narrow<size_t>(X_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / complex_input_factor);
+  const size_t Y_stride = onnxruntime::narrow<size_t>(Y_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / 2);
+  const U* X_data = reinterpret_cast<const U*>(X->DataRaw());
+  std::complex<T>* Y_data = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw());
+
+  // The transforms along the axis are independent, run them in parallel with per thread scratch buffers.
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(total_dfts),
+      TensorOpCost{static_cast<double>(number_of_samples * sizeof(U)),
+                   static_cast<double>(output_size * sizeof(std::complex<T>)), dft_compute_cost(*plan)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<std::complex<T>> scratch;
+        std::vector<std::complex<T>> scratch2;
+        for (size_t i = static_cast<size_t>(first); i < static_cast<size_t>(last); i++) {
+          // Calculate x/y offsets
+          size_t X_offset = 0;
+          size_t cumulative_packed_stride = total_dfts;
+          size_t temp = i;
+          for (size_t r = 0; r < batch_and_signal_rank; r++) {
+            if (r == static_cast<size_t>(axis)) {
+              continue;
+            }
+            cumulative_packed_stride /= onnxruntime::narrow<size_t>(X_shape[r]);
+            auto index = temp / cumulative_packed_stride;
+            temp -= (index * cumulative_packed_stride);
+            X_offset += index * SafeInt<size_t>(X_shape.SizeFromDimension(r + 1)) / complex_input_factor;
+          }
+
+          size_t Y_offset = 0;
+          cumulative_packed_stride = total_dfts;
+          temp = i;
+          for (size_t r = 0; r < batch_and_signal_rank; r++) {
+            if (r == static_cast<size_t>(axis)) {
+              continue;
+            }
+            cumulative_packed_stride /= onnxruntime::narrow<size_t>(X_shape[r]);
+            auto index = temp / cumulative_packed_stride;
+            temp -= (index * cumulative_packed_stride);
+            Y_offset += index * SafeInt<size_t>(Y_shape.SizeFromDimension(r + 1)) / 2;
+          }
+
+          dft_one<T, U>(*plan, X_data + X_offset, X_stride, number_of_samples, nullptr, Y_data + Y_offset, Y_stride,
+                        output_size, scratch, scratch2);
+        }
+      });
 
   return Status::OK();
 }
 
-static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, bool is_onesided, bool inverse) {
+static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, bool is_onesided, bool inverse,
+                                         signal::DftPlanCache<float>& float_plans,
+                                         signal::DftPlanCache<double>& double_plans) {
   // Get input shape
   const auto* X = ctx->Input<Tensor>(0);
   const auto* dft_length = ctx->Input<Tensor>(1);
@@ -408,17 +459,14 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, boo
   // Get data type
   auto data_type = X->DataType();
 
-  Tensor b_fft, chirp;
   auto element_size = data_type->Size();
   if (element_size == sizeof(float)) {
-    InlinedVector<std::complex<float>> V;
-    InlinedVector<std::complex<float>> temp_output;
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, float>(ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr,
-                                                                    is_onesided, inverse, V, temp_output)));
+      ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, float>(ctx, X, Y, axis, number_of_samples, inverse,
+                                                                    float_plans)));
     } else if (is_complex_valued) {
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, std::complex<float>>(
-          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output)));
+      ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, std::complex<float>>(ctx, X, Y, axis, number_of_samples,
+                                                                                  inverse, float_plans)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimension must be the batch dimension and its second "
@@ -427,14 +475,12 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, boo
           data_type);
     }
   } else if (element_size == sizeof(double)) {
-    InlinedVector<std::complex<double>> V;
-    InlinedVector<std::complex<double>> temp_output;
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, double>(ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr,
-                                                                      is_onesided, inverse, V, temp_output)));
+      ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, double>(ctx, X, Y, axis, number_of_samples, inverse,
+                                                                      double_plans)));
     } else if (is_complex_valued) {
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, std::complex<double>>(
-          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output)));
+      ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, std::complex<double>>(ctx, X, Y, axis, number_of_samples,
+                                                                                    inverse, double_plans)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimension must be the batch dimension and its second "
@@ -456,12 +502,12 @@ Status DFT::Compute(OpKernelContext* ctx) const {
     axis = axes_tensor->Data<int64_t>()[0];
   }
 
-  ORT_RETURN_IF_ERROR(discrete_fourier_transform(ctx, axis, is_onesided_, is_inverse_));
+  ORT_RETURN_IF_ERROR(discrete_fourier_transform(ctx, axis, is_onesided_, is_inverse_, float_plans_, double_plans_));
   return Status::OK();
 }
 
 template <typename T, typename U>
-static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_onesided, bool /*inverse*/) {
+static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_onesided, signal::DftPlanCache<T>& plans) {
   // Attr("onesided"): default = 1
   // Input(0, "signal") type = T1
   // Input(1, "frame_length") type = T2
@@ -519,39 +565,32 @@ static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_oneside
   // Get/create the output mutable data
   auto output_spectra_shape = onnxruntime::TensorShape({batch_size, n_dfts, dft_output_size, 2});
   auto Y = ctx->Output(0, output_spectra_shape);
-  auto Y_data = reinterpret_cast<T*>(Y->MutableDataRaw());
-
-  // Get/create the signal mutable data
-  auto* signal_data = const_cast<U*>(reinterpret_cast<const U*>(signal->DataRaw()));
-
-  // Define tensor shapes for each dft run
-  constexpr int64_t output_components = 2;
-  auto dft_input_shape = onnxruntime::TensorShape({1, window_size, signal_components});
-  auto dft_output_shape = onnxruntime::TensorShape({1, dft_output_size, output_components});
-
-  Tensor b_fft, chirp;
-  InlinedVector<std::complex<T>> V;
-  InlinedVector<std::complex<T>> temp_output;
-
-  // Run each dft of each batch as if it was a real-valued batch size 1 dft operation
-  for (int64_t batch_idx = 0; batch_idx < batch_size; batch_idx++) {
-    for (int64_t i = 0; i < n_dfts; i++) {
-      auto input_frame_begin =
-          signal_data + (batch_idx * signal_size * signal_components) + (i * frame_step * signal_components);
-
-      auto output_frame_begin = Y_data + (batch_idx * n_dfts * dft_output_size * output_components) +
-                                (i * dft_output_size * output_components);
-
-      // Tensors do not own the backing memory, so no worries on destruction
-      auto input = onnxruntime::Tensor(signal->DataType(), dft_input_shape, input_frame_begin, signal->Location(), 0);
-
-      auto output = onnxruntime::Tensor(Y->DataType(), dft_output_shape, output_frame_begin, Y->Location(), 0);
-
-      // Run individual dft
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<T, U>(ctx, &input, &output, b_fft, chirp, 1, window_size, window, is_onesided,
-                                                            false, V, temp_output)));
-    }
-  }
+  auto* Y_data = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw());
+
+  const auto* signal_data = reinterpret_cast<const U*>(signal->DataRaw());
+  const T* window_data = window ? reinterpret_cast<const T*>(window->DataRaw()) : nullptr;
+
+  const auto plan = plans.Get(onnxruntime::narrow<size_t>(window_size), false);
+  const size_t frame_size = onnxruntime::narrow<size_t>(window_size);
+  const size_t output_size = onnxruntime::narrow<size_t>(dft_output_size);
+
+  // Run the dfts of every frame of every batch in parallel
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(SafeInt<std::ptrdiff_t>(batch_size) * n_dfts),
+      TensorOpCost{static_cast<double>(frame_size * sizeof(U)),
+                   static_cast<double>(output_size * sizeof(std::complex<T>)), dft_compute_cost(*plan)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<std::complex<T>> scratch;
+        std::vector<std::complex<T>> scratch2;
+        for (std::ptrdiff_t frame = first; frame < last; frame++) {
+          const int64_t batch_idx = frame / n_dfts;
+          const int64_t i = frame % n_dfts;
+          const U* input_frame_begin = signal_data + (batch_idx * signal_size) + (i * frame_step);
+          std::complex<T>* output_frame_begin = Y_data + frame * dft_output_size;
+          dft_one<T, U>(*plan, input_frame_begin, 1, frame_size, window_data, output_frame_begin, 1, output_size,
+                        scratch, scratch2);
+        }
+      });
 
   return Status::OK();
 }
@@ -576,9 +615,9 @@ Status STFT::Compute(OpKernelContext* ctx) const {
   const auto element_size = data_type->Size();
   if (element_size == sizeof(float)) {
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, float>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, float>(ctx, is_onesided_, float_plans_)));
     } else if (is_complex_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, std::complex<float>>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, std::complex<float>>(ctx, is_onesided_, float_plans_)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimenstion must be the batch dimension and its second "
@@ -588,9 +627,9 @@ Status STFT::Compute(OpKernelContext* ctx) const {
     }
   } else if (element_size == sizeof(double)) {
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, double>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, double>(ctx, is_onesided_, double_plans_)));
     } else if (is_complex_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, std::complex<double>>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, std::complex<double>>(ctx, is_onesided_, double_plans_)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimenstion must be the batch dimension and its second "
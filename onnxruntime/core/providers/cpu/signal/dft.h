@@ -1,16 +1,40 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <memory>
+#include <mutex>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
 
+namespace signal {
+
+template <typename T>
+struct DftPlan;
+
+// Keeps the plan (bit reversal permutation, twiddle factors and Bluestein chirp) of the last transform length so
+// repeated runs with the same length reuse it. The one-sided output is taken from the full plan.
+template <typename T>
+class DftPlanCache {
+ public:
+  std::shared_ptr<const DftPlan<T>> Get(size_t dft_length, bool inverse);
+
+ private:
+  std::mutex mutex_;
+  std::shared_ptr<const DftPlan<T>> plan_;
+};
+
+}  // namespace signal
+
 class DFT final : public OpKernel {
   int opset_;
   bool is_onesided_ = true;
   int64_t axis_ = 0;
   bool is_inverse_ = false;
+  mutable signal::DftPlanCache<float> float_plans_;
+  mutable signal::DftPlanCache<double> double_plans_;
 
  public:
   explicit DFT(const OpKernelInfo& info) : OpKernel(info) {
@@ -27,6 +51,8 @@ class DFT final : public OpKernel {
 
 class STFT final : public OpKernel {
   bool is_onesided_ = true;
+  mutable signal::DftPlanCache<float> float_plans_;
+  mutable signal::DftPlanCache<double> double_plans_;
 
  public:
   explicit STFT(const OpKernelInfo& info) : OpKernel(info) {
@@ -3,11 +3,15 @@
 
 // https://github.com/onnx/onnx/blob/main/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
+
+#include <algorithm>
+
 #include "core/common/common.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/gather_scatter_utils.h"
 #include "core/providers/op_kernel_type_control.h"
 
 namespace onnxruntime {
@@ -83,10 +87,31 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   return Status::OK();
 }
 
+// Gather single element blocks with typed loads and stores, so the loop over the indices compiles to a vector
+// gather on targets that have one.
+template <typename T, typename Tin>
+void GatherElementsOfType(const Tin* indices_data, const uint8_t* src_base, uint8_t* dst_base,
+                          const int64_t N, const int64_t axis_dim_limit, ptrdiff_t first, ptrdiff_t last) {
+  const T* src = reinterpret_cast<const T*>(src_base);
+  T* dst = reinterpret_cast<T*>(dst_base);
+  while (first < last) {
+    const int64_t batch = first / N;
+    const int64_t i_begin = first % N;
+    const int64_t i_end = std::min<int64_t>(N, i_begin + (last - first));
+    const T* batch_src = src + batch * axis_dim_limit;
+    T* batch_dst = dst + batch * N;
+    for (int64_t i = i_begin; i < i_end; ++i) {
+      const int64_t idx = static_cast<int64_t>(indices_data[i]);
+      batch_dst[i] = batch_src[idx < 0 ? idx + axis_dim_limit : idx];
+    }
+    first += i_end - i_begin;
+  }
+}
+
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
-                      const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
+                      const int64_t N, const int64_t data_batch_bytes,
                       const TensorShape& input_data_shape, const int64_t axis, concurrency::ThreadPool* tp) {
   const Tin* indices_data = indices_tensor->Data<Tin>();
 
@@ -102,30 +127,72 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-  auto lambda = [&](int64_t index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
+  // Each (batch, index) pair moves one block of block_size bytes to dst_base + (batch * N + i) * block_size,
+  // so the output is addressed by the flattened pair index.
+  const auto cost = gather_scatter::UnitCost(narrow<size_t>(block_size), sizeof(Tin));
+  const ptrdiff_t total = SafeInt<ptrdiff_t>(M) * N;
+
+  if (is_string_type) {
+    const int64_t strings_per_block = block_size / static_cast<int64_t>(element_bytes);
+    const auto* src_str = reinterpret_cast<const std::string*>(src_base);
+    auto* dst_str = reinterpret_cast<std::string*>(dst_base);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, total, cost,
+        [&](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t index = first; index < last; ++index) {
+            const int64_t batch = index / N;
+            Tin idx = indices_data[index % N];
+            idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
+            const auto* src = src_str + (batch * axis_dim_limit + idx) * strings_per_block;
+            std::copy(src, src + strings_per_block, dst_str + index * strings_per_block);
+          }
+        });
+    return Status::OK();
+  }
 
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, narrow<size_t>(block_size));
+  using GatherElementsFn = void (*)(const Tin*, const uint8_t*, uint8_t*, int64_t, int64_t, ptrdiff_t, ptrdiff_t);
+  GatherElementsFn gather_elements = nullptr;
+  if (block_size == static_cast<int64_t>(element_bytes)) {
+    switch (element_bytes) {
+      case sizeof(uint8_t):
+        gather_elements = GatherElementsOfType<uint8_t, Tin>;
+        break;
+      case sizeof(uint16_t):
+        gather_elements = GatherElementsOfType<uint16_t, Tin>;
+        break;
+      case sizeof(uint32_t):
+        gather_elements = GatherElementsOfType<uint32_t, Tin>;
+        break;
+      case sizeof(uint64_t):
+        gather_elements = GatherElementsOfType<uint64_t, Tin>;
+        break;
+      default:
+        break;
     }
-  };
-  concurrency::ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(M) * N, static_cast<double>(block_size),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int index = static_cast<int>(first), end = static_cast<int>(last); index < end; ++index) {
-                                              lambda(index);
-                                            }
-                                          });
+  }
+
+  if (gather_elements != nullptr) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, total, cost,
+        [&](ptrdiff_t first, ptrdiff_t last) {
+          gather_elements(indices_data, src_base, dst_base, N, axis_dim_limit, first, last);
+        });
+    return Status::OK();
+  }
+
+  // Runs of consecutive indices within a batch are contiguous in both the input and the output, and are moved
+  // with a single copy.
+  concurrency::ThreadPool::TryParallelFor(
+      tp, total, cost,
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        gather_scatter::GatherUnits(dst_base, src_base, narrow<size_t>(block_size), first, last,
+                                    [&](ptrdiff_t index) -> size_t {
+                                      const int64_t batch = index / N;
+                                      int64_t idx = static_cast<int64_t>(indices_data[index % N]);
+                                      idx = idx < 0 ? idx + axis_dim_limit : idx;
+                                      return static_cast<size_t>(batch * data_batch_bytes + idx * block_size);
+                                    });
+      });
 
   return Status::OK();
 }
@@ -144,7 +211,6 @@ Status Gather::Compute(OpKernelContext* context) const {
   const int64_t M = input_data_shape.SizeToDimension(narrow<size_t>(p.axis));
   const int64_t N = p.indices_tensor->Shape().Size();
   const int64_t data_batch_bytes = input_data_shape.SizeFromDimension(narrow<size_t>(p.axis)) * element_bytes;
-  const int64_t gathered_batch_bytes = N * block * SafeInt<int64_t>(element_bytes);
 
   const auto* src_base = static_cast<const uint8_t*>(p.input_tensor->DataRaw());
   auto* dst_base = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
@@ -154,12 +220,12 @@ Status Gather::Compute(OpKernelContext* context) const {
   if (utils::HasType<EnabledIndexTypes, int32_t>() &&
       p.indices_tensor->IsDataType<int32_t>()) {
     return GatherCopyData<int32_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis, tp);
+                                   block_size, M, N, data_batch_bytes, input_data_shape, p.axis, tp);
   }
   if (utils::HasType<EnabledIndexTypes, int64_t>() &&
       p.indices_tensor->IsDataType<int64_t>()) {
     return GatherCopyData<int64_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis, tp);
+                                   block_size, M, N, data_batch_bytes, input_data_shape, p.axis, tp);
   }
 
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Gather Tind type not supported in this build.");
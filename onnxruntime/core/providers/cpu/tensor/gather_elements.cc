@@ -1,10 +1,12 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <atomic>
 #include <string>
 #include "gather_elements.h"
 #include "onnxruntime_config.h"
 
+#include "core/platform/threadpool.h"
 #include "core/util/force_inline.h"
 
 namespace onnxruntime {
@@ -68,15 +70,25 @@ static inline size_t CalculateOffset(size_t inner_dim, const TensorPitches& inpu
   return base_offset;
 }
 
+// Check that all indices are within [-axis_size, axis_size). The check has no early exit so it vectorizes, and
+// validating a row up front keeps the bounds check out of the gather loops, which can then compile to vector
+// gathers on targets that have them.
 template <typename T>
-ORT_FORCEINLINE int64_t GetIndex(size_t i, const T* indices, int64_t axis_size) {
-  int64_t index = indices[i];
-  if (index < 0)  // Handle negative indices
-    index += axis_size;
-  if (std::make_unsigned_t<T>(index) >= std::make_unsigned_t<T>(axis_size))
-    ORT_THROW("Index out of range");
-  return index;
-};
+ORT_FORCEINLINE bool IndicesInRange(const T* indices, size_t count, int64_t axis_size) {
+  bool in_range = true;
+  for (size_t i = 0; i < count; i++) {
+    int64_t index = static_cast<int64_t>(indices[i]);
+    index += index < 0 ? axis_size : 0;
+    in_range &= static_cast<uint64_t>(index) < static_cast<uint64_t>(axis_size);
+  }
+  return in_range;
+}
+
+template <typename T>
+ORT_FORCEINLINE int64_t NormalizeIndex(T index, int64_t axis_size) {
+  const int64_t normalized = static_cast<int64_t>(index);
+  return normalized < 0 ? normalized + axis_size : normalized;
+}
 
 #ifdef __GNUC__
 #pragma GCC diagnostic push
@@ -106,29 +118,40 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
   int64_t axis_size = input_tensor->Shape()[onnxruntime::narrow<size_t>(axis)];
 
   bool innermost_axis = axis == input_rank - 1;
-  bool index_error = false;
+  std::atomic<bool> index_error{false};
 
   auto MainLoop = [&](auto* output_data, auto* input_data) {
-    auto BatchWork = [&](size_t inner_dim) {
-      ORT_TRY {
-        auto output = output_data + inner_dim_size * inner_dim;
-        auto input = input_data + CalculateOffset(inner_dim, input_shape_pitches, onnxruntime::narrow<size_t>(axis), indices_shape);
-        auto indices = indices_data + inner_dim_size * inner_dim;
-
-        if (innermost_axis) {
-          for (size_t i = 0; i < inner_dim_size; i++)
-            output[i] = input[GetIndex(i, indices, axis_size)];
-        } else {
-          for (size_t i = 0; i < inner_dim_size; i++)
-            output[i] = input[GetIndex(i, indices, axis_size) * axis_pitch + i];
-        }
-      }
-      ORT_CATCH(const std::exception&) {
+    auto RowWork = [&](size_t inner_dim) {
+      auto output = output_data + inner_dim_size * inner_dim;
+      auto input = input_data + CalculateOffset(inner_dim, input_shape_pitches, onnxruntime::narrow<size_t>(axis), indices_shape);
+      auto indices = indices_data + inner_dim_size * inner_dim;
+
+      if (!IndicesInRange(indices, inner_dim_size, axis_size)) {
         index_error = true;
+        return;
+      }
+
+      if (innermost_axis) {
+        for (size_t i = 0; i < inner_dim_size; i++)
+          output[i] = input[NormalizeIndex(indices[i], axis_size)];
+      } else {
+        for (size_t i = 0; i < inner_dim_size; i++)
+          output[i] = input[NormalizeIndex(indices[i], axis_size) * axis_pitch + i];
       }
     };
 
-    concurrency::ThreadPool::TryBatchParallelFor(ttp, num_inner_dim, BatchWork, 0);
+    // Partition the rows by the bytes moved, so short rows are batched into larger tasks.
+    const size_t row_bytes = inner_dim_size * sizeof(*output_data);
+    concurrency::ThreadPool::TryParallelFor(
+        ttp, static_cast<ptrdiff_t>(num_inner_dim),
+        TensorOpCost{static_cast<double>(row_bytes + inner_dim_size * sizeof(Tin)),
+                     static_cast<double>(row_bytes),
+                     static_cast<double>(inner_dim_size)},
+        [&RowWork](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t inner_dim = first; inner_dim < last; ++inner_dim) {
+            RowWork(static_cast<size_t>(inner_dim));
+          }
+        });
   };
 
   // Iterate over the elements based on the element size (or if it's a string). For everything but strings
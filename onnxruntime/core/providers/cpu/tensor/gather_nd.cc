@@ -3,6 +3,7 @@
 #include <core/common/safeint.h>
 #include "gather_nd.h"
 #include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/gather_scatter_utils.h"
 
 namespace onnxruntime {
 
@@ -177,16 +178,17 @@ Status GatherND::Compute(OpKernelContext* context) const {
 }
 
 Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
-  auto lambda = [&](int64_t slice_idx) {
-    memcpy(p.output_base + slice_idx * p.bytes_per_slice, p.input_base + p.slice_offsets[onnxruntime::narrow<size_t>(slice_idx)] * p.element_bytes,
-           onnxruntime::narrow<size_t>(p.bytes_per_slice));
-  };
+  // Slices with adjacent offsets, e.g. from batched or range generated indices, are copied as one block.
+  const size_t bytes_per_slice = onnxruntime::narrow<size_t>(p.bytes_per_slice);
+  const size_t element_bytes = onnxruntime::narrow<size_t>(p.element_bytes);
   concurrency::ThreadPool::TryParallelFor(
-      tp, p.slice_offsets.size(), static_cast<double>(p.bytes_per_slice),
-      [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
-          lambda(slice_idx);
-        }
+      tp, p.slice_offsets.size(), gather_scatter::UnitCost(bytes_per_slice, sizeof(uint64_t)),
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        gather_scatter::GatherUnits(
+            p.output_base, p.input_base, bytes_per_slice, first, last,
+            [&](ptrdiff_t slice_idx) -> size_t {
+              return static_cast<size_t>(p.slice_offsets[static_cast<size_t>(slice_idx)]) * element_bytes;
+            });
       });
   return Status::OK();
 }
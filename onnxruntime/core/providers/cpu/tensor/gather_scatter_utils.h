@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace gather_scatter {
+
+// Shared copy engine for the CPU Gather/GatherND/ScatterND kernels.
+//
+// Each of these kernels moves a sequence of fixed size blocks ("units") between a dense buffer, where unit i
+// lives at i * unit_bytes, and an indexed buffer, where unit i lives at offset(i). Index tensors produced by
+// embedding lookups, Range/Slice style index generation and batched GatherND frequently contain runs of
+// consecutive offsets, so the units of a run are moved with a single bulk copy instead of one copy per index.
+
+// Cost of moving one unit of 'unit_bytes' bytes whose location is described by 'index_bytes' bytes of indices.
+// The thread pool partitions the work by these byte counts so that every task moves a similar amount of data,
+// instead of a similar number of indices.
+inline TensorOpCost UnitCost(size_t unit_bytes, size_t index_bytes) {
+  return TensorOpCost{static_cast<double>(unit_bytes + index_bytes),
+                      static_cast<double>(unit_bytes),
+                      static_cast<double>(unit_bytes) / 16.0};
+}
+
+// Invoke fn(unit, offset, count) for each maximal run of units in [first, last) whose indexed offsets are
+// consecutive, i.e. offset(unit + k) == offset(unit) + k * offset_stride for k in [0, count).
+// 'offset_stride' is the distance between adjacent units in the same units as offset() returns.
+template <typename TOffset, typename GetOffset, typename RunFn>
+void ForEachContiguousRun(ptrdiff_t first, ptrdiff_t last, TOffset offset_stride,
+                          const GetOffset& offset, const RunFn& fn) {
+  ptrdiff_t unit = first;
+  while (unit < last) {
+    const TOffset run_offset = offset(unit);
+    ptrdiff_t count = 1;
+    TOffset next_offset = run_offset + offset_stride;
+    while (unit + count < last && offset(unit + count) == next_offset) {
+      ++count;
+      next_offset += offset_stride;
+    }
+    fn(unit, run_offset, count);
+    unit += count;
+  }
+}
+
+// Gather units [first, last) into the dense buffer 'dst', reading unit i from src + src_offset(i) bytes.
+template <typename GetOffset>
+void GatherUnits(uint8_t* dst, const uint8_t* src, size_t unit_bytes, ptrdiff_t first, ptrdiff_t last,
+                 const GetOffset& src_offset) {
+  ForEachContiguousRun(first, last, unit_bytes, src_offset,
+                       [&](ptrdiff_t unit, size_t offset, ptrdiff_t count) {
+                         memcpy(dst + unit * unit_bytes, src + offset, static_cast<size_t>(count) * unit_bytes);
+                       });
+}
+
+}  // namespace gather_scatter
+}  // namespace onnxruntime
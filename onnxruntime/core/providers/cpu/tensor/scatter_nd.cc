@@ -7,6 +7,7 @@
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/providers/cpu/tensor/gather_scatter_utils.h"
 #include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
@@ -356,51 +357,41 @@ struct ScatterNDDispatchTarget {
     Prepare<TData> prepare;
     ORT_RETURN_IF_ERROR(PrepareForCompute(context, prepare));
 
-    auto lambda = [&](int64_t i) {
-      switch (reduction) {
-        case ScatterND::Reduction::Add: {
-          auto func = Func_Add_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Mul: {
-          auto func = Func_Mul_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Min: {
-          auto func = Func_Min_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Max: {
-          auto func = Func_Max_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        default:
-        case ScatterND::Reduction::None: {
-          auto func = Func_Copy_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-      }
+    // Updates whose target offsets are adjacent form one contiguous region of the output, so each run is
+    // applied with a single call. Runs never contain duplicate offsets, so this does not change the result.
+    const uint64_t element_to_copy = prepare.element_to_copy;
+    auto apply_runs = [&](auto func, ptrdiff_t first, ptrdiff_t last) {
+      gather_scatter::ForEachContiguousRun(
+          first, last, element_to_copy,
+          [&](ptrdiff_t i) { return prepare.element_offsets[static_cast<size_t>(i)]; },
+          [&](ptrdiff_t i, uint64_t offset, ptrdiff_t count) {
+            func(prepare.output_base + offset,
+                 prepare.input_base + i * element_to_copy,
+                 static_cast<uint64_t>(count) * element_to_copy);
+          });
     };
+
     concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
+        tp, prepare.element_offsets.size(),
+        gather_scatter::UnitCost(SafeInt<size_t>(element_to_copy) * sizeof(TData), sizeof(uint64_t)),
+        [&](ptrdiff_t first, ptrdiff_t last) {
+          switch (reduction) {
+            case ScatterND::Reduction::Add:
+              apply_runs(Func_Add_ND<TData>(), first, last);
+              break;
+            case ScatterND::Reduction::Mul:
+              apply_runs(Func_Mul_ND<TData>(), first, last);
+              break;
+            case ScatterND::Reduction::Min:
+              apply_runs(Func_Min_ND<TData>(), first, last);
+              break;
+            case ScatterND::Reduction::Max:
+              apply_runs(Func_Max_ND<TData>(), first, last);
+              break;
+            default:
+            case ScatterND::Reduction::None:
+              apply_runs(Func_Copy_ND<TData>(), first, last);
+              break;
           }
         });
     return Status::OK();
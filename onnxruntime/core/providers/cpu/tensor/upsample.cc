@@ -3,10 +3,12 @@
 
 #include "core/providers/cpu/tensor/upsample.h"
 
+#include <array>
 #include <limits>
 
 #include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample_antialias.h"
 
@@ -918,197 +920,215 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
-
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+// Computes the input taps of a linear resize along one axis: the two input positions around the original
+// coordinate of every output position, weighted by their distance to it.
+static void SetupLinearFilterTaps(int64_t input_size, int64_t output_size, float scale,
+                                  float roi_start, float roi_end,
+                                  const GetOriginalCoordinateFunc& get_original_coordinate,
+                                  int32_t* index, float* weight, uint8_t* outside) {
+  for (int64_t o = 0; o < output_size; ++o) {
+    float in = scale == 1 ? static_cast<float>(o)
+                          : get_original_coordinate(static_cast<float>(o), scale,
+                                                    static_cast<float>(output_size),
+                                                    static_cast<float>(input_size),
+                                                    roi_start, roi_end);
+    outside[o] = (in < 0 || in > static_cast<float>(input_size - 1)) ? 1 : 0;
+    in = std::max(0.0f, std::min(in, static_cast<float>(input_size - 1)));
+
+    const int32_t in1 = std::min(static_cast<int32_t>(in), static_cast<int32_t>(input_size - 1));
+    const int32_t in2 = std::min(in1 + 1, static_cast<int32_t>(input_size - 1));
+    float d1 = std::fabs(in - in1);
+    float d2 = std::fabs(in - in2);
+    if (in1 == in2) {
+      d1 = 0.5f;
+      d2 = 0.5f;
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+    index[o * 2] = in1;
+    index[o * 2 + 1] = in2;
+    weight[o * 2] = d2;
+    weight[o * 2 + 1] = d1;
   }
-  cache[grid_start_pos] = result;
-
-  return result;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
-template <typename T>
-void ResizeBiCubic(int64_t batch_size,
-                   int64_t num_channels,
-                   int64_t input_height,
-                   int64_t input_width,
-                   int64_t output_height,
-                   int64_t output_width,
-                   float height_scale,
-                   float width_scale,
-                   float cubic_coeff_a,
-                   bool use_extrapolation,
-                   float extrapolation_value,
-                   bool exclude_outside,
-                   gsl::span<const float> roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
-
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
 
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+// Computes the input taps of a cubic resize along one axis: the four input positions around the original
+// coordinate of every output position (clamped to the input), weighted by the cubic convolution coefficients.
+// With exclude_outside the positions outside of the input get no weight and the rest is renormalized.
+static void SetupCubicFilterTaps(int64_t input_size, int64_t output_size, float scale,
+                                 float roi_start, float roi_end, float cubic_coeff_a, bool exclude_outside,
+                                 const GetOriginalCoordinateFunc& get_original_coordinate,
+                                 int32_t* index, float* weight, uint8_t* outside) {
+  for (int64_t o = 0; o < output_size; ++o) {
+    const float in = scale == 1 ? static_cast<float>(o)
+                                : get_original_coordinate(static_cast<float>(o), scale,
+                                                          static_cast<float>(output_size),
+                                                          static_cast<float>(input_size),
+                                                          roi_start, roi_end);
+    outside[o] = (in < 0 || in > static_cast<float>(input_size - 1)) ? 1 : 0;
+
+    const int64_t in_int = static_cast<int64_t>(std::floor(in));
+    auto coeffs = GetCubicCoeffs(in - in_int, cubic_coeff_a);
+
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      coeff_sum = 0;
+      for (int64_t i = 0; i < static_cast<int64_t>(CubicModeGridLength); i++) {
+        const int64_t pos = in_int - 1 + i;
+        if (pos < 0 || pos >= input_size) {
+          coeffs[narrow<size_t>(i)] = 0.0f;
+        }
+        coeff_sum += coeffs[narrow<size_t>(i)];
+      }
     }
-  }
 
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+    for (int64_t i = 0; i < static_cast<int64_t>(CubicModeGridLength); i++) {
+      const int64_t pos = std::max<int64_t>(0, std::min(in_int - 1 + i, input_size - 1));
+      index[o * CubicModeGridLength + i] = static_cast<int32_t>(pos);
+      weight[o * CubicModeGridLength + i] = coeffs[narrow<size_t>(i)] / coeff_sum;
     }
   }
+}
 
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
+std::shared_ptr<const ResizeFilterTables> ResizeFilterCache::Get(const ResizeFilterKey& key,
+                                                                 const std::function<ResizeFilterTables()>& create) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (tables_ == nullptr || !(key_ == key)) {
+    tables_ = std::make_shared<const ResizeFilterTables>(create());
+    key_ = key;
+  }
+  return tables_;
+}
 
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
+static ResizeFilterTables SetupResizeFilterTables(UpsampleMode mode, bool is_nchw,
+                                                  int64_t input_height, int64_t input_width,
+                                                  int64_t output_height, int64_t output_width,
+                                                  float height_scale, float width_scale,
+                                                  gsl::span<const float> roi,
+                                                  float cubic_coeff_a, bool exclude_outside,
+                                                  const GetOriginalCoordinateFunc& get_original_coordinate) {
+  ResizeFilterTables tables;
+  tables.tap_count = mode == UpsampleMode::CUBIC ? CubicModeGridLength : 2;
+  tables.y_index.resize(narrow<size_t>(output_height) * tables.tap_count);
+  tables.y_weight.resize(narrow<size_t>(output_height) * tables.tap_count);
+  tables.y_outside.resize(narrow<size_t>(output_height));
+  tables.x_index.resize(narrow<size_t>(output_width) * tables.tap_count);
+  tables.x_weight.resize(narrow<size_t>(output_width) * tables.tap_count);
+  tables.x_outside.resize(narrow<size_t>(output_width));
 
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
-        }
+  const size_t height_rindex = is_nchw ? 1 : 2;
+  const size_t width_rindex = is_nchw ? 0 : 1;
+  const float roi_y_start = roi[roi.size() / 2 - (height_rindex + 1)];
+  const float roi_y_end = roi[roi.size() - (height_rindex + 1)];
+  const float roi_x_start = roi[roi.size() / 2 - (width_rindex + 1)];
+  const float roi_x_end = roi[roi.size() - (width_rindex + 1)];
+
+  if (mode == UpsampleMode::CUBIC) {
+    SetupCubicFilterTaps(input_height, output_height, height_scale, roi_y_start, roi_y_end,
+                         cubic_coeff_a, exclude_outside, get_original_coordinate,
+                         tables.y_index.data(), tables.y_weight.data(), tables.y_outside.data());
+    SetupCubicFilterTaps(input_width, output_width, width_scale, roi_x_start, roi_x_end,
+                         cubic_coeff_a, exclude_outside, get_original_coordinate,
+                         tables.x_index.data(), tables.x_weight.data(), tables.x_outside.data());
+  } else {
+    SetupLinearFilterTaps(input_height, output_height, height_scale, roi_y_start, roi_y_end,
+                          get_original_coordinate,
+                          tables.y_index.data(), tables.y_weight.data(), tables.y_outside.data());
+    SetupLinearFilterTaps(input_width, output_width, width_scale, roi_x_start, roi_x_end,
+                          get_original_coordinate,
+                          tables.x_index.data(), tables.x_weight.data(), tables.x_outside.data());
+  }
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
+  return tables;
+}
 
-          // when use_extrapolation is set and original index is out of the dim range
+// Float linear or cubic resize of the two innermost spatial axes of an NCHW (channels == 1, batch_size covers
+// N and C) or NHWC tensor. The input rows of every output row are blended into a temporary row which is then
+// interpolated horizontally, both passes vectorized by MLAS.
+static void ResizeSeparable(const ResizeFilterTables& tables,
+                            int64_t batch_size,
+                            int64_t num_channels,
+                            int64_t input_height,
+                            int64_t input_width,
+                            int64_t output_height,
+                            int64_t output_width,
+                            bool use_extrapolation,
+                            float extrapolation_value,
+                            const float* XdataBase,
+                            float* YdataBase,
+                            concurrency::ThreadPool* tp) {
+  const size_t tap_count = tables.tap_count;
+  const int64_t input_row_size = input_width * num_channels;
+  const int64_t output_row_size = output_width * num_channels;
+  const int64_t input_image_size = input_height * input_row_size;
+  const int64_t output_image_size = output_height * output_row_size;
+
+  const double cost = static_cast<double>((input_row_size + output_row_size) * static_cast<int64_t>(tap_count) * 2);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(batch_size * output_height),
+      TensorOpCost{static_cast<double>(input_row_size * static_cast<int64_t>(tap_count) * sizeof(float)),
+                   static_cast<double>(output_row_size * sizeof(float)), cost},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> blended_row(narrow<size_t>(input_row_size));
+        std::array<const float*, CubicModeGridLength> rows;
+
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t image = row / output_height;
+          const int64_t y = row % output_height;
+          float* Ydata = YdataBase + image * output_image_size + y * output_row_size;
+
+          // when use_extrapolation is set and original index of x or y is out of the dim range
           // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
+          if (use_extrapolation && tables.y_outside[narrow<size_t>(y)]) {
+            std::fill_n(Ydata, narrow<size_t>(output_row_size), extrapolation_value);
             continue;
           }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
-            }
+          const float* Xdata = XdataBase + image * input_image_size;
+          for (size_t i = 0; i < tap_count; i++) {
+            rows[i] = Xdata + tables.y_index[narrow<size_t>(y) * tap_count + i] * input_row_size;
           }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
-          }
+          MlasInterpolateRows(rows.data(), tables.y_weight.data() + narrow<size_t>(y) * tap_count, tap_count,
+                              blended_row.data(), narrow<size_t>(input_row_size));
+          MlasInterpolateColumns(blended_row.data(), tables.x_index.data(), tables.x_weight.data(), tap_count,
+                                 Ydata, narrow<size_t>(output_width), narrow<size_t>(num_channels));
 
-          Ydata[y * output_width + x] = static_cast<T>(result);
+          if (use_extrapolation) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              if (tables.x_outside[narrow<size_t>(x)]) {
+                std::fill_n(Ydata + x * num_channels, narrow<size_t>(num_channels), extrapolation_value);
+              }
+            }
+          }
         }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
+      });
+}
 
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+template <typename T>
+std::shared_ptr<const ResizeFilterTables> Upsample<T>::GetFilterTables(bool is_nchw,
+                                                                      int64_t input_height,
+                                                                      int64_t input_width,
+                                                                      int64_t output_height,
+                                                                      int64_t output_width,
+                                                                      float height_scale,
+                                                                      float width_scale,
+                                                                      gsl::span<const float> roi) const {
+  ResizeFilterKey key;
+  key.mode = mode_;
+  key.is_nchw = is_nchw;
+  key.input_height = input_height;
+  key.input_width = input_width;
+  key.output_height = output_height;
+  key.output_width = output_width;
+  key.height_scale = height_scale;
+  key.width_scale = width_scale;
+  key.roi.assign(roi.begin(), roi.end());
+  return filter_cache_.Get(key, [&]() {
+    return SetupResizeFilterTables(mode_, is_nchw, input_height, input_width, output_height, output_width,
+                                   height_scale, width_scale, roi, cubic_coeff_a_, exclude_outside_,
+                                   get_original_coordinate_);
+  });
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1211,6 +1231,19 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
           }
         }
 
+        if constexpr (std::is_same_v<T, float>) {
+          if (!antialias_) {
+            ResizeSeparable(*GetFilterTables(is_nchw, input_height, input_width, output_height, output_width,
+                                             height_scale, width_scale, roi),
+                            is_nchw ? static_cast<int64_t>(batch_size) * num_channels : batch_size,
+                            is_nchw ? 1 : num_channels,
+                            input_height, input_width, output_height, output_width,
+                            use_extrapolation_, extrapolation_value_, X->Data<float>(), Y->MutableData<float>(),
+                            context->GetOperatorThreadPool());
+            return Status::OK();
+          }
+        }
+
         if (is_nchw) {
           if (antialias_) {
             UpsampleBilinearAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
@@ -1349,10 +1382,12 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                  output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
         }
       } else {
-        ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                      height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
-                      extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+        ResizeSeparable(*GetFilterTables(true, input_height, input_width, output_height, output_width,
+                                         height_scale, width_scale, roi),
+                        batch_size * num_channels, 1,
+                        input_height, input_width, output_height, output_width,
+                        use_extrapolation_, extrapolation_value_, X->Data<float>(), Y->MutableData<float>(),
+                        context->GetOperatorThreadPool());
       }
       return Status::OK();
     }
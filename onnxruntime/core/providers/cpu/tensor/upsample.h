@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
@@ -58,6 +61,54 @@ struct BilinearParamsInteger {
   int32_t* dy2_scale_10{nullptr};
 };
 
+// Separable filter of a float linear or cubic resize of the two innermost spatial axes. Every output row and
+// column reads tap_count input rows/columns (clamped to the input) with normalized weights, so the resize is a
+// weighted sum of input rows followed by a weighted sum of pixels within the blended row.
+struct ResizeFilterTables {
+  size_t tap_count{2};
+
+  std::vector<int32_t> y_index;  // output_height x tap_count
+  std::vector<float> y_weight;
+  std::vector<int32_t> x_index;  // output_width x tap_count
+  std::vector<float> x_weight;
+
+  // Output rows/columns whose original coordinate is outside of the input, used with extrapolation.
+  std::vector<uint8_t> y_outside;
+  std::vector<uint8_t> x_outside;
+};
+
+struct ResizeFilterKey {
+  UpsampleMode mode{UpsampleMode::LINEAR};
+  bool is_nchw{true};
+  int64_t input_height{0};
+  int64_t input_width{0};
+  int64_t output_height{0};
+  int64_t output_width{0};
+  float height_scale{0.0f};
+  float width_scale{0.0f};
+  std::vector<float> roi;
+
+  bool operator==(const ResizeFilterKey& other) const {
+    return mode == other.mode && is_nchw == other.is_nchw &&
+           input_height == other.input_height && input_width == other.input_width &&
+           output_height == other.output_height && output_width == other.output_width &&
+           height_scale == other.height_scale && width_scale == other.width_scale &&
+           roi == other.roi;
+  }
+};
+
+// Keeps the filter tables of the last resize so repeated runs with the same shapes reuse them.
+class ResizeFilterCache {
+ public:
+  std::shared_ptr<const ResizeFilterTables> Get(const ResizeFilterKey& key,
+                                                const std::function<ResizeFilterTables()>& create);
+
+ private:
+  std::mutex mutex_;
+  ResizeFilterKey key_;
+  std::shared_ptr<const ResizeFilterTables> tables_;
+};
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
@@ -68,6 +119,19 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, gsl::span<const float> roi, gsl::span<const float> scales,
                      gsl::span<const int64_t> output_dims) const;
+
+ private:
+  // Returns the (cached) separable filter tables of a float linear or cubic resize.
+  std::shared_ptr<const ResizeFilterTables> GetFilterTables(bool is_nchw,
+                                                            int64_t input_height,
+                                                            int64_t input_width,
+                                                            int64_t output_height,
+                                                            int64_t output_width,
+                                                            float height_scale,
+                                                            float width_scale,
+                                                            gsl::span<const float> roi) const;
+
+  mutable ResizeFilterCache filter_cache_;
 };
 
 BilinearParams SetupUpsampleBilinear(const int32_t input_height,
@@ -3,6 +3,7 @@
 
 #include "regex_full_match.h"
 #include "core/common/common.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 ONNX_CPU_OPERATOR_KERNEL(
@@ -22,13 +23,23 @@ Status RegexFullMatch::Compute(OpKernelContext* context) const {
   const auto input_data = input_tensor->template DataAsSpan<std::string>();
   auto* output_tensor = context->Output(0, input_tensor->Shape());
   auto output_data = output_tensor->template MutableDataAsSpan<bool>();
-  auto output_iter = output_data.begin();
-  auto input_iter = input_data.begin();
-  while (input_iter != input_data.end()) {
-    *output_iter = RE2::FullMatch(*input_iter, re_);
-    input_iter++;
-    output_iter++;
+
+  // RE2 matches with a lazily built DFA whose cache is shared by all the threads using re_,
+  // the elements are independent so they are split across the thread pool.
+  size_t total_length = 0;
+  for (const auto& str : input_data) {
+    total_length += str.size();
   }
+  const double average_length = input_data.empty() ? 0. : static_cast<double>(total_length) / input_data.size();
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(input_data.size()),
+      TensorOpCost{average_length, 1., 16. + 4. * average_length},
+      [this, &input_data, &output_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (size_t i = static_cast<size_t>(first), end = static_cast<size_t>(last); i < end; ++i) {
+          output_data[i] = RE2::FullMatch(input_data[i], re_);
+        }
+      });
   return Status::OK();
 }
 
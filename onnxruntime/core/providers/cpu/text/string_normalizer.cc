@@ -12,6 +12,8 @@
 #include <locale.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
+#include <cctype>
 #include <codecvt>
 #include <locale>
 #include <functional>
@@ -436,6 +438,40 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS and not Apple
 #endif
 
 #endif  // _MSC_VER
+
+// True if every byte of str is 7-bit ASCII. The bytes are OR-ed together without an early exit
+// so the loop is vectorized.
+inline bool IsAscii(const std::string& str) {
+  unsigned char bits = 0;
+  for (char c : str) {
+    bits |= static_cast<unsigned char>(c);
+  }
+  return bits < 0x80;
+}
+
+// The case of ASCII letters can be changed byte by byte in every locale but the Turkic ones
+// where 'I' and 'i' map to dotless and dotted letters outside of ASCII.
+inline bool LocaleChangesAsciiCaseInAscii(const std::string& locale_name) {
+  std::string language = locale_name.substr(0, 2);
+  std::transform(language.begin(), language.end(), language.begin(),
+                 [](char ch) { return static_cast<char>(std::tolower(static_cast<unsigned char>(ch))); });
+  return language != "tr" && language != "az";
+}
+
+// Changes the case of the ASCII string src into dest without the conversion to wide chars,
+// dest is a std::string or a std::wstring.
+template <class DestString>
+void ChangeCaseAscii(StringNormalizer::CaseAction caseaction, const std::string& src, DestString& dest) {
+  assert(caseaction != StringNormalizer::NONE);
+  const char first = caseaction == StringNormalizer::LOWER ? 'A' : 'a';
+  const int delta = caseaction == StringNormalizer::LOWER ? 'a' - 'A' : 'A' - 'a';
+  dest.resize(src.size());
+  for (size_t i = 0, lim = src.size(); i < lim; ++i) {
+    const char ch = src[i];
+    const bool is_letter = static_cast<unsigned char>(ch - first) < 26;
+    dest[i] = static_cast<typename DestString::value_type>(is_letter ? ch + delta : ch);
+  }
+}
 }  // namespace string_normalizer
 
 using namespace string_normalizer;
@@ -460,6 +496,7 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
   }
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
+  ascii_case_change_ = LocaleChangesAsciiCaseInAscii(locale_name_);
 
   std::vector<std::string> stop_words = info.GetAttrsOrDefault<std::string>("stopwords");
   if (is_case_sensitive_) {
@@ -528,10 +565,16 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
 
   // Compute the largest widestring buffer needed.
   size_t max_wide_buffer_len = 0;
-  for (const auto& s : input_span) {
-    size_t wchars = 0;
-    // Checks for invalid UTF-8 characters on Windows
-    ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
+  // ASCII strings are changed byte by byte when the locale allows it, see ChangeCaseAscii.
+  InlinedVector<bool> is_ascii(input_span.size(), false);
+  for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
+    const std::string& s = input_span[i];
+    is_ascii[i] = ascii_case_change_ && IsAscii(s);
+    size_t wchars = s.size();
+    if (!is_ascii[i]) {
+      // Checks for invalid UTF-8 characters on Windows
+      ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
+    }
     max_wide_buffer_len = std::max(max_wide_buffer_len, wchars);
   }
 
@@ -545,11 +588,16 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     auto const output_data = output_tensor->MutableData<std::string>();
     for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
       const std::string& s = input_span[i];
+      auto& dest = output_data[i];
+      if (is_ascii[i]) {
+        ChangeCaseAscii(case_change_action_, s, dest);
+        continue;
+      }
+
       wchar_buffer.resize(max_wide_buffer_len);
       ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
       locale.ChangeCase(case_change_action_, wchar_buffer);
 
-      auto& dest = output_data[i];
       size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
       dest.resize(utf8_buffer_len);
       ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
@@ -562,7 +610,9 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     auto output_data = output_tensor->MutableData<std::string>();
     for (size_t i : filtered_indices) {
       const std::string& s = input_span[i];
-      if (case_change_action_ != NONE) {
+      if (case_change_action_ != NONE && is_ascii[i]) {
+        ChangeCaseAscii(case_change_action_, s, *output_data++);
+      } else if (case_change_action_ != NONE) {
         wchar_buffer.resize(max_wide_buffer_len);
         ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
         locale.ChangeCase(case_change_action_, wchar_buffer);
@@ -616,9 +666,13 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       filtered_strings_indices.reserve(input_span.size());
       for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
         const std::string& s = input_span[i];
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(compare_caseaction_, wchar_buffer);
+        if (is_ascii[i]) {
+          ChangeCaseAscii(compare_caseaction_, s, wchar_buffer);
+        } else {
+          wchar_buffer.resize(max_wide_buffer_len);
+          ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
+          locale.ChangeCase(compare_caseaction_, wchar_buffer);
+        }
         if (wstopwords_.count(wchar_buffer) == 0) {
           filtered_strings_indices.push_back(i);
         }
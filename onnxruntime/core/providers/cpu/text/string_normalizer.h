@@ -31,6 +31,8 @@ class StringNormalizer : public OpKernel {
   // used for case-insensitive compare
   CaseAction compare_caseaction_{LOWER};
   std::string locale_name_;
+  // True if the locale maps ASCII letters to ASCII letters so ASCII strings can skip the wide char conversion.
+  bool ascii_case_change_{true};
   // Either if these are populated but not both
   InlinedHashSet<std::string> stopwords_;
   InlinedHashSet<std::wstring> wstopwords_;
@@ -16,7 +16,7 @@ ONNX_CPU_OPERATOR_KERNEL(StringSplit, 20,
                          StringSplit);
 
 /// Calculate substrings in ``str`` delimited by ``delimiter``. A maximum of ``max_splits`` splits are permitted.
-/// Returns a vector of string slices into ``str`` representing the substrings as string views. The user must ensure
+/// Appends to ``out`` string slices into ``str`` representing the substrings as string views. The user must ensure
 /// the returned views' lifetime does not exceed ``str``'s.
 void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t max_splits, InlinedVector<std::string_view>& out) {
   if (str.empty()) {
@@ -24,7 +24,8 @@ void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t
   }
   if (delimiter.empty()) {
     // Count consecutive whitespace as one delimiter. Preceding and trailing whitespace is meant to be ignored.
-    size_t pos = str.find_first_not_of(" ");
+    // Single character searches, find() is a memchr.
+    size_t pos = str.find_first_not_of(' ');
     int64_t token_count = 0;
     while (pos != std::string::npos) {
       if (token_count++ == max_splits) {
@@ -36,9 +37,9 @@ void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t
         out.push_back(str.substr(pos, next_pos - pos + 1));
         break;
       } else {
-        auto next_pos = str.find_first_of(" ", pos);
+        auto next_pos = str.find(' ', pos);
         out.push_back(str.substr(pos, next_pos - pos));
-        pos = str.find_first_not_of(" ", next_pos);
+        pos = str.find_first_not_of(' ', next_pos);
       }
     }
   } else {
@@ -69,14 +70,19 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   auto num_tokens_data = context->Output(1, input->Shape())->template MutableDataAsSpan<int64_t>();
   auto num_tokens_iter = num_tokens_data.begin();
 
-  InlinedVector<InlinedVector<std::string_view>> input_slices;
-  input_slices.reserve(input_data.size());
+  // The substrings of all the inputs are stored one after the other as views into the input strings,
+  // the ones of input i are [substr_offsets[i], substr_offsets[i + 1]). This avoids one allocation per input.
+  InlinedVector<std::string_view> substrs;
+  InlinedVector<size_t> substr_offsets;
+  substrs.reserve(input_data.size());
+  substr_offsets.reserve(input_data.size() + 1);
+  substr_offsets.push_back(0);
   size_t last_dim = 0;
 
   for (const auto& s : input_data) {
-    auto& substrs = input_slices.emplace_back();
     ComputeSubstrings(s, delimiter_, maxsplit_, substrs);
-    auto substr_count = substrs.size();
+    auto substr_count = substrs.size() - substr_offsets.back();
+    substr_offsets.push_back(substrs.size());
     last_dim = std::max(last_dim, substr_count);
     *num_tokens_iter = static_cast<int64_t>(substr_count);
     ++num_tokens_iter;
@@ -87,9 +93,9 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   splits_shape.push_back(last_dim);
 
   auto splits_data = context->Output(0, splits_shape)->template MutableDataAsSpan<std::string>();
-  auto slices_iter = input_slices.begin();
-  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++slices_iter) {
-    std::copy(slices_iter->begin(), slices_iter->end(), output_splits_iter);
+  auto output_splits_iter = splits_data.begin();
+  for (size_t i = 0; i < input_data.size(); ++i, output_splits_iter += last_dim) {
+    std::copy(substrs.begin() + substr_offsets[i], substrs.begin() + substr_offsets[i + 1], output_splits_iter);
   }
 
   return Status::OK();
@@ -34,6 +34,9 @@ public:
         ML_CHECK_VALID_ARGUMENT(kernelCreationContext.GetInputCount() >= 1);
         ML_CHECK_VALID_ARGUMENT(kernelCreationContext.GetOutputCount() >= 1);
 
+        // The quantized KV cache is only implemented by the CPU execution provider.
+        ML_CHECK_VALID_ARGUMENT(kernelCreationContext.GetOptionalAttribute<int64_t>(AttrName::KvCacheBitWidth, 0) == 0);
+
         std::vector<std::optional<uint32_t>> inputIndices(inputCount);
         inputIndices[queryIndex] = queryIndex;
         inputIndices[keyIndex] = keyIndex;
@@ -5,9 +5,12 @@
 #include <vector>
 #include "gtest/gtest.h"
 #include <gsl/gsl>
+#include "core/framework/session_options.h"
 #include "core/session/onnxruntime_cxx_api.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/providers/model_tester.h"
+#include "test/util/include/asserts.h"
 #include "test/util/include/current_test_name.h"
 
 #ifdef USE_CUDA
@@ -454,5 +457,28 @@ TEST(BeamSearchTest, DummyT5PointerGenerator) {
   tester.RunWithConfig();
 }
 
+TEST(BeamSearchTest, DummyT5ShareCrossAttentionKV) {
+  // dummy_t5_cross_attention.onnx model generated using following command:
+  // python onnxruntime/test/testdata/dummy_t5_model_generator.py --output-path dummy_t5_cross_attention.onnx --cross-attention
+  // Its decoder attends to the cross attention key/value with MultiHeadAttention, so they can be fed once per batch
+  // and shared by the beams. The generated sequences shall be the same with and without sharing.
+  const std::vector<int32_t> expected_sequences{
+      2, 3, 5, 0, 0, 0, 0, 0, 0, 0, 2, 16, 6, 14, 1, 15, 6, 14, 1, 15, 2, 16, 6, 14, 1, 15, 6, 14, 1, 9,
+      2, 3, 4, 15, 6, 14, 1, 9, 3, 4, 2, 16, 6, 14, 1, 9, 3, 4, 15, 6, 2, 16, 6, 14, 1, 15, 6, 14, 1, 9};
+
+  for (const char* share_cross_attention_kv : {"0", "1"}) {
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsGenerationShareCrossAttentionKV,
+                                                      share_cross_attention_kv));
+
+    ModelTester tester(CurrentTestName(), ORT_TSTR("testdata/dummy_t5_cross_attention.onnx"));
+    tester.AddInput("encoder_input_ids", {2, 5}, {14, 6, 13, 9, 7, 3, 17, 5, 0, 11});
+    tester.AddOutput("sequences", {2, 3, 10}, expected_sequences);
+    tester.Config(so)
+        .ConfigEp(DefaultCpuExecutionProvider())
+        .RunWithConfig();
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
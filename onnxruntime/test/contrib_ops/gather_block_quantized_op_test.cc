@@ -342,6 +342,76 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis0NoZeroPoints) {
   Test_GatherAxis0_NoZeroPoints<Int4x2, MLFloat16, int64_t>();
 }
 
+// Embedding lookup: rows of a [vocab, hidden] table quantized along the hidden axis, with an odd row length so
+// that rows start in the middle of a byte, and repeated and negative token ids.
+template <typename T1, typename T2, typename Tind>
+void Test_GatherAxis0_EmbeddingRows() {
+  constexpr int64_t vocab = 5;
+  constexpr int64_t hidden = 37;
+  constexpr int64_t block_size = 16;
+  constexpr int64_t blocks = (hidden + block_size - 1) / block_size;
+
+  std::vector<int> data;
+  for (int64_t i = 0; i < vocab * hidden; ++i) {
+    data.push_back(static_cast<int>(i * 7 % 16) - 8);
+  }
+  std::vector<float> scales;
+  std::vector<int> zero_points;
+  for (int64_t i = 0; i < vocab * blocks; ++i) {
+    scales.push_back(static_cast<float>(i % 3 + 1) * 0.5f);
+    zero_points.push_back(static_cast<int>(i % 5) - 2);
+  }
+
+  std::vector<int> indices = {3, 0, 3, -1, 2, 3};
+  std::vector<float> output;
+  std::vector<float> output_no_zero_points;
+  for (int index : indices) {
+    const int64_t row = index < 0 ? index + vocab : index;
+    for (int64_t k = 0; k < hidden; ++k) {
+      const int q = data[row * hidden + k];
+      const float scale = scales[row * blocks + k / block_size];
+      output.push_back(static_cast<float>(q - zero_points[row * blocks + k / block_size]) * scale);
+      output_no_zero_points.push_back(static_cast<float>(q) * scale);
+    }
+  }
+
+  RunGatherBlockQuantized(ToType<T1>(data),
+                          {vocab, hidden},
+                          ToType<Tind>(indices),
+                          {2, 3},
+                          ToType<T2>(scales),
+                          {vocab, blocks},
+                          ToType<T1>(zero_points),
+                          0,
+                          1,
+                          block_size,
+                          ToType<T2>(output),
+                          {2, 3, hidden},
+                          OpTester::ExpectResult::kExpectSuccess);
+  if constexpr (std::is_same_v<T1, Int4x2>) {
+    RunGatherBlockQuantized(ToType<T1>(data),
+                            {vocab, hidden},
+                            ToType<Tind>(indices),
+                            {2, 3},
+                            ToType<T2>(scales),
+                            {vocab, blocks},
+                            {},
+                            0,
+                            1,
+                            block_size,
+                            ToType<T2>(output_no_zero_points),
+                            {2, 3, hidden},
+                            OpTester::ExpectResult::kExpectSuccess);
+  }
+}
+
+TEST(GatherBlockQuantizedOpTest, GatherAxis0EmbeddingRows) {
+  Test_GatherAxis0_EmbeddingRows<UInt4x2, float, int32_t>();
+  Test_GatherAxis0_EmbeddingRows<Int4x2, float, int32_t>();
+  Test_GatherAxis0_EmbeddingRows<UInt4x2, MLFloat16, int64_t>();
+  Test_GatherAxis0_EmbeddingRows<Int4x2, MLFloat16, int64_t>();
+}
+
 template <typename T1, typename T2, typename Tind>
 void Test_GatherAxis1_WithZeroPoints() {
   std::vector<int> data = {-8, -7, -6, -5,
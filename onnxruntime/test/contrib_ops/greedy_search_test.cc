@@ -5,7 +5,11 @@
 #include <vector>
 #include "gtest/gtest.h"
 #include <gsl/gsl>
+#include "contrib_ops/cpu/transformers/generation_device_helper.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 #include "core/session/onnxruntime_cxx_api.h"
+#include "core/util/thread_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 
 #ifdef USE_CUDA
@@ -183,5 +187,90 @@ TEST(GreedySearchTest, GptGreedySearchFp32) {
   }
 }
 
+// Finished sequences evicted from the decoder batch shall not change the generated sequences.
+// Rows 0 and 2 reach EOS (98, which is also the pad token) after four new tokens and are evicted, while rows 1 and 3
+// keep running to max_length, so the past state of the running rows is compacted.
+TEST(GreedySearchTest, GptGreedySearchFp32_EvictFinishedSequences) {
+  std::vector<int64_t> input_ids_shape{4, 4};
+  std::vector<int32_t> input_ids{
+      571, 57, 623, 848,
+      0, 0, 0, 52,
+      222, 256, 745, 435,
+      0, 0, 195, 731};
+
+  std::vector<int64_t> parameter_shape{1};
+  std::vector<int32_t> max_length{12};
+  std::vector<int32_t> min_length{1};
+  std::vector<float> repetition_penalty{1.0f};
+
+  std::vector<int32_t> expected_output{
+      571, 57, 623, 848, 848, 848, 848, 848, 98, 98, 98, 98,
+      0, 0, 0, 52, 204, 204, 204, 204, 204, 204, 204, 204,
+      222, 256, 745, 435, 866, 866, 866, 866, 98, 98, 98, 98,
+      0, 0, 195, 731, 731, 114, 114, 114, 114, 114, 114, 114};
+
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  const char* input_names[] = {"input_ids", "max_length", "min_length", "repetition_penalty"};
+  const char* const output_names[] = {"sequences"};
+
+  auto run = [&](bool evict_finished_sequences) {
+    std::vector<Ort::Value> ort_inputs;
+    ort_inputs.push_back(Ort::Value::CreateTensor(
+        info, input_ids.data(), input_ids.size(), input_ids_shape.data(), input_ids_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(
+        info, max_length.data(), max_length.size(), parameter_shape.data(), parameter_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(
+        info, min_length.data(), min_length.size(), parameter_shape.data(), parameter_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(
+        info, repetition_penalty.data(), repetition_penalty.size(), parameter_shape.data(), parameter_shape.size()));
+
+    Ort::SessionOptions session_options;
+    session_options.AddConfigEntry("session.generation_evict_finished_sequences",
+                                   evict_finished_sequences ? "1" : "0");
+    Ort::Session session(*ort_env, ORT_TSTR("testdata/transformers/tiny_gpt2_greedysearch_with_init_decoder.onnx"),
+                         session_options);
+
+    auto ort_outputs = session.Run(Ort::RunOptions{}, input_names, ort_inputs.data(), ort_inputs.size(),
+                                   output_names, 1);
+    EXPECT_EQ(ort_outputs.size(), 1U);
+    const auto* result_vals = ort_outputs[0].GetTensorData<int32_t>();
+    return std::vector<int32_t>(result_vals, result_vals + input_ids_shape[0] * max_length[0]);
+  };
+
+  ASSERT_EQ(expected_output, run(false));
+  ASSERT_EQ(expected_output, run(true));
+}
+
+TEST(GreedySearchTest, ArgMaxNextTokens_TiedMaximaAcrossTiles) {
+  // 4 threads split each row of 16384 scores into 4 tiles of 4096 scores.
+  constexpr int batch_size = 3;
+  constexpr int vocab_size = 16384;
+  std::vector<float> scores(static_cast<size_t>(batch_size) * vocab_size);
+  for (size_t i = 0; i < scores.size(); i++) {
+    scores[i] = static_cast<float>(i % 1000) / 1000.0f;
+  }
+
+  // Equal maxima in different tiles of a row, the lowest token id shall win.
+  scores[0 * vocab_size + 100] = 2.0f;
+  scores[0 * vocab_size + 9000] = 2.0f;
+  scores[0 * vocab_size + 16383] = 2.0f;
+  scores[1 * vocab_size + 5000] = 3.0f;
+  scores[1 * vocab_size + 6000] = 3.0f;
+  scores[1 * vocab_size + 12000] = 3.0f;
+  scores[2 * vocab_size + 8191] = 1.5f;
+  scores[2 * vocab_size + 8192] = 1.5f;
+  const std::vector<int32_t> expected_tokens{100, 5000, 8191};
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = 4;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+
+  for (concurrency::ThreadPool* tp : {thread_pool.get(), static_cast<concurrency::ThreadPool*>(nullptr)}) {
+    std::vector<int32_t> next_tokens(batch_size, -1);
+    contrib::GenerationCpuDeviceHelper::ArgMaxNextTokens<float>(scores, batch_size, vocab_size, tp, next_tokens);
+    ASSERT_EQ(expected_tokens, next_tokens);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
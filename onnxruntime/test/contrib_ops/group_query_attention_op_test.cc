@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "core/framework/kernel_registry.h"
+#include "core/framework/kernel_type_str_resolver.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+constexpr int kNumHeads = 2;
+constexpr int kKvNumHeads = 1;
+constexpr int kHeadSize = 4;
+
+// Deterministic int8 values in [-127, 127].
+int8_t TestValue(int i, int salt) {
+  return static_cast<int8_t>(((i * 37 + salt * 53 + 11) % 255) - 127);
+}
+
+// Rows of new key or value, where each row is int8 values times a per-row step, and the first element of each row
+// is +/-127 so that quantizing a row with scale = abs_max / 127 gives back exactly the same int8 values.
+void MakeNewRows(int rows, int salt, std::vector<float>& data, std::vector<int8_t>& quantized,
+                 std::vector<float>& scales) {
+  for (int r = 0; r < rows; r++) {
+    const float step = 0.01f * static_cast<float>(r + salt + 1);
+    float abs_max = 0.0f;
+    for (int h = 0; h < kHeadSize; h++) {
+      const int8_t q = h == 0 ? static_cast<int8_t>((r + salt) % 2 == 0 ? 127 : -127)
+                              : TestValue(r * kHeadSize + h, salt);
+      quantized.push_back(q);
+      data.push_back(step * static_cast<float>(q));
+      abs_max = std::max(abs_max, std::abs(data.back()));
+    }
+    scales.push_back(abs_max / 127.0f);
+  }
+}
+
+// Runs GroupQueryAttention with kv_cache_bit_width=8 for batch size 1, and compares output and int8 present
+// key/value with a reference computed from the dequantized cache.
+void RunQuantizedKVCacheTest(int past_sequence_length, int sequence_length) {
+  const int total_sequence_length = past_sequence_length + sequence_length;
+
+  // Past cache with arbitrary int8 values and scales.
+  std::vector<int8_t> past_key;
+  std::vector<int8_t> past_value;
+  std::vector<float> past_key_scale;
+  std::vector<float> past_value_scale;
+  for (int t = 0; t < past_sequence_length; t++) {
+    for (int h = 0; h < kHeadSize; h++) {
+      past_key.push_back(TestValue(t * kHeadSize + h, 1));
+      past_value.push_back(TestValue(t * kHeadSize + h, 2));
+    }
+    past_key_scale.push_back(0.005f * static_cast<float>(t + 1));
+    past_value_scale.push_back(0.004f * static_cast<float>(t + 2));
+  }
+
+  std::vector<float> key;
+  std::vector<float> value;
+  std::vector<int8_t> present_key = past_key;
+  std::vector<int8_t> present_value = past_value;
+  std::vector<float> present_key_scale = past_key_scale;
+  std::vector<float> present_value_scale = past_value_scale;
+  MakeNewRows(sequence_length, 3, key, present_key, present_key_scale);
+  MakeNewRows(sequence_length, 4, value, present_value, present_value_scale);
+
+  std::vector<float> query(static_cast<size_t>(sequence_length) * kNumHeads * kHeadSize);
+  for (size_t i = 0; i < query.size(); i++) {
+    query[i] = static_cast<float>(TestValue(static_cast<int>(i), 5)) / 127.0f;
+  }
+
+  // Reference attention over the dequantized cache. Query and output have shape (S, N x H).
+  const float alpha = 1.0f / std::sqrt(static_cast<float>(kHeadSize));
+  std::vector<float> output(query.size(), 0.0f);
+  for (int s = 0; s < sequence_length; s++) {
+    for (int n = 0; n < kNumHeads; n++) {
+      const float* q = query.data() + (s * kNumHeads + n) * kHeadSize;
+      const int attend_length = past_sequence_length + s + 1;
+      std::vector<float> probs(attend_length);
+      float max_score = -INFINITY;
+      for (int t = 0; t < attend_length; t++) {
+        float dot = 0.0f;
+        for (int h = 0; h < kHeadSize; h++) {
+          dot += q[h] * present_key_scale[t] * static_cast<float>(present_key[t * kHeadSize + h]);
+        }
+        probs[t] = alpha * dot;
+        max_score = std::max(max_score, probs[t]);
+      }
+      float sum = 0.0f;
+      for (float& p : probs) {
+        p = std::exp(p - max_score);
+        sum += p;
+      }
+      float* out = output.data() + (s * kNumHeads + n) * kHeadSize;
+      for (int t = 0; t < attend_length; t++) {
+        for (int h = 0; h < kHeadSize; h++) {
+          out[h] += probs[t] / sum * present_value_scale[t] * static_cast<float>(present_value[t * kHeadSize + h]);
+        }
+      }
+    }
+  }
+
+  OpTester tester("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", kNumHeads);
+  tester.AddAttribute<int64_t>("kv_num_heads", kKvNumHeads);
+  tester.AddAttribute<int64_t>("kv_cache_bit_width", 8);
+
+  tester.AddInput<float>("query", {1, sequence_length, kNumHeads * kHeadSize}, query);
+  tester.AddInput<float>("key", {1, sequence_length, kKvNumHeads * kHeadSize}, key);
+  tester.AddInput<float>("value", {1, sequence_length, kKvNumHeads * kHeadSize}, value);
+  if (past_sequence_length > 0) {
+    tester.AddInput<int8_t>("past_key", {1, kKvNumHeads, past_sequence_length, kHeadSize}, past_key);
+    tester.AddInput<int8_t>("past_value", {1, kKvNumHeads, past_sequence_length, kHeadSize}, past_value);
+  } else {
+    tester.AddOptionalInputEdge<int8_t>();
+    tester.AddOptionalInputEdge<int8_t>();
+  }
+  tester.AddInput<int32_t>("seqlens_k", {1}, {total_sequence_length - 1});
+  tester.AddInput<int32_t>("total_sequence_length", {1}, {total_sequence_length});
+  tester.AddOptionalInputEdge<float>();  // cos_cache
+  tester.AddOptionalInputEdge<float>();  // sin_cache
+  if (past_sequence_length > 0) {
+    tester.AddInput<float>("past_key_scale", {1, kKvNumHeads, past_sequence_length}, past_key_scale);
+    tester.AddInput<float>("past_value_scale", {1, kKvNumHeads, past_sequence_length}, past_value_scale);
+  }
+
+  tester.AddOutput<float>("output", {1, sequence_length, kNumHeads * kHeadSize}, output);
+  tester.AddOutput<int8_t>("present_key", {1, kKvNumHeads, total_sequence_length, kHeadSize}, present_key);
+  tester.AddOutput<int8_t>("present_value", {1, kKvNumHeads, total_sequence_length, kHeadSize}, present_value);
+  tester.AddOutput<float>("present_key_scale", {1, kKvNumHeads, total_sequence_length}, present_key_scale);
+  tester.AddOutput<float>("present_value_scale", {1, kKvNumHeads, total_sequence_length}, present_value_scale);
+  tester.SetOutputAbsErr("output", 1e-4f);
+
+  // int8 KV cache is only supported by the CPU execution provider.
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+#if defined(USE_DML)
+// Returns whether the DML execution provider has a kernel for a prompt GroupQueryAttention node whose KV cache
+// has element type TCache. Only the node types matter for the kernel lookup, so the inputs are zeros.
+template <typename TCache>
+bool DmlHasGroupQueryAttentionKernel(int64_t kv_cache_bit_width) {
+  constexpr int sequence_length = 2;
+
+  OpTester tester("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", kNumHeads);
+  tester.AddAttribute<int64_t>("kv_num_heads", kKvNumHeads);
+  tester.AddAttribute<int64_t>("kv_cache_bit_width", kv_cache_bit_width);
+
+  tester.AddInput<float>("query", {1, sequence_length, kNumHeads * kHeadSize},
+                         std::vector<float>(sequence_length * kNumHeads * kHeadSize));
+  tester.AddInput<float>("key", {1, sequence_length, kKvNumHeads * kHeadSize},
+                         std::vector<float>(sequence_length * kKvNumHeads * kHeadSize));
+  tester.AddInput<float>("value", {1, sequence_length, kKvNumHeads * kHeadSize},
+                         std::vector<float>(sequence_length * kKvNumHeads * kHeadSize));
+  tester.AddOptionalInputEdge<TCache>();
+  tester.AddOptionalInputEdge<TCache>();
+  tester.AddInput<int32_t>("seqlens_k", {1}, {sequence_length - 1});
+  tester.AddInput<int32_t>("total_sequence_length", {1}, {sequence_length});
+
+  const std::vector<TCache> present(sequence_length * kKvNumHeads * kHeadSize);
+  tester.AddOutput<float>("output", {1, sequence_length, kNumHeads * kHeadSize},
+                          std::vector<float>(sequence_length * kNumHeads * kHeadSize));
+  tester.AddOutput<TCache>("present_key", {1, kKvNumHeads, sequence_length, kHeadSize}, present);
+  tester.AddOutput<TCache>("present_value", {1, kKvNumHeads, sequence_length, kHeadSize}, present);
+
+  Graph& graph = tester.BuildModel().MainGraph();
+  EXPECT_STATUS_OK(graph.Resolve());
+
+  auto dml_ep = DefaultDmlExecutionProvider();
+  const OpSchemaKernelTypeStrResolver kernel_type_str_resolver{};
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "GroupQueryAttention") {
+      return KernelRegistry::HasImplementationOf(*dml_ep->GetKernelRegistry(), node, dml_ep->Type(),
+                                                 kernel_type_str_resolver, DefaultLoggingManager().DefaultLogger());
+    }
+  }
+
+  ADD_FAILURE() << "GroupQueryAttention node not found";
+  return false;
+}
+#endif
+
+}  // namespace
+
+TEST(GroupQueryAttentionTest, QuantizedKVCache_Prompt) {
+  RunQuantizedKVCacheTest(0, 3);
+}
+
+TEST(GroupQueryAttentionTest, QuantizedKVCache_TokenGeneration) {
+  RunQuantizedKVCacheTest(3, 1);
+}
+
+#if defined(USE_DML)
+// The DML kernel only takes a float KV cache, so a model with an int8 cache must be left to the CPU provider.
+TEST(GroupQueryAttentionTest, QuantizedKVCache_NotAssignedToDml) {
+  EXPECT_TRUE(DmlHasGroupQueryAttentionKernel<float>(0));
+  EXPECT_FALSE(DmlHasGroupQueryAttentionKernel<int8_t>(8));
+}
+#endif
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -428,6 +428,60 @@ TEST(LayerNormTest, LayerNorm17_double) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kDnnlExecutionProvider});
 }
 
+// Rows longer than the MLAS block size, with a large common offset so that the variance has to be computed from
+// deviations about the mean rather than from the difference of large sums.
+TEST(LayerNormTest, LayerNorm17_LongRow_MeanInvStdDev) {
+  constexpr int64_t num_rows = 3;
+  constexpr int64_t norm_size = 601;
+  const std::vector<int64_t> dims{num_rows, norm_size};
+
+  RandomValueGenerator random{};
+  std::vector<float> x = random.Uniform<float>(dims, -1.0f, 1.0f);
+  for (auto& value : x) {
+    value += 1000.0f;
+  }
+  const std::vector<float> gamma = random.Uniform<float>({norm_size}, -1.0f, 1.0f);
+  const std::vector<float> beta = random.Uniform<float>({norm_size}, -1.0f, 1.0f);
+  constexpr float epsilon = 1e-05f;
+
+  std::vector<float> y(x.size());
+  std::vector<float> mean(num_rows);
+  std::vector<float> inv_std_dev(num_rows);
+  for (int64_t r = 0; r < num_rows; ++r) {
+    const float* row = x.data() + r * norm_size;
+    double sum = 0.0;
+    for (int64_t i = 0; i < norm_size; ++i) {
+      sum += row[i];
+    }
+    const double row_mean = sum / norm_size;
+    double sum_squares = 0.0;
+    for (int64_t i = 0; i < norm_size; ++i) {
+      sum_squares += (row[i] - row_mean) * (row[i] - row_mean);
+    }
+    const double row_inv_std_dev = 1.0 / std::sqrt(sum_squares / norm_size + epsilon);
+    for (int64_t i = 0; i < norm_size; ++i) {
+      y[r * norm_size + i] = static_cast<float>((row[i] - row_mean) * row_inv_std_dev * gamma[i] + beta[i]);
+    }
+    mean[r] = static_cast<float>(row_mean);
+    inv_std_dev[r] = static_cast<float>(row_inv_std_dev);
+  }
+
+  OpTester test("LayerNormalization", 17);
+  test.AddAttribute<int64_t>("axis", -1);
+  test.AddAttribute<float>("epsilon", epsilon);
+  test.AddInput<float>("x", dims, x);
+  test.AddInput<float>("gamma", {norm_size}, gamma);
+  test.AddInput<float>("beta", {norm_size}, beta);
+  test.AddOutput<float>("output", dims, y);
+  test.AddOutput<float>("mean", {num_rows, 1}, mean);
+  test.AddOutput<float>("inv_std_dev", {num_rows, 1}, inv_std_dev);
+  test.SetOutputTolerance(0.005f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 // Test normalize size shall be larger than 1.
 TEST(LayerNormTest, LayerNorm_InvalidNormSize) {
   OpTester test("LayerNormalization");
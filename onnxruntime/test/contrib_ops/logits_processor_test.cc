@@ -0,0 +1,163 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "contrib_ops/cpu/transformers/logits_processor.h"
+#include "contrib_ops/cpu/transformers/sequences.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::ISequences;
+using contrib::transformers::NextTokenScores;
+using contrib::transformers::NoRepeatNGramLogitsProcessor;
+using contrib::transformers::RepetitionPenaltyLogitsProcessor;
+using contrib::transformers::Sequences;
+
+namespace {
+
+constexpr int kVocabSize = 6;
+
+// Sequences of batch_beam_size rows, initialized with the given prompt rows.
+struct TestSequences {
+  TestSequences(const std::vector<std::vector<int32_t>>& prompts, int max_length)
+      : buffer(2 * prompts.size() * max_length, -1) {
+    for (size_t i = 0; i < prompts.size(); i++) {
+      std::copy(prompts[i].begin(), prompts[i].end(), buffer.begin() + i * max_length);
+    }
+    sequences.Init(buffer, static_cast<int>(prompts.size()), static_cast<int>(prompts[0].size()), max_length);
+  }
+
+  std::vector<int32_t> buffer;
+  Sequences sequences;
+};
+
+std::vector<float> RandomScores(std::mt19937& rng, int batch_beam_size) {
+  std::uniform_real_distribution<float> dist(-4.0f, 4.0f);
+  std::vector<float> scores(static_cast<size_t>(batch_beam_size) * kVocabSize);
+  for (auto& score : scores) {
+    score = dist(rng);
+  }
+  return scores;
+}
+
+// Scalar reference: ban the last word of every N-gram whose first ngram_size - 1 words match the end of sequence.
+void ReferenceNoRepeatNGram(const ISequences& sequences, int ngram_size, int batch_beam_size,
+                            std::vector<float>& scores) {
+  const int length = sequences.GetSequenceLength();
+  for (int i = 0; i < batch_beam_size; i++) {
+    gsl::span<const int32_t> sequence = sequences.GetSequence(i);
+    for (int j = 0; j <= length - ngram_size; j++) {
+      bool match = true;
+      for (int k = 0; k < ngram_size - 1; k++) {
+        if (sequence[j + k] != sequence[length - ngram_size + 1 + k]) {
+          match = false;
+          break;
+        }
+      }
+      if (match) {
+        scores[static_cast<size_t>(i) * kVocabSize + sequence[j + ngram_size - 1]] =
+            std::numeric_limits<float>::lowest();
+      }
+    }
+  }
+}
+
+// Scalar reference: each distinct word in the sequence is penalized once.
+void ReferenceRepetitionPenalty(const ISequences& sequences, float penalty, int batch_beam_size,
+                                std::vector<float>& scores) {
+  for (int i = 0; i < batch_beam_size; i++) {
+    gsl::span<const int32_t> sequence = sequences.GetSequence(i);
+    std::set<int32_t> words(sequence.begin(), sequence.end());
+    for (const int32_t word : words) {
+      float& score = scores[static_cast<size_t>(i) * kVocabSize + word];
+      score = score < 0 ? score * penalty : score / penalty;
+    }
+  }
+}
+
+// Run the N-gram processor over a number of steps. When fork_beams is true, each step selects the beams to extend
+// from the previous step like beam search does, including selecting one beam several times.
+void RunNoRepeatNGram(int ngram_size, bool fork_beams) {
+  std::mt19937 rng(ngram_size * 2 + (fork_beams ? 1 : 0));
+  std::uniform_int_distribution<int32_t> word_dist(0, 2);
+  std::uniform_int_distribution<int32_t> beam_dist(0, 2);
+
+  constexpr int batch_beam_size = 3;
+  constexpr int max_length = 24;
+  // Prompts with repeated and overlapping N-grams, e.g. (1, 2, 1) twice in 1, 2, 1, 2, 1.
+  TestSequences test_sequences({{1, 2, 1, 2, 1}, {0, 0, 0, 0, 0}, {3, 1, 3, 1, 3}}, max_length);
+  Sequences& sequences = test_sequences.sequences;
+
+  NoRepeatNGramLogitsProcessor<float> processor(ngram_size);
+  for (int step = 0; sequences.GetSequenceLength() < max_length; step++) {
+    std::vector<float> scores = RandomScores(rng, batch_beam_size);
+    std::vector<float> expected = scores;
+    ReferenceNoRepeatNGram(sequences, ngram_size, batch_beam_size, expected);
+
+    gsl::span<float> scores_span(scores);
+    NextTokenScores<float> next_token_scores{scores_span, batch_beam_size, kVocabSize};
+    processor.Process(&sequences, next_token_scores);
+    ASSERT_EQ(expected, scores) << "ngram_size=" << ngram_size << " step=" << step;
+
+    std::vector<int32_t> next_tokens(batch_beam_size);
+    std::vector<int32_t> beam_indices(batch_beam_size);
+    for (int i = 0; i < batch_beam_size; i++) {
+      next_tokens[i] = word_dist(rng);
+      beam_indices[i] = fork_beams ? beam_dist(rng) : i;
+    }
+    gsl::span<int32_t> next_tokens_span(next_tokens);
+    gsl::span<int32_t> beam_indices_span(beam_indices);
+    if (fork_beams) {
+      sequences.AppendNextTokenToSequences(beam_indices_span, next_tokens_span);
+    } else {
+      sequences.AppendNextTokenToSequences(next_tokens_span);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(LogitsProcessorTest, NoRepeatNGram) {
+  for (int ngram_size : {1, 2, 3, 4}) {
+    RunNoRepeatNGram(ngram_size, false);
+  }
+}
+
+TEST(LogitsProcessorTest, NoRepeatNGram_ForkedBeams) {
+  for (int ngram_size : {2, 3, 4}) {
+    RunNoRepeatNGram(ngram_size, true);
+  }
+}
+
+TEST(LogitsProcessorTest, RepetitionPenalty_RepeatedWords) {
+  constexpr int batch_beam_size = 2;
+  TestSequences test_sequences({{1, 1, 4, 1, 4, 2}, {5, 5, 5, 5, 0, 5}}, 8);
+
+  std::vector<float> scores{-2.0f, 3.0f, -1.5f, 0.5f, 2.0f, -4.0f,
+                            1.0f, 3.0f, -1.5f, 0.5f, 2.0f, 4.0f};
+  std::vector<float> expected = scores;
+  ReferenceRepetitionPenalty(test_sequences.sequences, 2.0f, batch_beam_size, expected);
+  // Words 1, 2 and 4 of the first row and words 0 and 5 of the second row are penalized exactly once.
+  ASSERT_EQ(expected, (std::vector<float>{-2.0f, 1.5f, -3.0f, 0.5f, 1.0f, -4.0f,
+                                          0.5f, 3.0f, -1.5f, 0.5f, 2.0f, 2.0f}));
+
+  RepetitionPenaltyLogitsProcessor<float> processor(2.0f);
+  for (int step = 0; step < 2; step++) {
+    // The processor keeps state between calls, so run it twice on fresh scores.
+    std::vector<float> step_scores = scores;
+    gsl::span<float> scores_span(step_scores);
+    NextTokenScores<float> next_token_scores{scores_span, batch_beam_size, kVocabSize};
+    processor.Process(&test_sequences.sequences, next_token_scores);
+    ASSERT_EQ(expected, step_scores);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <random>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::vector<float> RandomData(size_t size, std::mt19937& generator) {
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = distribution(generator);
+  }
+  return data;
+}
+
+// Y[b] = A[b] * B + alpha * (A[b] * lora_a[id]) * lora_b[id], computed row by row.
+std::vector<float> ReferenceMultiLoRAMatMul(const std::vector<float>& a, const std::vector<float>& b,
+                                            const std::vector<float>& lora_a, const std::vector<float>& lora_b,
+                                            const std::vector<int32_t>& adapter_ids, int64_t rows_per_batch,
+                                            int64_t K, int64_t N, int64_t rank, float alpha) {
+  const int64_t batch_size = static_cast<int64_t>(adapter_ids.size());
+  std::vector<float> y(static_cast<size_t>(batch_size * rows_per_batch * N), 0.0f);
+  for (int64_t batch = 0; batch < batch_size; batch++) {
+    const int32_t id = adapter_ids[static_cast<size_t>(batch)];
+    for (int64_t row = batch * rows_per_batch; row < (batch + 1) * rows_per_batch; row++) {
+      std::vector<float> shrunk(static_cast<size_t>(rank), 0.0f);
+      if (id >= 0) {
+        for (int64_t j = 0; j < rank; j++) {
+          for (int64_t k = 0; k < K; k++) {
+            shrunk[j] += a[row * K + k] * lora_a[(id * K + k) * rank + j];
+          }
+        }
+      }
+      for (int64_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < K; k++) {
+          sum += a[row * K + k] * b[k * N + n];
+        }
+        if (id >= 0) {
+          for (int64_t j = 0; j < rank; j++) {
+            sum += alpha * shrunk[j] * lora_b[(id * rank + j) * N + n];
+          }
+        }
+        y[row * N + n] = sum;
+      }
+    }
+  }
+  return y;
+}
+
+void RunMultiLoRAMatMulTest(const std::vector<int32_t>& adapter_ids, int64_t sequence_length, int64_t K, int64_t N,
+                            int64_t num_adapters, int64_t rank, float alpha) {
+  std::mt19937 generator(123);
+  const int64_t batch_size = static_cast<int64_t>(adapter_ids.size());
+  const auto a = RandomData(static_cast<size_t>(batch_size * sequence_length * K), generator);
+  const auto b = RandomData(static_cast<size_t>(K * N), generator);
+  const auto lora_a = RandomData(static_cast<size_t>(num_adapters * K * rank), generator);
+  const auto lora_b = RandomData(static_cast<size_t>(num_adapters * rank * N), generator);
+  const auto y = ReferenceMultiLoRAMatMul(a, b, lora_a, lora_b, adapter_ids, sequence_length, K, N, rank, alpha);
+
+  OpTester test("MultiLoRAMatMul", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<float>("alpha", alpha);
+  test.AddInput<float>("A", {batch_size, sequence_length, K}, a);
+  test.AddInput<float>("B", {K, N}, b);
+  test.AddInput<float>("lora_a", {num_adapters, K, rank}, lora_a);
+  test.AddInput<float>("lora_b", {num_adapters, rank, N}, lora_b);
+  test.AddInput<int32_t>("adapter_ids", {batch_size}, adapter_ids);
+  test.AddOutput<float>("Y", {batch_size, sequence_length, N}, y);
+  test.SetOutputAbsErr("Y", 1e-4f);
+  test.Run();
+}
+
+}  // namespace
+
+TEST(MultiLoRAMatMulTest, SameAdapter) {
+  RunMultiLoRAMatMulTest({1, 1, 1}, 2, 16, 8, 2, 4, 1.0f);
+}
+
+TEST(MultiLoRAMatMulTest, SortedAdapters) {
+  RunMultiLoRAMatMulTest({0, 0, 1, 2, 2}, 3, 16, 12, 3, 4, 0.5f);
+}
+
+TEST(MultiLoRAMatMulTest, InterleavedAdaptersAndBaseOnly) {
+  RunMultiLoRAMatMulTest({2, -1, 0, 2, 1, -1, 0}, 3, 20, 10, 3, 2, 2.0f);
+}
+
+TEST(MultiLoRAMatMulTest, NoAdapter) {
+  RunMultiLoRAMatMulTest({-1, -1}, 1, 8, 8, 2, 4, 1.0f);
+}
+
+TEST(MultiLoRAMatMulTest, InvalidAdapterId) {
+  OpTester test("MultiLoRAMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {1, 1, 2}, {1.0f, 2.0f});
+  test.AddInput<float>("B", {2, 1}, {1.0f, 1.0f});
+  test.AddInput<float>("lora_a", {1, 2, 1}, {1.0f, 1.0f});
+  test.AddInput<float>("lora_b", {1, 1, 1}, {1.0f});
+  test.AddInput<int32_t>("adapter_ids", {1}, {1});
+  test.AddOutput<float>("Y", {1, 1, 1}, {0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "adapter_ids shall be less than number of adapters");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -658,6 +658,76 @@ TEST(MultiHeadAttentionTest, SelfAttention_WithPastAndPresent_NoMask_NoRelPosBia
   RunMultiHeadAttentionTests(data, DISABLE_CUDA);
 }
 
+TEST(MultiHeadAttentionTest, CrossAttention_KeyValueSharedByBeams) {
+  // Cross attention key and value in BNSH format with batch size 1 are shared by 2 beams of query.
+  constexpr int kv_batch_size = 1;
+  constexpr int num_beams = 2;
+  constexpr int num_heads = 2;
+  constexpr int head_size = 4;
+  constexpr int sequence_length = 1;
+  constexpr int kv_sequence_length = 3;
+  constexpr int hidden_size = num_heads * head_size;
+  constexpr int batch_size = kv_batch_size * num_beams;
+
+  std::vector<float> query(batch_size * sequence_length * hidden_size);
+  std::vector<float> key(kv_batch_size * num_heads * kv_sequence_length * head_size);
+  std::vector<float> value(key.size());
+  for (size_t i = 0; i < query.size(); i++) {
+    query[i] = static_cast<float>(static_cast<int>(i * 7 % 11) - 5) * 0.1f;
+  }
+  for (size_t i = 0; i < key.size(); i++) {
+    key[i] = static_cast<float>(static_cast<int>(i * 5 % 13) - 6) * 0.1f;
+    value[i] = static_cast<float>(static_cast<int>(i * 3 % 7) - 3) * 0.2f;
+  }
+
+  // Reference: softmax(Q K^T / sqrt(head_size)) V, where each beam uses the key and value of its batch.
+  std::vector<float> output(batch_size * sequence_length * hidden_size);
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (int b = 0; b < batch_size; b++) {
+    const int kv_b = b / num_beams;
+    for (int n = 0; n < num_heads; n++) {
+      for (int s = 0; s < sequence_length; s++) {
+        const float* q = query.data() + (b * sequence_length + s) * hidden_size + n * head_size;
+        std::vector<float> probs(kv_sequence_length);
+        float max_value = std::numeric_limits<float>::lowest();
+        for (int l = 0; l < kv_sequence_length; l++) {
+          const float* k = key.data() + ((kv_b * num_heads + n) * kv_sequence_length + l) * head_size;
+          float dot = 0.0f;
+          for (int h = 0; h < head_size; h++) {
+            dot += q[h] * k[h];
+          }
+          probs[l] = dot * scale;
+          max_value = std::max(max_value, probs[l]);
+        }
+        float sum = 0.0f;
+        for (int l = 0; l < kv_sequence_length; l++) {
+          probs[l] = std::exp(probs[l] - max_value);
+          sum += probs[l];
+        }
+        float* out = output.data() + (b * sequence_length + s) * hidden_size + n * head_size;
+        for (int h = 0; h < head_size; h++) {
+          float result = 0.0f;
+          for (int l = 0; l < kv_sequence_length; l++) {
+            result += probs[l] / sum * value[((kv_b * num_heads + n) * kv_sequence_length + l) * head_size + h];
+          }
+          out[h] = result;
+        }
+      }
+    }
+  }
+
+  OpTester tester("MultiHeadAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(num_heads));
+  tester.AddInput<float>("query", {batch_size, sequence_length, hidden_size}, query);
+  tester.AddInput<float>("key", {kv_batch_size, num_heads, kv_sequence_length, head_size}, key);
+  tester.AddInput<float>("value", {kv_batch_size, num_heads, kv_sequence_length, head_size}, value);
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output, /*sort*/ false, 0.0f, 1e-5f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 // This test is disabled since it is not used in Whisper anymore, and it fails in ROCm.
 TEST(MultiHeadAttentionTest, DISABLED_CrossAttention_WithPastPassedInDirectly_NoMask) {
   // Whisper decoder cross attention with past_kv in place of current KV and no present_kv
@@ -0,0 +1,540 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//
+// Test module for NHWC fp32 operators
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "core/util/math.h"
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+size_t ShapeSize(const std::vector<int64_t>& shape) {
+  return static_cast<size_t>(std::accumulate(shape.cbegin(), shape.cend(), 1LL, std::multiplies<int64_t>()));
+}
+
+bool NextPosition(int64_t N, const int64_t* shape, int64_t* dims) {
+  // Loop over spatial axes in reverse order to choose an index, like counting.
+  bool incremented = false;
+  for (int64_t d_i = N - 1; d_i >= 0; --d_i) {
+    int64_t d_max = shape[d_i];
+    ORT_ENFORCE(dims[d_i] < d_max);
+    if (dims[d_i] == d_max - 1) {
+      dims[d_i] = 0;
+    } else {  // dims[d_i] < d_max - 1
+      ++dims[d_i];
+      incremented = true;
+      break;
+    }
+  }
+  return incremented;
+}
+
+std::vector<float> GenerateData(size_t size, size_t seed) {
+  std::vector<float> data(size);
+  size_t offset = seed;
+  for (size_t n = 0; n < size; n++) {
+    offset = (offset + 31) % 47;
+    data[n] = (static_cast<float>(offset) - 23.0f) / 16.0f;
+  }
+  return data;
+}
+
+void RunOnCpu(OpTester& test) {
+  // Other execution providers may register their own channels last kernels.
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+class NhwcFp32PoolOpTester {
+ private:
+  bool is_max_pool_;  // max or average pool
+  bool count_include_pad_{false};
+  std::vector<float> X_data_;
+  std::vector<int64_t> X_shape_;
+  std::vector<int64_t> kernel_shape_;
+  std::vector<int64_t> pads_;
+  std::vector<int64_t> strides_;
+  std::vector<int64_t> dilations_;
+
+  void ComputeExpectedOutput(std::vector<float>& Y_data, std::vector<int64_t>& Y_shape) {
+    const size_t kernel_rank = kernel_shape_.size();
+
+    const int64_t batch_count = X_shape_[0];
+    const int64_t channels = X_shape_[X_shape_.size() - 1];
+
+    std::vector<int64_t> pads(pads_);
+    if (pads.empty()) {
+      pads.resize(kernel_rank * 2, 0);
+    }
+    std::vector<int64_t> dilations(dilations_);
+    if (dilations.empty()) {
+      dilations.resize(kernel_rank, 1);
+    }
+    std::vector<int64_t> strides(strides_);
+    if (strides.empty()) {
+      strides.resize(kernel_rank, 1);
+    }
+
+    const int64_t* input_shape = X_shape_.data() + 1;
+
+    Y_shape.push_back(batch_count);
+    for (size_t n = 0; n < kernel_rank; n++) {
+      Y_shape.push_back(((input_shape[n] + pads[n] + pads[kernel_rank + n]) -
+                         (dilations[n] * (kernel_shape_[n] - 1) + 1)) /
+                            strides[n] +
+                        1);
+    }
+    Y_shape.push_back(channels);
+    Y_data.resize(ShapeSize(Y_shape));
+
+    const int64_t* output_shape = Y_shape.data() + 1;
+    const int64_t input_image_size = std::accumulate(
+        input_shape, input_shape + kernel_rank, 1LL, std::multiplies<int64_t>());
+
+    const float* Xdata = X_data_.data();
+    float* Ydata = Y_data.data();
+
+    for (int64_t batch = 0; batch < batch_count; batch++) {
+      std::vector<int64_t> d_output(kernel_rank, 0);
+      std::vector<int64_t> d_kernel(kernel_rank, 0);
+      do {
+        std::vector<float> accs(channels, is_max_pool_ ? std::numeric_limits<float>::lowest() : 0.f);
+        size_t cnt = 0;
+        do {
+          int64_t input_offset = 0;
+          bool is_padding = false;
+          for (size_t axis = 0; axis < kernel_rank; ++axis) {
+            int64_t input_dim = d_kernel[axis] * dilations[axis] + d_output[axis] * strides[axis] - pads[axis];
+            is_padding |= !math::is_a_ge_zero_and_a_lt_b(input_dim, input_shape[axis]);
+            input_offset *= input_shape[axis];
+            input_offset += input_dim;
+          }
+          if (!is_padding) {
+            const float* data_ptr = Xdata + input_offset * channels;
+            cnt++;
+            for (int64_t c = 0; c < channels; c++) {
+              if (is_max_pool_) {
+                accs[c] = std::max(accs[c], data_ptr[c]);
+              } else {
+                accs[c] += data_ptr[c];
+              }
+            }
+          } else if (count_include_pad_) {
+            cnt++;
+          }
+        } while (NextPosition(kernel_rank, kernel_shape_.data(), d_kernel.data()));
+        for (int64_t c = 0; c < channels; c++) {
+          Ydata[c] = is_max_pool_ ? accs[c] : accs[c] / cnt;
+        }
+        Ydata += channels;
+      } while (NextPosition(kernel_rank, output_shape, d_output.data()));
+      Xdata += channels * input_image_size;
+    }
+  }
+
+ public:
+  NhwcFp32PoolOpTester(bool is_max_pool) : is_max_pool_(is_max_pool) {
+  }
+
+  void GenerateRandomInput(const std::vector<int64_t>& shape) {
+    X_data_ = GenerateData(ShapeSize(shape), 7);
+    X_shape_ = shape;
+  }
+
+  void SetKernelShape(const std::vector<int64_t>& kernel_shape) {
+    kernel_shape_ = kernel_shape;
+  }
+
+  void SetPads(const std::vector<int64_t>& pads) {
+    pads_ = pads;
+  }
+
+  void SetStrides(const std::vector<int64_t>& strides) {
+    strides_ = strides;
+  }
+
+  void SetDilations(const std::vector<int64_t>& dilations) {
+    dilations_ = dilations;
+  }
+
+  void SetCountIncludePad(bool count_include_pad) {
+    count_include_pad_ = count_include_pad;
+  }
+
+  void Run() {
+    std::vector<float> Y_data;
+    std::vector<int64_t> Y_shape;
+    ComputeExpectedOutput(Y_data, Y_shape);
+
+    OpTester test(is_max_pool_ ? "MaxPool" : "AveragePool", is_max_pool_ ? 12 : 11, onnxruntime::kMSInternalNHWCDomain);
+    test.AddInput<float>("x", X_shape_, X_data_);
+    test.AddOutput<float>("y", Y_shape, Y_data);
+    test.AddAttribute("kernel_shape", kernel_shape_);
+    if (!pads_.empty()) {
+      test.AddAttribute("pads", pads_);
+    }
+    if (!strides_.empty()) {
+      test.AddAttribute("strides", strides_);
+    }
+    if (!dilations_.empty()) {
+      test.AddAttribute("dilations", dilations_);
+    }
+    if (count_include_pad_) {
+      test.AddAttribute<int64_t>("count_include_pad", 1);
+    }
+    RunOnCpu(test);
+  }
+};
+
+TEST(NhwcFp32PoolOpTest, MaxPool1D) {
+  for (int64_t channels = 1; channels < 40; channels++) {
+    NhwcFp32PoolOpTester test(true);
+    test.GenerateRandomInput({1, 23, channels});
+    test.SetKernelShape({5});
+    test.SetPads({2, 2});
+    test.Run();
+  }
+}
+
+TEST(NhwcFp32PoolOpTest, MaxPool2D) {
+  for (int64_t channels = 1; channels < 40; channels++) {
+    NhwcFp32PoolOpTester test(true);
+    test.GenerateRandomInput({1, 15, 19, channels});
+    test.SetKernelShape({3, 5});
+    test.SetPads({1, 1, 1, 1});
+    test.Run();
+  }
+}
+
+TEST(NhwcFp32PoolOpTest, MaxPoolStridesDilations) {
+  NhwcFp32PoolOpTester test(true);
+  test.GenerateRandomInput({2, 23, 19, 17});
+  test.SetKernelShape({3, 3});
+  test.SetStrides({2, 2});
+  test.SetDilations({2, 1});
+  test.Run();
+}
+
+TEST(NhwcFp32PoolOpTest, AvgPool2D) {
+  for (int64_t channels = 1; channels < 40; channels++) {
+    NhwcFp32PoolOpTester test(false);
+    test.GenerateRandomInput({1, 15, 19, channels});
+    test.SetKernelShape({3, 5});
+    test.SetPads({1, 1, 1, 1});
+    test.Run();
+  }
+}
+
+TEST(NhwcFp32PoolOpTest, AvgPoolIncludePad) {
+  NhwcFp32PoolOpTester test(false);
+  test.GenerateRandomInput({1, 13, 11, 21});
+  test.SetKernelShape({3, 3});
+  test.SetPads({1, 1, 1, 1});
+  test.SetCountIncludePad(true);
+  test.Run();
+}
+
+TEST(NhwcFp32PoolOpTest, AvgPool3D) {
+  NhwcFp32PoolOpTester test(false);
+  test.GenerateRandomInput({1, 9, 13, 11, 18});
+  test.SetKernelShape({2, 3, 3});
+  test.SetPads({0, 1, 1, 1, 1, 1});
+  test.Run();
+}
+
+TEST(NhwcFp32PoolOpTest, GlobalAveragePool) {
+  const std::vector<int64_t> X_shape{2, 7, 5, 19};
+  const std::vector<float> X_data = GenerateData(ShapeSize(X_shape), 3);
+  std::vector<float> Y_data(2 * 19, 0.f);
+  for (int64_t n = 0; n < 2; n++) {
+    for (int64_t p = 0; p < 35; p++) {
+      for (int64_t c = 0; c < 19; c++) {
+        Y_data[n * 19 + c] += X_data[(n * 35 + p) * 19 + c] / 35.f;
+      }
+    }
+  }
+
+  OpTester test("GlobalAveragePool", 1, onnxruntime::kMSInternalNHWCDomain);
+  test.AddInput<float>("x", X_shape, X_data);
+  test.AddOutput<float>("y", {2, 1, 1, 19}, Y_data);
+  RunOnCpu(test);
+}
+
+class NhwcFp32ConvOpTester {
+ private:
+  std::vector<int64_t> X_shape_;  // N x H x W x C
+  int64_t output_channels_{1};
+  int64_t group_{1};
+  std::vector<int64_t> kernel_shape_;
+  std::vector<int64_t> pads_;
+  std::vector<int64_t> strides_;
+  std::vector<int64_t> dilations_;
+  bool has_bias_{false};
+  bool has_sum_{false};
+  std::string activation_;
+
+  // Direct convolution of channels last X with an OIHW filter, plus the bias.
+  void ComputeExpectedOutput(const std::vector<float>& X_data,
+                             const std::vector<float>& W_data,
+                             const std::vector<float>& B_data,
+                             const std::vector<int64_t>& pads,
+                             const std::vector<int64_t>& strides,
+                             const std::vector<int64_t>& dilations,
+                             std::vector<float>& Y_data,
+                             std::vector<int64_t>& Y_shape) const {
+    const size_t kernel_rank = kernel_shape_.size();
+    const int64_t batch_count = X_shape_[0];
+    const int64_t input_channels = X_shape_.back();
+    const int64_t group_input_channels = input_channels / group_;
+    const int64_t group_output_channels = output_channels_ / group_;
+    const int64_t* input_shape = X_shape_.data() + 1;
+    const int64_t kernel_size = static_cast<int64_t>(ShapeSize(kernel_shape_));
+
+    Y_shape.push_back(batch_count);
+    for (size_t n = 0; n < kernel_rank; n++) {
+      Y_shape.push_back(((input_shape[n] + pads[n] + pads[kernel_rank + n]) -
+                         (dilations[n] * (kernel_shape_[n] - 1) + 1)) /
+                            strides[n] +
+                        1);
+    }
+    Y_shape.push_back(output_channels_);
+    Y_data.resize(ShapeSize(Y_shape));
+
+    const int64_t* output_shape = Y_shape.data() + 1;
+    const int64_t input_image_size = std::accumulate(
+        input_shape, input_shape + kernel_rank, 1LL, std::multiplies<int64_t>());
+
+    float* Ydata = Y_data.data();
+    for (int64_t batch = 0; batch < batch_count; batch++) {
+      const float* Xdata = X_data.data() + batch * input_image_size * input_channels;
+      std::vector<int64_t> d_output(kernel_rank, 0);
+      do {
+        for (int64_t oc = 0; oc < output_channels_; oc++) {
+          const int64_t group_id = oc / group_output_channels;
+          float acc = has_bias_ ? B_data[oc] : 0.f;
+          std::vector<int64_t> d_kernel(kernel_rank, 0);
+          int64_t kernel_index = 0;
+          do {
+            int64_t input_offset = 0;
+            bool is_padding = false;
+            for (size_t axis = 0; axis < kernel_rank; ++axis) {
+              int64_t input_dim = d_kernel[axis] * dilations[axis] + d_output[axis] * strides[axis] - pads[axis];
+              is_padding |= !math::is_a_ge_zero_and_a_lt_b(input_dim, input_shape[axis]);
+              input_offset *= input_shape[axis];
+              input_offset += input_dim;
+            }
+            if (!is_padding) {
+              for (int64_t ic = 0; ic < group_input_channels; ic++) {
+                acc += Xdata[input_offset * input_channels + group_id * group_input_channels + ic] *
+                       W_data[(oc * group_input_channels + ic) * kernel_size + kernel_index];
+              }
+            }
+            kernel_index++;
+          } while (NextPosition(kernel_rank, kernel_shape_.data(), d_kernel.data()));
+          Ydata[oc] = acc;
+        }
+        Ydata += output_channels_;
+      } while (NextPosition(kernel_rank, output_shape, d_output.data()));
+    }
+  }
+
+ public:
+  NhwcFp32ConvOpTester(const std::vector<int64_t>& X_shape, int64_t output_channels,
+                       const std::vector<int64_t>& kernel_shape, int64_t group = 1)
+      : X_shape_(X_shape), output_channels_(output_channels), group_(group), kernel_shape_(kernel_shape) {
+  }
+
+  void SetPads(const std::vector<int64_t>& pads) {
+    pads_ = pads;
+  }
+
+  void SetStrides(const std::vector<int64_t>& strides) {
+    strides_ = strides;
+  }
+
+  void SetDilations(const std::vector<int64_t>& dilations) {
+    dilations_ = dilations;
+  }
+
+  void SetBias(bool has_bias) {
+    has_bias_ = has_bias;
+  }
+
+  void SetSum(bool has_sum) {
+    has_sum_ = has_sum;
+  }
+
+  void SetActivation(const std::string& activation) {
+    activation_ = activation;
+  }
+
+  void Run(bool weight_is_initializer) {
+    const size_t kernel_rank = kernel_shape_.size();
+    std::vector<int64_t> pads(pads_);
+    if (pads.empty()) {
+      pads.resize(kernel_rank * 2, 0);
+    }
+    std::vector<int64_t> dilations(dilations_);
+    if (dilations.empty()) {
+      dilations.resize(kernel_rank, 1);
+    }
+    std::vector<int64_t> strides(strides_);
+    if (strides.empty()) {
+      strides.resize(kernel_rank, 1);
+    }
+
+    std::vector<int64_t> W_shape{output_channels_, X_shape_.back() / group_};
+    W_shape.insert(W_shape.end(), kernel_shape_.begin(), kernel_shape_.end());
+
+    const std::vector<float> X_data = GenerateData(ShapeSize(X_shape_), 7);
+    const std::vector<float> W_data = GenerateData(ShapeSize(W_shape), 11);
+    const std::vector<float> B_data = GenerateData(static_cast<size_t>(output_channels_), 13);
+
+    std::vector<float> Y_data;
+    std::vector<int64_t> Y_shape;
+    ComputeExpectedOutput(X_data, W_data, B_data, pads, strides, dilations, Y_data, Y_shape);
+
+    // The fused Add happens before the activation.
+    std::vector<float> Z_data;
+    if (has_sum_) {
+      Z_data = GenerateData(Y_data.size(), 17);
+      for (size_t i = 0; i < Y_data.size(); i++) {
+        Y_data[i] += Z_data[i];
+      }
+    }
+    if (activation_ == "Relu") {
+      for (auto& y : Y_data) {
+        y = std::max(y, 0.f);
+      }
+    }
+
+    OpTester test("NhwcFusedConv", 1, onnxruntime::kMSDomain);
+    test.AddAttribute("group", group_);
+    test.AddAttribute("kernel_shape", kernel_shape_);
+    test.AddAttribute("pads", pads);
+    test.AddAttribute("strides", strides);
+    test.AddAttribute("dilations", dilations);
+    if (!activation_.empty()) {
+      test.AddAttribute("activation", activation_);
+    }
+
+    test.AddInput<float>("X", X_shape_, X_data);
+    test.AddInput<float>("W", W_shape, W_data, weight_is_initializer);
+    if (has_bias_ || has_sum_) {
+      test.AddInput<float>("B", {output_channels_}, has_bias_ ? B_data : std::vector<float>(output_channels_, 0.f));
+    }
+    if (has_sum_) {
+      test.AddInput<float>("Z", Y_shape, Z_data);
+    }
+    test.AddOutput<float>("Y", Y_shape, Y_data, /*sort_output*/ false, 1e-4f, 1e-4f);
+    RunOnCpu(test);
+  }
+};
+
+TEST(NhwcFp32ConvOpTest, Conv2D) {
+  for (bool weight_is_initializer : {false, true}) {
+    NhwcFp32ConvOpTester test({2, 9, 11, 7}, 13, {3, 3});
+    test.SetPads({1, 1, 1, 1});
+    test.SetBias(true);
+    test.Run(weight_is_initializer);
+  }
+}
+
+TEST(NhwcFp32ConvOpTest, Conv2DStridesDilations) {
+  NhwcFp32ConvOpTester test({1, 17, 15, 5}, 8, {3, 2});
+  test.SetPads({0, 1, 2, 0});
+  test.SetStrides({2, 1});
+  test.SetDilations({1, 2});
+  test.Run(true);
+}
+
+TEST(NhwcFp32ConvOpTest, Conv2DGroup) {
+  NhwcFp32ConvOpTester test({1, 8, 8, 12}, 6, {3, 3}, 3);
+  test.SetPads({1, 1, 1, 1});
+  test.SetBias(true);
+  test.Run(true);
+}
+
+TEST(NhwcFp32ConvOpTest, Conv2DPointwise) {
+  for (bool weight_is_initializer : {false, true}) {
+    NhwcFp32ConvOpTester test({2, 6, 7, 24}, 10, {1, 1});
+    test.SetBias(true);
+    test.Run(weight_is_initializer);
+  }
+}
+
+TEST(NhwcFp32ConvOpTest, Conv2DDepthwise) {
+  for (int64_t channels : {1, 4, 11, 32}) {
+    NhwcFp32ConvOpTester test({1, 13, 9, channels}, channels, {3, 3}, channels);
+    test.SetPads({1, 1, 1, 1});
+    test.SetBias(true);
+    test.Run(true);
+  }
+}
+
+TEST(NhwcFp32ConvOpTest, Conv1D) {
+  NhwcFp32ConvOpTester test({1, 29, 6}, 9, {5});
+  test.SetPads({2, 2});
+  test.SetStrides({2});
+  test.Run(true);
+}
+
+TEST(NhwcFp32ConvOpTest, Conv3D) {
+  NhwcFp32ConvOpTester test({1, 5, 6, 7, 4}, 6, {3, 3, 3});
+  test.SetPads({1, 1, 1, 1, 1, 1});
+  test.SetBias(true);
+  test.Run(true);
+}
+
+TEST(NhwcFp32ConvOpTest, Conv2DSumRelu) {
+  NhwcFp32ConvOpTester test({1, 10, 10, 8}, 16, {3, 3});
+  test.SetPads({1, 1, 1, 1});
+  test.SetBias(true);
+  test.SetSum(true);
+  test.SetActivation("Relu");
+  test.Run(true);
+}
+
+TEST(NhwcFp32BatchNormalizationOpTest, Inference) {
+  const std::vector<int64_t> X_shape{2, 3, 4, 5};
+  const std::vector<float> X_data = GenerateData(ShapeSize(X_shape), 5);
+  const std::vector<float> scale{0.5f, 1.5f, -1.0f, 2.0f, 1.0f};
+  const std::vector<float> bias{0.1f, -0.2f, 0.3f, 0.0f, 1.0f};
+  const std::vector<float> mean{0.0f, 0.5f, -0.5f, 0.25f, 1.0f};
+  const std::vector<float> var{1.0f, 0.5f, 2.0f, 0.1f, 4.0f};
+  constexpr float epsilon = 1e-5f;
+
+  std::vector<float> Y_data(X_data.size());
+  for (size_t i = 0; i < X_data.size(); i++) {
+    const size_t c = i % 5;
+    Y_data[i] = (X_data[i] - mean[c]) / std::sqrt(var[c] + epsilon) * scale[c] + bias[c];
+  }
+
+  OpTester test("BatchNormalization", 15, onnxruntime::kMSInternalNHWCDomain);
+  test.AddAttribute("epsilon", epsilon);
+  test.AddInput<float>("X", X_shape, X_data);
+  test.AddInput<float>("scale", {5}, scale, true);
+  test.AddInput<float>("B", {5}, bias, true);
+  test.AddInput<float>("input_mean", {5}, mean, true);
+  test.AddInput<float>("input_var", {5}, var, true);
+  test.AddOutput<float>("Y", X_shape, Y_data);
+  RunOnCpu(test);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,96 @@
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+#include "core/providers/cpu/object_detection/non_max_suppression.h"
+#include "core/providers/cpu/object_detection/non_max_suppression_helper.h"
+#include "core/util/thread_utils.h"
+
+using namespace onnxruntime;
+
+namespace {
+
+// Boxes (x_min, y_min, x_max, y_max) gathered around a few centers like the proposals of a detector,
+// so that a large part of the candidates overlap and get suppressed.
+std::vector<float> CreateRandomBoxes(int64_t num_batches, int num_boxes) {
+  std::default_random_engine generator(42);
+  std::uniform_real_distribution<float> center_distribution(0.0f, 1000.0f);
+  std::normal_distribution<float> jitter_distribution(0.0f, 20.0f);
+  std::uniform_real_distribution<float> size_distribution(10.0f, 100.0f);
+  std::vector<float> centers(64);
+  for (auto& c : centers) {
+    c = center_distribution(generator);
+  }
+
+  std::vector<float> boxes(static_cast<size_t>(num_batches) * num_boxes * 4);
+  for (size_t i = 0; i < boxes.size(); i += 4) {
+    const size_t cluster = (i / 4) % (centers.size() / 2);
+    const float x = centers[2 * cluster] + jitter_distribution(generator);
+    const float y = centers[2 * cluster + 1] + jitter_distribution(generator);
+    const float half_width = size_distribution(generator) / 2;
+    const float half_height = size_distribution(generator) / 2;
+    boxes[i] = x - half_width;
+    boxes[i + 1] = y - half_height;
+    boxes[i + 2] = x + half_width;
+    boxes[i + 3] = y + half_height;
+  }
+  return boxes;
+}
+
+void BM_NonMaxSuppression(benchmark::State& state) {
+  const int64_t num_batches = 1;
+  const int num_boxes = static_cast<int>(state.range(0));
+  const int64_t num_classes = state.range(1);
+  const int64_t max_output_boxes_per_class = state.range(2);
+  const float iou_threshold = 0.5f;
+  const float score_threshold = 0.05f;
+
+  std::vector<float> boxes = CreateRandomBoxes(num_batches, num_boxes);
+  std::vector<float> scores(static_cast<size_t>(num_batches * num_classes) * num_boxes);
+  std::default_random_engine generator(7);
+  std::uniform_real_distribution<float> score_distribution(0.0f, 1.0f);
+  for (auto& s : scores) {
+    s = score_distribution(generator);
+  }
+
+  PrepareContext pc;
+  pc.boxes_data_ = boxes.data();
+  pc.boxes_size_ = static_cast<int64_t>(boxes.size());
+  pc.scores_data_ = scores.data();
+  pc.scores_size_ = static_cast<int64_t>(scores.size());
+  pc.score_threshold_ = &score_threshold;
+  pc.num_batches_ = num_batches;
+  pc.num_classes_ = num_classes;
+  pc.num_boxes_ = num_boxes;
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(state.range(3));
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<concurrency::ThreadPool> tp(
+      concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP));
+
+  std::vector<SelectedIndex> selected_indices;
+  for (auto _ : state) {
+    selected_indices.clear();
+    NonMaxSuppression::SelectBoxes(pc, 0, max_output_boxes_per_class, iou_threshold, score_threshold, tp.get(),
+                                   selected_indices);
+    benchmark::DoNotOptimize(selected_indices.data());
+  }
+}
+
+void NonMaxSuppressionArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"Boxes", "Classes", "MaxOutput", "Threads"});
+  for (int64_t num_boxes : {1000, 10000, 100000}) {
+    for (int64_t max_output : {100, 1000}) {
+      b->Args({num_boxes, 1, max_output, 1});
+    }
+  }
+  for (int64_t num_boxes : {1000, 10000}) {
+    for (int64_t threads : {1, 4}) {
+      b->Args({num_boxes, 80, 100, threads});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_NonMaxSuppression)->Apply(NonMaxSuppressionArgs)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
@@ -0,0 +1,121 @@
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "core/providers/cpu/ml/tree_ensemble_common.h"
+#include "core/util/thread_utils.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::ml::detail;
+
+namespace {
+
+// Exposes the evaluation of a regressor with one target and lets the benchmark disable the compact layout.
+class BenchTreeEnsemble : public TreeEnsembleCommon<float, float, float> {
+ public:
+  void DisableCompactLayout() { compact_ = TreeEnsembleCompactLayout<float>(); }
+
+  void Run(concurrency::ThreadPool* tp, const Tensor* X, Tensor* Y) const {
+    ComputeAgg(tp, X, Y, nullptr,
+               TreeAggregatorSum<float, float, float>(roots_.size(), n_targets_or_classes_, post_transform_,
+                                                      base_values_));
+  }
+};
+
+// Random trees of depth `depth` comparing features with BRANCH_LEQ, a node above the maximum depth
+// becomes a leaf with probability 0.1 like gradient boosted trees which are mostly but not always complete.
+TreeEnsembleAttributesV3<float> CreateRandomTrees(int n_trees, int depth, int n_features) {
+  std::default_random_engine generator(42);
+  std::uniform_real_distribution<float> threshold_distribution(-1.0f, 1.0f);
+  std::uniform_int_distribution<int64_t> feature_distribution(0, n_features - 1);
+  std::bernoulli_distribution early_leaf(0.1);
+
+  TreeEnsembleAttributesV3<float> attributes;
+  attributes.aggregate_function = "SUM";
+  attributes.post_transform = "NONE";
+  attributes.n_targets_or_classes = 1;
+  for (int64_t tree = 0; tree < n_trees; ++tree) {
+    // Nodes are created in breadth-first order, levels[i] is the depth of node i.
+    std::vector<int> levels = {0};
+    for (size_t i = 0; i < levels.size(); ++i) {
+      const int64_t node_id = static_cast<int64_t>(i);
+      attributes.nodes_treeids.push_back(tree);
+      attributes.nodes_nodeids.push_back(node_id);
+      attributes.nodes_missing_value_tracks_true.push_back(0);
+      if (levels[i] == depth || (levels[i] > 0 && early_leaf(generator))) {
+        attributes.nodes_modes.push_back(NODE_MODE_ONNX::LEAF);
+        attributes.nodes_featureids.push_back(0);
+        attributes.nodes_values.push_back(0.0f);
+        attributes.nodes_truenodeids.push_back(0);
+        attributes.nodes_falsenodeids.push_back(0);
+        attributes.target_class_treeids.push_back(tree);
+        attributes.target_class_nodeids.push_back(node_id);
+        attributes.target_class_ids.push_back(0);
+        attributes.target_class_weights.push_back(threshold_distribution(generator));
+      } else {
+        attributes.nodes_modes.push_back(NODE_MODE_ONNX::BRANCH_LEQ);
+        attributes.nodes_featureids.push_back(feature_distribution(generator));
+        attributes.nodes_values.push_back(threshold_distribution(generator));
+        attributes.nodes_truenodeids.push_back(static_cast<int64_t>(levels.size()));
+        attributes.nodes_falsenodeids.push_back(static_cast<int64_t>(levels.size()) + 1);
+        levels.push_back(levels[i] + 1);
+        levels.push_back(levels[i] + 1);
+      }
+    }
+  }
+  return attributes;
+}
+
+void BM_TreeEnsemble(benchmark::State& state, bool compact) {
+  const int64_t batch_size = state.range(0);
+  const int n_trees = static_cast<int>(state.range(1));
+  const int depth = static_cast<int>(state.range(2));
+  constexpr int n_features = 100;
+
+  BenchTreeEnsemble tree_ensemble;
+  ORT_THROW_IF_ERROR(tree_ensemble.Init(80, 128, 50, CreateRandomTrees(n_trees, depth, n_features)));
+  if (!compact) {
+    tree_ensemble.DisableCompactLayout();
+  }
+
+  AllocatorPtr alloc = std::make_shared<CPUAllocator>();
+  Tensor X(DataTypeImpl::GetType<float>(), TensorShape({batch_size, n_features}), alloc);
+  Tensor Y(DataTypeImpl::GetType<float>(), TensorShape({batch_size, 1}), alloc);
+  std::default_random_engine generator(7);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  for (auto& v : X.MutableDataAsSpan<float>()) {
+    v = distribution(generator);
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(state.range(3));
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<concurrency::ThreadPool> tp(
+      concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP));
+
+  for (auto _ : state) {
+    tree_ensemble.Run(tp.get(), &X, &Y);
+  }
+}
+
+void TreeEnsembleArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"BatchSize", "Trees", "Depth", "Threads"});
+  for (int64_t trees : {10, 100}) {
+    for (int64_t depth : {4, 6, 8}) {
+      b->Args({1, trees, depth, 1});
+    }
+  }
+  for (int64_t batch_size : {1000, 10000, 100000}) {
+    for (int64_t depth : {4, 6, 8}) {
+      for (int64_t threads : {1, 4}) {
+        b->Args({batch_size, 1000, depth, threads});
+      }
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_TreeEnsemble, Pointer, false)->Apply(TreeEnsembleArgs)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+BENCHMARK_CAPTURE(BM_TreeEnsemble, Compact, true)->Apply(TreeEnsembleArgs)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
@@ -2173,6 +2173,74 @@ TEST_F(GraphTransformationTests, LabelEncoderFusion) {
   EXPECT_EQ(ret.first, COMPARE_RESULT::SUCCESS) << ret.second;
 }
 
+TEST_F(GraphTransformationTests, ScalerLinearFusion) {
+  // The first Scaler has a scale and offset per feature, the second one broadcasts a single scale and offset.
+  const char* code = R"(
+  <
+  ir_version: 8,
+  opset_import: [ "" : 13, "ai.onnx.ml" : 1 ]
+  >
+  agraph (float[N, 3] x) => (int64[N] label, float[N, 3] probabilities, float[N, 2] value)
+  {
+      scaled_x = ai.onnx.ml.Scaler <offset: floats = [1.5, -2.0, 0.25], scale: floats = [0.5, 2.0, -3.0]> (x)
+      label, probabilities = ai.onnx.ml.LinearClassifier <
+          coefficients: floats = [1.0, -0.5, 0.25, 0.75, 2.0, -1.0, -1.5, 0.5, 1.0],
+          intercepts: floats = [0.1, -0.2, 0.3],
+          classlabels_ints: ints = [0, 1, 2],
+          post_transform: string = "SOFTMAX"> (scaled_x)
+      shifted_x = ai.onnx.ml.Scaler <offset: floats = [0.5], scale: floats = [4.0]> (x)
+      value = ai.onnx.ml.LinearRegressor <
+          coefficients: floats = [0.5, -1.0, 2.0, 1.5, 0.25, -0.75],
+          targets: int = 2> (shifted_x)
+  }
+  )";
+
+  ONNX_NAMESPACE::OnnxParser parser(code);
+  ONNX_NAMESPACE::ModelProto model_proto;
+  auto parse_status = parser.Parse(model_proto);
+  ASSERT_TRUE(parse_status.IsOK()) << parse_status.ErrorMessage();
+  ASSERT_TRUE(parser.EndOfInput()) << "Extra unparsed input unexpected.";
+
+  std::string serialized_model;
+  ASSERT_TRUE(model_proto.SerializeToString(&serialized_model)) << "Failed to serialize proto to string";
+
+  NameMLValMap feeds;
+  OrtValue mlvalue_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {4, 3},
+                       {0.0f, 1.0f, 2.0f, -1.0f, 3.5f, 0.5f, 2.0f, -2.0f, 1.0f, 0.75f, 0.0f, -0.25f}, &mlvalue_x);
+  feeds.insert(std::make_pair("x", mlvalue_x));
+
+  auto run_model_test = [&](TransformerLevel level, std::vector<OrtValue>& fetches, const int required_scaler_count) {
+    SessionOptions session_options;
+    session_options.graph_optimization_level = level;
+    session_options.session_logid = "OptimizerTests";
+    InferenceSessionWrapper session{session_options, GetEnvironment()};
+
+    std::stringstream sstr(serialized_model);
+    ASSERT_STATUS_OK(session.Load(sstr));
+    ASSERT_STATUS_OK(session.Initialize());
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(session.GetGraph());
+    ASSERT_EQ(op_to_count["ai.onnx.ml.Scaler"], required_scaler_count);
+    ASSERT_EQ(op_to_count["ai.onnx.ml.LinearClassifier"], 1);
+    ASSERT_EQ(op_to_count["ai.onnx.ml.LinearRegressor"], 1);
+
+    RunOptions run_options;
+    ASSERT_STATUS_OK(session.Run(run_options, feeds, {"label", "probabilities", "value"}, &fetches));
+  };
+
+  std::vector<OrtValue> unoptimized_fetches;
+  run_model_test(TransformerLevel::Default, unoptimized_fetches, 2);
+
+  std::vector<OrtValue> optimized_fetches;
+  run_model_test(TransformerLevel::MaxLevel, optimized_fetches, 0);
+
+  for (size_t i = 0; i < optimized_fetches.size(); ++i) {
+    auto ret = CompareOrtValue(optimized_fetches[i], unoptimized_fetches[i], 1e-5, 1e-5, false);
+    EXPECT_EQ(ret.first, COMPARE_RESULT::SUCCESS) << ret.second;
+  }
+}
+
 TEST_F(GraphTransformationTests, NotWhereFusion) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/not_where.onnx";
   std::shared_ptr<Model> model;
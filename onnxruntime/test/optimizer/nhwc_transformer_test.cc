@@ -686,6 +686,96 @@ TEST_F(NhwcTransformerTestsFp16, ConvAveragePoolFp16) {
 
 #endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
 
+class NhwcTransformerTestsFp32 : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (MlasNchwcGetBlockSize() > 1) {
+      GTEST_SKIP() << "Skipping test because the NchwcTransformer handles fp32 convolutions on this platform.";
+    }
+  }
+};
+
+TEST_F(NhwcTransformerTestsFp32, ConvMaxPoolBatchNorm) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 23, 13, 13}, -1.5f, 1.5f);
+    auto* conv1_output_arg = builder.MakeIntermediate();
+    auto* maxpool_output_arg = builder.MakeIntermediate();
+    auto* bn_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* conv1_weight_arg = builder.MakeInitializer<float>({30, 23, 3, 3}, -1.5f, 1.5f);
+    auto* conv2_weight_arg = builder.MakeInitializer<float>({16, 30, 1, 1}, -1.5f, 1.5f);
+    auto* bn_scale_arg = builder.MakeInitializer<float>({30}, 0.5f, 1.5f);
+    auto* bn_bias_arg = builder.MakeInitializer<float>({30}, -0.5f, 0.5f);
+    auto* bn_mean_arg = builder.MakeInitializer<float>({30}, -0.5f, 0.5f);
+    auto* bn_var_arg = builder.MakeInitializer<float>({30}, 0.5f, 1.5f);
+
+    Node& conv1_node = builder.AddConvNode(input_arg, conv1_weight_arg, conv1_output_arg);
+    conv1_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    Node& maxpool_node = builder.AddNode("MaxPool", {conv1_output_arg}, {maxpool_output_arg});
+    maxpool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+    maxpool_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("BatchNormalization",
+                    {maxpool_output_arg, bn_scale_arg, bn_bias_arg, bn_mean_arg, bn_var_arg},
+                    {bn_output_arg});
+    builder.AddConvNode(bn_output_arg, conv2_weight_arg, output_arg);
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 2);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.MaxPool"], 1);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.BatchNormalization"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3);
+}
+
+TEST_F(NhwcTransformerTestsFp32, ConvMaxPoolBatchNormTrainingMode) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 23, 13, 13}, -1.5f, 1.5f);
+    auto* conv1_output_arg = builder.MakeIntermediate();
+    auto* maxpool_output_arg = builder.MakeIntermediate();
+    auto* bn_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* conv1_weight_arg = builder.MakeInitializer<float>({30, 23, 3, 3}, -1.5f, 1.5f);
+    auto* conv2_weight_arg = builder.MakeInitializer<float>({16, 30, 1, 1}, -1.5f, 1.5f);
+    auto* bn_scale_arg = builder.MakeInitializer<float>({30}, 0.5f, 1.5f);
+    auto* bn_bias_arg = builder.MakeInitializer<float>({30}, -0.5f, 0.5f);
+    auto* bn_mean_arg = builder.MakeInitializer<float>({30}, -0.5f, 0.5f);
+    auto* bn_var_arg = builder.MakeInitializer<float>({30}, 0.5f, 1.5f);
+
+    Node& conv1_node = builder.AddConvNode(input_arg, conv1_weight_arg, conv1_output_arg);
+    conv1_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    Node& maxpool_node = builder.AddNode("MaxPool", {conv1_output_arg}, {maxpool_output_arg});
+    maxpool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+    maxpool_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    // Training mode with only the Y output, the NHWC kernel only supports inference.
+    Node& bn_node = builder.AddNode("BatchNormalization",
+                                    {maxpool_output_arg, bn_scale_arg, bn_bias_arg, bn_mean_arg, bn_var_arg},
+                                    {bn_output_arg});
+    bn_node.AddAttribute("training_mode", static_cast<int64_t>(1));
+    builder.AddConvNode(bn_output_arg, conv2_weight_arg, output_arg);
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 2);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.MaxPool"], 1);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.BatchNormalization"], 0);
+    EXPECT_EQ(op_to_count["BatchNormalization"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    15);
+}
+
 #endif  // DISABLE_CONTRIB_OPS
 
 }  // namespace test
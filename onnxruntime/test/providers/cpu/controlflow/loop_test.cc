@@ -1042,6 +1042,77 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// Test a loop carried variable that is also returned as scan output, with 'cond' returned unchanged so the
+// number of iterations is fixed, and with 'cond' computed by the subgraph.
+TEST(Loop, LoopCarriedVarAsScanOutput) {
+  auto create_subgraph = [](bool fixed_trip_count) {
+    Model model("loop carried var as scan output", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, sum_in
+
+         sum_in           sum_in          cond_in
+           |                |                |
+          [Add]         [Identity]   [Identity] or [Not]->[Not]
+           |                |                |
+         sum_out         scan_out         cond_out
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& sum_in = graph.GetOrCreateNodeArg("sum_in", &float_tensor);
+
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& sum_out = graph.GetOrCreateNodeArg("sum_out", &float_tensor);
+    auto& scan_out = graph.GetOrCreateNodeArg("scan_out", &float_tensor);
+
+    graph.AddNode("add", "Add", "Double sum_in", {&sum_in, &sum_in}, {&sum_out});
+    graph.AddNode("scan_out_identity", "Identity", "Forward sum_in to scan_out", {&sum_in}, {&scan_out});
+
+    if (fixed_trip_count) {
+      graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+    } else {
+      auto& not_cond = graph.GetOrCreateNodeArg("not_cond", &bool_scalar);
+      graph.AddNode("not_0", "Not", "Invert cond_in", {&cond_in}, {&not_cond});
+      graph.AddNode("not_1", "Not", "Invert not_cond", {&not_cond}, {&cond_out});
+    }
+
+    graph.SetInputs({&iter_num_in, &cond_in, &sum_in});
+    graph.SetOutputs({&cond_out, &sum_out, &scan_out});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  for (bool fixed_trip_count : {true, false}) {
+    OpTester test("Loop", 11);
+    test.AddAttribute<GraphProto>("body", create_subgraph(fixed_trip_count));
+    test.AddInput<int64_t>("M", {1}, {4});
+    test.AddInput<bool>("cond", {1}, {true});
+    test.AddInput<float>("sum", {2}, {1.f, 2.f});
+
+    test.AddOutput<float>("sum_final", {2}, {16.f, 32.f});
+    test.AddOutput<float>("scan_out_final", {4, 2}, {1.f, 2.f, 2.f, 4.f, 4.f, 8.f, 8.f, 16.f});
+
+    // Disable TensorRT on unsupported data type BOOL
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 // test that when part of the subgraph run on CUDA/ROCm it executes successfully
 TEST(Loop, MixedExecutionProviders) {
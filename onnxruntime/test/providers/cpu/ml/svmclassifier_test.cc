@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -50,6 +54,85 @@ TEST(MLOpTest, SVMClassifierMulticlassSVC) {
   test.Run();
 }
 
+// Larger batch with an uneven number of support vectors per class, the expected scores and votes are computed
+// one row and one pair of classes at a time.
+TEST(MLOpTest, SVMClassifierMulticlassSVCBatch) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  constexpr int64_t n_rows = 40;
+  constexpr int64_t n_features = 5;
+  constexpr float gamma = 0.1f;
+  const std::vector<int64_t> classes = {0, 1, 2, 3};
+  const std::vector<int64_t> vectors_per_class = {3, 2, 1, 4};
+  const int64_t n_classes = static_cast<int64_t>(classes.size());
+  const int64_t n_vectors = 10;
+
+  std::mt19937 generator(17);
+  std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+  auto random_vector = [&](size_t size) {
+    std::vector<float> values(size);
+    for (auto& v : values) {
+      v = distribution(generator);
+    }
+    return values;
+  };
+  const std::vector<float> support_vectors = random_vector(n_vectors * n_features);
+  const std::vector<float> coefficients = random_vector((n_classes - 1) * n_vectors);
+  const std::vector<float> rho = random_vector(n_classes * (n_classes - 1) / 2);
+  const std::vector<float> X = random_vector(n_rows * n_features);
+
+  std::vector<int64_t> starting_vector = {0};
+  for (size_t c = 0; c + 1 < vectors_per_class.size(); ++c) {
+    starting_vector.push_back(starting_vector.back() + vectors_per_class[c]);
+  }
+
+  std::vector<int64_t> predictions;
+  std::vector<float> scores;
+  for (int64_t row = 0; row < n_rows; ++row) {
+    std::vector<double> kernels(n_vectors);
+    for (int64_t v = 0; v < n_vectors; ++v) {
+      double distance = 0;
+      for (int64_t f = 0; f < n_features; ++f) {
+        double diff = X[row * n_features + f] - support_vectors[v * n_features + f];
+        distance += diff * diff;
+      }
+      kernels[v] = std::exp(-gamma * distance);
+    }
+
+    std::vector<int64_t> votes(n_classes, 0);
+    size_t classifier = 0;
+    for (int64_t i = 0; i < n_classes - 1; ++i) {
+      for (int64_t j = i + 1; j < n_classes; ++j) {
+        double sum = rho[classifier++];
+        for (int64_t v = starting_vector[i]; v < starting_vector[i] + vectors_per_class[i]; ++v) {
+          sum += coefficients[(j - 1) * n_vectors + v] * kernels[v];
+        }
+        for (int64_t v = starting_vector[j]; v < starting_vector[j] + vectors_per_class[j]; ++v) {
+          sum += coefficients[i * n_vectors + v] * kernels[v];
+        }
+        scores.push_back(static_cast<float>(sum));
+        ++votes[sum > 0 ? i : j];
+      }
+    }
+    predictions.push_back(classes[std::distance(votes.begin(), std::max_element(votes.begin(), votes.end()))]);
+  }
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", std::vector<float>{gamma, 0.f, 3.f});
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {n_rows, n_features}, X);
+  test.AddOutput<int64_t>("Y", {n_rows}, predictions);
+  test.AddOutput<float>("Z", {n_rows, static_cast<int64_t>(rho.size())}, scores);
+  test.SetOutputAbsErr("Z", 1e-4f);
+
+  test.Run();
+}
+
 TEST(MLOpTest, SVMClassifierMulticlassLinearSVC) {
   OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
 
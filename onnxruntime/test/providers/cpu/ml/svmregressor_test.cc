@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -32,6 +34,53 @@ TEST(MLOpTest, SVMRegressorSVC) {
   test.Run();
 }
 
+// Inputs and support vectors far from the origin compared with the distances between them, where
+// ||x||^2 + ||s||^2 - 2 x.s cancels badly unless both are centered first.
+TEST(MLOpTest, SVMRegressorSVCLargeOffset) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  constexpr float gamma = 0.5f;
+  std::vector<float> dual_coefficients = {-1.25f, 0.75f, 1.5f, -0.5f};
+  std::vector<float> support_vectors = {1000.f, 2000.5f, -3000.f,
+                                        1001.f, 2000.f, -3000.5f,
+                                        1000.5f, 2001.f, -2999.f,
+                                        999.5f, 1999.5f, -3001.f};
+  std::vector<float> rho = {0.25f};
+  std::vector<float> kernel_params = {gamma, 0.f, 3.f};  // gamma, coef0, degree
+
+  std::vector<float> X = {1000.f, 2000.5f, -3000.f,
+                          1000.25f, 2000.25f, -3000.25f,
+                          1002.f, 1999.f, -2998.f,
+                          999.75f, 2000.75f, -3000.5f};
+
+  // expected predictions are computed in double from the differences of the vectors
+  std::vector<float> predictions;
+  for (size_t row = 0; row < 4; ++row) {
+    double prediction = rho[0];
+    for (size_t v = 0; v < dual_coefficients.size(); ++v) {
+      double distance = 0.0;
+      for (size_t f = 0; f < 3; ++f) {
+        const double diff = static_cast<double>(X[row * 3 + f]) - static_cast<double>(support_vectors[v * 3 + f]);
+        distance += diff * diff;
+      }
+      prediction += dual_coefficients[v] * std::exp(-gamma * distance);
+    }
+    predictions.push_back(static_cast<float>(prediction));
+  }
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(4));
+
+  test.AddInput<float>("X", {4, 3}, X);
+  test.AddOutput<float>("Y", {4, 1}, predictions);
+
+  test.Run();
+}
+
 TEST(MLOpTest, SVMRegressorNuSVC) {
   OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
 
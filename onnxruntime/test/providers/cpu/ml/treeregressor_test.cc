@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -596,6 +598,94 @@ TEST(MLOpTest, TreeRegressorSingleTargetBatchTreeE) {
   GenTreeAndRunTest1(3, "AVERAGE", false, 201, 1);  // section E
 }
 
+void GenUnbalancedTreeAndRunTest(int64_t n_obs) {
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  // Tree 0 is a ladder of depth 3 on feature 1, missing values go to the first leaf.
+  // Tree 1 is a stump on feature 0.
+  std::vector<int64_t> lefts = {1, 0, 3, 0, 5, 0, 0, 1, 0, 0};
+  std::vector<int64_t> rights = {2, 0, 4, 0, 6, 0, 0, 2, 0, 0};
+  std::vector<int64_t> treeids = {0, 0, 0, 0, 0, 0, 0, 1, 1, 1};
+  std::vector<int64_t> nodeids = {0, 1, 2, 3, 4, 5, 6, 0, 1, 2};
+  std::vector<int64_t> featureids = {1, 0, 1, 0, 1, 0, 0, 0, 0, 0};
+  std::vector<float> thresholds = {1.f, 0.f, 2.f, 0.f, 3.f, 0.f, 0.f, 0.5f, 0.f, 0.f};
+  std::vector<int64_t> missing_tracks = {1, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  std::vector<std::string> modes = {"BRANCH_LT", "LEAF", "BRANCH_LT", "LEAF", "BRANCH_LT", "LEAF", "LEAF",
+                                    "BRANCH_LT", "LEAF", "LEAF"};
+
+  std::vector<int64_t> target_treeids = {0, 0, 0, 0, 1, 1};
+  std::vector<int64_t> target_nodeids = {1, 3, 5, 6, 1, 2};
+  std::vector<int64_t> target_ids = {0, 0, 0, 0, 0, 0};
+  std::vector<float> target_weights = {10.f, 20.f, 30.f, 40.f, 1.f, 2.f};
+
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_missing_value_tracks_true", missing_tracks);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  const std::vector<float> x1_values = {0.5f, 1.5f, 2.5f, 3.5f, std::numeric_limits<float>::quiet_NaN()};
+  const std::vector<float> tree0_results = {10.f, 20.f, 30.f, 40.f, 10.f};
+  std::vector<float> X, Y;
+  for (int64_t i = 0; i < n_obs; ++i) {
+    const float x0 = static_cast<float>(i % 2);
+    const size_t k = static_cast<size_t>(i % 5);
+    X.push_back(x0);
+    X.push_back(x1_values[k]);
+    Y.push_back(tree0_results[k] + (x0 < 0.5f ? 1.f : 2.f));
+  }
+  test.AddInput<float>("X", {n_obs, 2}, X);
+  test.AddOutput<float>("Y", {n_obs, 1}, Y);
+  test.Run();
+}
+
+TEST(MLOpTest, TreeRegressorUnbalancedTreesBatch) {
+  // Trees are padded to complete trees to evaluate blocks of rows at once.
+  GenUnbalancedTreeAndRunTest(1);
+  GenUnbalancedTreeAndRunTest(13);
+  GenUnbalancedTreeAndRunTest(40);
+  GenUnbalancedTreeAndRunTest(301);
+}
+
+void GenObliviousTreesAndRunTest(const std::vector<float>& X, float expected) {
+  // Every level of an oblivious tree compares the same feature with the same threshold.
+  // The second tree stops early on the true branch of the root.
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+  test.AddAttribute("nodes_truenodeids", std::vector<int64_t>{1, 3, 5, 0, 0, 0, 0, 1, 0, 3, 0, 0});
+  test.AddAttribute("nodes_falsenodeids", std::vector<int64_t>{2, 4, 6, 0, 0, 0, 0, 2, 0, 4, 0, 0});
+  test.AddAttribute("nodes_treeids", std::vector<int64_t>{0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1});
+  test.AddAttribute("nodes_nodeids", std::vector<int64_t>{0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4});
+  test.AddAttribute("nodes_featureids", std::vector<int64_t>{0, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0});
+  test.AddAttribute("nodes_values", std::vector<float>{0.5f, 0.5f, 0.5f, 0.f, 0.f, 0.f, 0.f, 0.5f, 0.f, 0.5f, 0.f, 0.f});
+  test.AddAttribute("nodes_modes", std::vector<std::string>{"BRANCH_LEQ", "BRANCH_LEQ", "BRANCH_LEQ", "LEAF", "LEAF",
+                                                            "LEAF", "LEAF", "BRANCH_LEQ", "LEAF", "BRANCH_LEQ",
+                                                            "LEAF", "LEAF"});
+  test.AddAttribute("target_treeids", std::vector<int64_t>{0, 0, 0, 0, 1, 1, 1});
+  test.AddAttribute("target_nodeids", std::vector<int64_t>{3, 4, 5, 6, 1, 3, 4});
+  test.AddAttribute("target_ids", std::vector<int64_t>{0, 0, 0, 0, 0, 0, 0});
+  test.AddAttribute("target_weights", std::vector<float>{1.f, 2.f, 3.f, 4.f, 10.f, 20.f, 30.f});
+  test.AddAttribute("n_targets", (int64_t)1);
+  test.AddInput<float>("X", {1, 2}, X);
+  test.AddOutput<float>("Y", {1, 1}, {expected});
+  test.Run();
+}
+
+TEST(MLOpTest, TreeRegressorObliviousTreesOneRow) {
+  // (x0 <= 0.5, x1 <= 0.5) selects the leaf of the first tree, x1 <= 0.5 and then x0 <= 0.5 the one of the second.
+  GenObliviousTreesAndRunTest({0.f, 0.f}, 11.f);
+  GenObliviousTreesAndRunTest({0.f, 1.f}, 22.f);
+  GenObliviousTreesAndRunTest({1.f, 0.f}, 13.f);
+  GenObliviousTreesAndRunTest({1.f, 1.f}, 34.f);
+}
+
 TEST(MLOpTest, TreeRegressorSingleTargetAverage) {
   GenTreeAndRunTest1(1, "AVERAGE", false);
   GenTreeAndRunTest1(3, "AVERAGE", false);
@@ -55,6 +55,44 @@ TEST(MLOpTest, ZipMapOpInt64Float1D) {
   TestHelper<int64_t>({10, 20, 30, 40, 50, 60}, "int64_t", {6});
 }
 
+// Runs ZipMap on enough rows for the rows to be built in parallel on a 4 thread session pool, and checks the map
+// of every row. The labels are not sorted so that the map order differs from the column order.
+template <typename T>
+void ThreadedTestHelper(const std::vector<T>& classes, const std::string& attribute) {
+  constexpr int64_t batch_size = 1024;
+  const int64_t num_classes = static_cast<int64_t>(classes.size());
+
+  OpTester test("ZipMap", 1, onnxruntime::kMLDomain);
+  test.AddAttribute(attribute, classes);
+
+  std::vector<float> input(static_cast<size_t>(batch_size * num_classes));
+  std::vector<std::map<T, float>> expected_output(static_cast<size_t>(batch_size));
+  for (int64_t i = 0; i < batch_size; ++i) {
+    for (int64_t j = 0; j < num_classes; ++j) {
+      const float value = static_cast<float>(i * num_classes + j) * 0.25f;
+      input[static_cast<size_t>(i * num_classes + j)] = value;
+      expected_output[static_cast<size_t>(i)].emplace(classes[static_cast<size_t>(j)], value);
+    }
+  }
+
+  test.AddInput<float>("X", {batch_size, num_classes}, input);
+  test.AddOutput<T, float>("Z", expected_output);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  so.session_logid = "ZipMapTest";
+  so.graph_optimization_level = TransformerLevel::Default;
+  test.Run(so);
+}
+
+TEST(MLOpTest, ZipMapOpStringFloatThreads) {
+  ThreadedTestHelper<string>({"class3", "class1", "class5", "class2", "class4"}, "classlabels_strings");
+}
+
+TEST(MLOpTest, ZipMapOpInt64FloatThreads) {
+  ThreadedTestHelper<int64_t>({30, -10, 50, 20, 40}, "classlabels_int64s");
+}
+
 // Negative test cases
 TEST(MLOpTest, ZipMapOpStringFloatStrideMoreThanNumLabels) {
   TestHelper<string>({"class1", "class2", "class3"}, "string", {1, 6}, OpTester::ExpectResult::kExpectFailure);
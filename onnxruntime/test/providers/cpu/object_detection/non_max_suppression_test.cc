@@ -288,6 +288,38 @@ TEST(NonMaxSuppressionOpTest, SelectFromIdenticalBoxes) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, SelectFromManyOverlappingBoxes) {
+  // Box i overlaps the two next boxes with an IOU above the threshold, so the selection of one box
+  // out of three needs more candidates than the first chunk of sorted scores holds.
+  constexpr int64_t num_boxes = 200;
+  constexpr int64_t max_output = 50;
+  std::vector<float> boxes;
+  std::vector<float> scores(2 * num_boxes);
+  for (int64_t i = 0; i < num_boxes; ++i) {
+    const float y = static_cast<float>(i) * 0.25f;
+    boxes.insert(boxes.end(), {0.0f, y, 1.0f, y + 1.0f});
+    scores[i] = 1.0f - static_cast<float>(i) * 0.001f;
+    scores[num_boxes + i] = static_cast<float>(i) * 0.001f;
+  }
+
+  std::vector<int64_t> expected;
+  for (int64_t i = 0; i < max_output; ++i) {
+    expected.insert(expected.end(), {0L, 0L, 3 * i});
+  }
+  for (int64_t i = 0; i < max_output; ++i) {
+    expected.insert(expected.end(), {0L, 1L, num_boxes - 1 - 3 * i});
+  }
+
+  OpTester test("NonMaxSuppression", 10, kOnnxDomain);
+  test.AddInput<float>("boxes", {1, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {1, 2, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {max_output});
+  test.AddInput<float>("iou_threshold", {}, {0.25f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {2 * max_output, 3}, expected);
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, InconsistentBoxAndScoreShapes) {
   OpTester test("NonMaxSuppression", 10, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
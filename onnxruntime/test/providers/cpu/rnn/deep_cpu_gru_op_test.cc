@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 
 #include <iterator>
+#include <unordered_set>
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_gru.h"
@@ -34,7 +35,8 @@ static void RunGruTest(const std::vector<float>& X_data,
                        // copy the following vectors as we may modify them
                        std::vector<string> activations = default_activations,
                        std::vector<float> activation_alphas = {},
-                       std::vector<float> activation_betas = {}) {
+                       std::vector<float> activation_betas = {},
+                       int intra_op_num_threads = 0) {
   OpTester test("GRU");
 
   test.AddShapeToTensorData();
@@ -100,10 +102,21 @@ static void RunGruTest(const std::vector<float>& X_data,
 
 // TensorRT, OpenVINO failed on GRU tests
 #if defined(USE_OPENVINO)
-  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+  const std::unordered_set<std::string> excluded_providers{kTensorrtExecutionProvider, kOpenVINOExecutionProvider};
 #else
-  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  const std::unordered_set<std::string> excluded_providers{kTensorrtExecutionProvider};
 #endif
+
+  if (intra_op_num_threads > 0) {
+    // use a session thread pool of the given size instead of the global one
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = intra_op_num_threads;
+    so.session_logid = "GRUTest";
+    so.graph_optimization_level = TransformerLevel::Default;
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", excluded_providers);
+  } else {
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", excluded_providers);
+  }
 }
 
 void DefaultActivationsSimpleWeightsNoBias(std::string direction,
@@ -375,7 +388,8 @@ class DeepCpuGruOpTestContext {
                const std::vector<float>* initial_h,
                const std::vector<float>& expected_Y,
                const std::vector<float>& expected_Y_h,
-               const bool linear_before_reset = false);
+               const bool linear_before_reset = false,
+               const int intra_op_num_threads = 0);
 
  private:
   const int input_size_;
@@ -511,7 +525,8 @@ void DeepCpuGruOpTestContext::RunTest(const std::vector<float>& X,
                                       const std::vector<float>* initial_h,
                                       const std::vector<float>& expected_Y,
                                       const std::vector<float>& expected_Y_h,
-                                      const bool linear_before_reset) {
+                                      const bool linear_before_reset,
+                                      const int intra_op_num_threads) {
   // run with and without output_sequence
   RunGruTest(X, gru_input_weights_, gru_recurrent_weights_,
              expected_Y, expected_Y_h,
@@ -525,7 +540,8 @@ void DeepCpuGruOpTestContext::RunTest(const std::vector<float>& X,
              linear_before_reset,
              activation_func_names_,
              alphas_,
-             betas_);
+             betas_,
+             intra_op_num_threads);
 
   RunGruTest(X, gru_input_weights_, gru_recurrent_weights_,
              expected_Y, expected_Y_h,
@@ -539,7 +555,8 @@ void DeepCpuGruOpTestContext::RunTest(const std::vector<float>& X,
              linear_before_reset,
              activation_func_names_,
              alphas_,
-             betas_);
+             betas_,
+             intra_op_num_threads);
 }
 
 TEST(GRUTest, ONNXRuntime_TestGRUOpForwardBasic) {
@@ -602,6 +619,32 @@ TEST(GRUTest, ONNXRuntime_TestGRUOpBidirectionalBasic) {
   ctx.RunTest(X, batch_size, seq_length, sequence_length, &initial_h, expected_Y, expected_Y_h);
 }
 
+// Bidirectional GRU on a 2 thread pool, where the forward and reverse directions run concurrently.
+TEST(GRUTest, ONNXRuntime_TestGRUOpBidirectionalThreads) {
+  const std::string direction = "bidirectional";
+  const std::vector<std::string> activations = {"Sigmoid", "Tanh", "Sigmoid", "Tanh"};
+
+  DeepCpuGruOpTestContext ctx(direction, activations);
+
+  // two copies of the sequence in ONNXRuntime_TestGRUOpBidirectionalBasic
+  constexpr int batch_size = 2;
+  constexpr int seq_length = 2;
+  std::vector<float> X = {-0.455351f, -0.276391f, -0.455351f, -0.276391f,
+                          -0.185934f, -0.269585f, -0.185934f, -0.269585f};
+  std::vector<int> sequence_length = {2, 2};
+  std::vector<float> initial_h(8, 0.0f);
+  std::vector<float> expected_Y = {-0.03255286f, 0.0774838f, -0.03255286f, 0.0774838f,
+                                   -0.05469977f, 0.1004222f, -0.05469977f, 0.1004222f,
+
+                                   -0.05556786f, 0.0785508f, -0.05556786f, 0.0785508f,
+                                   -0.04566499f, 0.04621252f, -0.04566499f, 0.04621252f};
+  std::vector<float> expected_Y_h = {-0.05556786f, 0.0785508f, -0.05556786f, 0.0785508f,
+                                     -0.05469977f, 0.1004222f, -0.05469977f, 0.1004222f};
+
+  ctx.RunTest(X, batch_size, seq_length, sequence_length, &initial_h, expected_Y, expected_Y_h,
+              /*linear_before_reset*/ false, /*intra_op_num_threads*/ 2);
+}
+
 TEST(GRUTest, ONNXRuntime_TestGRUOpForwardActivation) {
   const std::string direction = "forward";
   const std::vector<std::string> activations = {"Tanh", "Sigmoid"};
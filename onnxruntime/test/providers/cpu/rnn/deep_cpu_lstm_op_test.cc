@@ -1247,6 +1247,43 @@ TEST(LSTMTest, ONNXRuntime_TestLSTMSequenceLengthShorterThanInputSequenceLengthN
   context.RunTest(X_data, batch_size, seq_len, &initial_h, &initial_c, Y_data, Y_h_data, {}, &sequence_length, false);
 }
 
+// Without peepholes the gates of a row are computed in a single pass, and with a single batch row the
+// recurrent loops of both directions can run concurrently.
+TEST(LSTMTest, ONNXRuntime_TestLSTMBidirectionalNoPeepholesShorterSequence) {
+  // TODO: Unskip when fixed #41968513
+  if (DefaultDmlExecutionProvider().get() != nullptr) {
+    GTEST_SKIP() << "Skipping because of the following error: MLOperatorAuthorImpl.cpp(1817): The parameter is incorrect.";
+  }
+
+  constexpr int seq_len = 3;
+  constexpr int batch_size = 1;
+
+  std::vector<float> X_data = {-0.455351f, -0.276391f,
+                               -0.185934f, -0.269585f,
+                               0.362272f, -0.123455f};
+
+  std::vector<int> sequence_length = {2};
+
+  std::vector<float> Y_data = {-0.02547895f, 0.05548427f,
+                               -0.03307575f, 0.07445575f,
+
+                               -0.03390876f, 0.05773343f,
+                               -0.03124871f, 0.02785305f,
+
+                               0.0f, 0.0f,
+                               0.0f, 0.0f};
+
+  std::vector<float> Y_h_data = {-0.03390876f, 0.05773343f,
+                                 -0.03307575f, 0.07445575f};
+
+  std::vector<float> Y_c_data = {-0.07914147f, 0.09744528f,
+                                 -0.07669979f, 0.1197521f};
+
+  LstmOpContext2x1x2x2 context("bidirectional");
+  context.RunTest(X_data, batch_size, seq_len, nullptr, nullptr, Y_data, Y_h_data, Y_c_data, &sequence_length,
+                  true, false);
+}
+
 // Doesn't work with CUDA 11.4 on Windows. Need investigation.
 #if defined(USE_CUDA) && defined(_WIN32)
 TEST(LSTMTest, DISABLED_ONNXRuntime_TestLSTMShorterSeqInMiddle) {
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <vector>
 
@@ -233,6 +235,102 @@ TEST(SignalOpsTest, STFTFloat) {
   test.Run();
 }
 
+// Reference DFT of one frame of `length` complex values, zero padded to dft_length.
+static vector<float> NaiveDFT(const vector<float>& real, const vector<float>& imag, size_t offset, size_t length,
+                              size_t dft_length, size_t output_size) {
+  vector<float> output;
+  for (size_t k = 0; k < output_size; k++) {
+    double sum_real = 0;
+    double sum_imag = 0;
+    for (size_t n = 0; n < std::min(length, dft_length); n++) {
+      const double angle = -2.0 * M_PI * static_cast<double>((k * n) % dft_length) / static_cast<double>(dft_length);
+      sum_real += real[offset + n] * std::cos(angle) - imag[offset + n] * std::sin(angle);
+      sum_imag += real[offset + n] * std::sin(angle) + imag[offset + n] * std::cos(angle);
+    }
+    output.push_back(static_cast<float>(sum_real));
+    output.push_back(static_cast<float>(sum_imag));
+  }
+  return output;
+}
+
+// Batches of real signals exercise the real input transform for powers of 2 and Bluestein's algorithm otherwise.
+TEST(SignalOpsTest, DFT20_Float_real_batched) {
+  RandomValueGenerator random(GetTestRandomSeed());
+  constexpr int64_t batch_size = 3;
+  for (int64_t signal_length : {6, 32, 100, 128}) {
+    for (bool onesided : {false, true}) {
+      const int64_t dft_length = signal_length;
+      const int64_t output_size = onesided ? (dft_length >> 1) + 1 : dft_length;
+      const vector<int64_t> input_shape{batch_size, signal_length, 1};
+      vector<float> input = random.Uniform<float>(input_shape, -1.f, 1.f);
+      vector<float> zeros(input.size(), 0.f);
+      vector<float> expected_output;
+      for (int64_t batch = 0; batch < batch_size; batch++) {
+        const auto frame = NaiveDFT(input, zeros, static_cast<size_t>(batch * signal_length),
+                                    static_cast<size_t>(signal_length), static_cast<size_t>(dft_length),
+                                    static_cast<size_t>(output_size));
+        expected_output.insert(expected_output.end(), frame.begin(), frame.end());
+      }
+
+      OpTester test("DFT", kOpsetVersion20);
+      test.AddInput<float>("input", input_shape, input);
+      test.AddInput<int64_t>("dft_length", {}, {dft_length});
+      test.AddInput<int64_t>("axis", {}, {1});
+      test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+      test.AddOutput<float>("output", {batch_size, output_size, 2}, expected_output);
+      test.SetOutputAbsErr("output", 0.0005f);
+      test.Run();
+    }
+  }
+}
+
+TEST(SignalOpsTest, STFTFloat_batched) {
+  RandomValueGenerator random(GetTestRandomSeed());
+  constexpr int64_t batch_size = 2;
+  constexpr int64_t signal_length = 100;
+  constexpr int64_t frame_step = 7;
+  for (bool complex : {false, true}) {
+    for (int64_t frame_length : {16, 20}) {
+      const int64_t n_dfts = (signal_length - frame_length) / frame_step + 1;
+      const int64_t output_size = complex ? frame_length : (frame_length >> 1) + 1;
+      const int64_t components = complex ? 2 : 1;
+      const vector<int64_t> signal_shape{batch_size, signal_length, components};
+      const vector<int64_t> window_shape{frame_length};
+      vector<float> signal = random.Uniform<float>(signal_shape, -1.f, 1.f);
+      vector<float> window = random.Uniform<float>(window_shape, 0.f, 1.f);
+
+      // Apply the window to every frame and split the real and imaginary parts for the reference.
+      vector<float> expected_output;
+      for (int64_t batch = 0; batch < batch_size; batch++) {
+        for (int64_t i = 0; i < n_dfts; i++) {
+          vector<float> real(static_cast<size_t>(frame_length));
+          vector<float> imag(static_cast<size_t>(frame_length), 0.f);
+          for (int64_t n = 0; n < frame_length; n++) {
+            const size_t index = static_cast<size_t>(((batch * signal_length) + i * frame_step + n) * components);
+            real[static_cast<size_t>(n)] = signal[index] * window[static_cast<size_t>(n)];
+            if (complex) {
+              imag[static_cast<size_t>(n)] = signal[index + 1] * window[static_cast<size_t>(n)];
+            }
+          }
+          const auto frame = NaiveDFT(real, imag, 0, static_cast<size_t>(frame_length),
+                                      static_cast<size_t>(frame_length), static_cast<size_t>(output_size));
+          expected_output.insert(expected_output.end(), frame.begin(), frame.end());
+        }
+      }
+
+      OpTester test("STFT", kMinOpsetVersion);
+      test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(!complex));
+      test.AddInput<float>("signal", signal_shape, signal);
+      test.AddInput<int64_t>("frame_step", {}, {frame_step});
+      test.AddInput<float>("window", window_shape, window);
+      test.AddInput<int64_t>("frame_length", {}, {frame_length});
+      test.AddOutput<float>("output", {batch_size, n_dfts, output_size, 2}, expected_output);
+      test.SetOutputAbsErr("output", 0.0005f);
+      test.Run();
+    }
+  }
+}
+
 TEST(SignalOpsTest, HannWindowFloat) {
   OpTester test("HannWindow", kMinOpsetVersion);
 
@@ -430,6 +430,50 @@ TEST(GatherOpTest, Gather_axis1_scalar_indices) {
   run_test(false);
   run_test(true);
 }
+
+// Runs of consecutive indices are copied as one block, so mix runs that cross the end of the axis, negative
+// indices and repeated indices.
+TEST(GatherOpTest, Gather_axis1_consecutive_indices) {
+  const std::vector<int64_t> data_dims{2, 5, 3};
+  const std::vector<int64_t> indices{1, 2, 3, 4, 0, 1, -2, -1, -1, 2};
+  std::vector<float> data(2 * 5 * 3);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+
+  std::vector<float> output;
+  for (int64_t batch = 0; batch < data_dims[0]; ++batch) {
+    for (int64_t index : indices) {
+      const int64_t row = index < 0 ? index + data_dims[1] : index;
+      for (int64_t k = 0; k < data_dims[2]; ++k) {
+        output.push_back(data[static_cast<size_t>((batch * data_dims[1] + row) * data_dims[2] + k)]);
+      }
+    }
+  }
+
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 1LL);
+  test.AddInput<float>("data", data_dims, data);
+  test.AddInput<int64_t>("indices", {2, 5}, indices);
+  test.AddOutput<float>("output", {2, 2, 5, 3}, output);
+  test.Run();
+}
+
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"00", "01",
+                              "10", "11",
+                              "20", "21"});
+  test.AddInput<int32_t>("indices", {3}, {2, 0, 1});
+  test.AddOutput<std::string>("output", {3, 2},
+                              {"20", "21",
+                               "00", "01",
+                               "10", "11"});
+  test.Run();
+}
+
 #ifdef ENABLE_TRAINING_OPS
 // Should remove the shrunken_gather include from ENABLE_TRAINING_OPS once 1). compute optimizer is enabled for inference or
 // 2). this is needed by inference for other purpose.
@@ -336,6 +336,56 @@ TEST(ResizeOpTest, NhwcResizeOpLinearDownSampleTest_4DBilinear_int8) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
 }
 
+TEST(ResizeOpTest, NhwcResizeOpLinearUpSampleTest_4DBilinear_MultiChannel) {
+  // Enough channels to go through the vectorized and the remainder paths of the channels last kernel.
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 2.0f, 1.5f, 1.0f};
+
+  test.AddAttribute("mode", "linear");
+
+  constexpr int64_t N = 2, H = 3, W = 4, C = 11;
+  constexpr int64_t OH = 6, OW = 6;
+  std::vector<float> X(N * H * W * C);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>((i * 7) % 23) - 11.0f;
+  }
+
+  // half_pixel coordinates clamped to the input.
+  auto original = [](int64_t o, float scale, int64_t size) {
+    float in = (static_cast<float>(o) + 0.5f) / scale - 0.5f;
+    return std::max(0.0f, std::min(in, static_cast<float>(size - 1)));
+  };
+
+  std::vector<float> Y;
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t y = 0; y < OH; y++) {
+      const float in_y = original(y, scales[1], H);
+      const int64_t y1 = static_cast<int64_t>(in_y), y2 = std::min(y1 + 1, H - 1);
+      const float dy = y1 == y2 ? 0.5f : in_y - y1;
+      for (int64_t x = 0; x < OW; x++) {
+        const float in_x = original(x, scales[2], W);
+        const int64_t x1 = static_cast<int64_t>(in_x), x2 = std::min(x1 + 1, W - 1);
+        const float dx = x1 == x2 ? 0.5f : in_x - x1;
+        for (int64_t c = 0; c < C; c++) {
+          auto at = [&](int64_t yy, int64_t xx) { return X[((n * H + yy) * W + xx) * C + c]; };
+          Y.push_back((1 - dy) * ((1 - dx) * at(y1, x1) + dx * at(y1, x2)) +
+                      dy * ((1 - dx) * at(y2, x1) + dx * at(y2, x2)));
+        }
+      }
+    }
+  }
+
+  test.AddInput<float>("X", {N, H, W, C}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+  test.AddOutput<float>("Y", {N, OH, OW, C}, Y);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 // Since NNAPI(TFLite) only using the scale calculate using the input/output size
 // For the above test (ResizeOpLinearDownSampleTest_4DBilinear)
 // The output size is [1,1,2,4].*[1,1,0.6,0.6]=[1,1,1,2]
@@ -1404,6 +1454,49 @@ TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_exclude_outside) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
 }
 
+TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_exclude_outside_with_extrapolation) {
+  // The crop box extends past the input, so the top rows, the bottom row and the right columns are extrapolated.
+  OpTester test("Resize", 13);
+  std::vector<float> roi{0.0f, 0.0f, -0.4f, 0.1f, 1.0f, 1.0f, 1.3f, 1.2f};
+  std::vector<float> scales{1.0f, 1.0f, 1.5f, 1.6f};
+
+  test.AddAttribute("mode", "cubic");
+  test.AddAttribute("exclude_outside", static_cast<int64_t>(1));
+  test.AddAttribute("cubic_coeff_a", -0.5f);
+  test.AddAttribute("coordinate_transformation_mode", "tf_crop_and_resize");
+  test.AddAttribute("extrapolation_value", 10.0f);
+
+  constexpr int64_t N = 1, C = 2, H = 4, W = 5;
+  std::vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>((i * 7) % 23) * 0.5f - 5.5f;
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {8}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<float> Y = {
+      10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f,
+      10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f,
+      1.61568f, 3.4988f, -1.55889f, -3.41314f, -0.462631f, 1.6132f, 10.0f, 10.0f,
+      -3.63011f, -1.13795f, 0.646952f, 2.93117f, 5.24642f, 1.04771f, 10.0f, 10.0f,
+      2.05215f, 3.94532f, -0.999456f, -2.7854f, 0.154618f, 2.12691f, 10.0f, 10.0f,
+      10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f,
+
+      10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f,
+      10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f,
+      2.61568f, 4.49911f, -0.501107f, -2.62478f, -0.229629f, 2.24517f, 10.0f, 10.0f,
+      -2.63011f, -0.133635f, 2.4529f, 0.979328f, -4.45081f, -3.08517f, 10.0f, 10.0f,
+      3.05215f, 4.94569f, 0.0706772f, -2.04227f, 0.223749f, 2.68025f, 10.0f, 10.0f,
+      10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f, 10.0f};
+
+  test.AddOutput<float>("Y", {N, C, 6, 8}, Y);
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_coeff) {
   OpTester test("Resize", 13);
   std::vector<float> scales{1.0f, 1.0f, 0.8f, 0.8f};
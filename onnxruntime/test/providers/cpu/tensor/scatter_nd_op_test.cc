@@ -235,5 +235,16 @@ TEST(ScatterNDOpTest, ScatterND_18_max) {
   test1.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+TEST(ScatterNDOpTest, ScatterND_18_add_consecutive_indices) {
+  // Adjacent indices are applied as one run; the repeated index must still accumulate both updates.
+  OpTester test1("ScatterND", 18);
+  test1.AddAttribute("reduction", "add");
+  test1.AddInput<int64_t>("data", {6}, {1, 1, 1, 1, 1, 1});
+  test1.AddInput<int64_t>("indices", {5, 1}, {1, 2, 3, 0, 1});
+  test1.AddInput<int64_t>("updates", {5}, {10, 20, 30, 40, 50});
+  test1.AddOutput<int64_t>("output", {6}, {41, 61, 21, 31, 1, 1});
+  test1.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -194,6 +194,29 @@ TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutUpperWithLocale) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutLowerMixedAscii) {
+  // - case-INSENSITIVE approach en_US locale
+  // - ASCII strings change case without the conversion to wide chars,
+  //   the others go through the locale
+  // - filter out monday whatever its case
+
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "LOWER", false, {"Monday"}, test_locale);
+  std::vector<int64_t> dims{5};
+  std::vector<std::string> input = {"MONDAY",
+                                    "Tuesday",
+                                    "Besançon",
+                                    "monday",
+                                    "WEDNESDAY [1]"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<std::string> output = {"tuesday",
+                                     "besançon",
+                                     "wednesday [1]"};
+  test.AddOutput<std::string>("Y", {3}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, StringNormalizerSensitiveFilterOutUpperEmptyCase) {
   // Empty output case
   // - casesensitive approach
@@ -0,0 +1,185 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation.  All rights reserved.
+# Licensed under the MIT License.
+# --------------------------------------------------------------------------
+
+"""
+Benchmark accuracy and latency of GroupQueryAttention on CPU with int8 quantized KV cache (kv_cache_bit_width=8),
+compared to float KV cache.
+
+Example:
+    python benchmark_gqa_kv_cache_cpu.py --batch_size 1 --num_heads 32 --kv_num_heads 8 --head_size 128
+"""
+
+import argparse
+import time
+
+import numpy
+from onnx import TensorProto, helper
+
+from onnxruntime import InferenceSession, SessionOptions
+
+
+def create_gqa_graph(
+    batch_size: int,
+    sequence_length: int,
+    past_sequence_length: int,
+    num_heads: int,
+    kv_num_heads: int,
+    head_size: int,
+    quantized: bool,
+):
+    """Create a GroupQueryAttention model with separated past and present KV cache in BNSH format."""
+    kv_type = TensorProto.INT8 if quantized else TensorProto.FLOAT
+    total_sequence_length = past_sequence_length + sequence_length
+    has_past = past_sequence_length > 0
+
+    inputs = ["query", "key", "value", "past_key" if has_past else "", "past_value" if has_past else ""]
+    inputs += ["seqlens_k", "total_sequence_length"]
+    outputs = ["output", "present_key", "present_value"]
+    if quantized:
+        inputs += ["", "", "past_key_scale" if has_past else "", "past_value_scale" if has_past else ""]
+        outputs += ["present_key_scale", "present_value_scale"]
+
+    node = helper.make_node(
+        "GroupQueryAttention",
+        inputs,
+        outputs,
+        "GroupQueryAttention_0",
+        num_heads=num_heads,
+        kv_num_heads=kv_num_heads,
+        kv_cache_bit_width=8 if quantized else 0,
+        domain="com.microsoft",
+    )
+
+    graph_inputs = [
+        helper.make_tensor_value_info("query", TensorProto.FLOAT, [batch_size, sequence_length, num_heads * head_size]),
+        helper.make_tensor_value_info("key", TensorProto.FLOAT, [batch_size, sequence_length, kv_num_heads * head_size]),
+        helper.make_tensor_value_info(
+            "value", TensorProto.FLOAT, [batch_size, sequence_length, kv_num_heads * head_size]
+        ),
+        helper.make_tensor_value_info("seqlens_k", TensorProto.INT32, [batch_size]),
+        helper.make_tensor_value_info("total_sequence_length", TensorProto.INT32, [1]),
+    ]
+    past_shape = [batch_size, kv_num_heads, past_sequence_length, head_size]
+    if has_past:
+        graph_inputs += [
+            helper.make_tensor_value_info("past_key", kv_type, past_shape),
+            helper.make_tensor_value_info("past_value", kv_type, past_shape),
+        ]
+        if quantized:
+            graph_inputs += [
+                helper.make_tensor_value_info("past_key_scale", TensorProto.FLOAT, past_shape[:3]),
+                helper.make_tensor_value_info("past_value_scale", TensorProto.FLOAT, past_shape[:3]),
+            ]
+
+    present_shape = [batch_size, kv_num_heads, total_sequence_length, head_size]
+    graph_outputs = [
+        helper.make_tensor_value_info("output", TensorProto.FLOAT, [batch_size, sequence_length, num_heads * head_size]),
+        helper.make_tensor_value_info("present_key", kv_type, present_shape),
+        helper.make_tensor_value_info("present_value", kv_type, present_shape),
+    ]
+    if quantized:
+        graph_outputs += [
+            helper.make_tensor_value_info("present_key_scale", TensorProto.FLOAT, present_shape[:3]),
+            helper.make_tensor_value_info("present_value_scale", TensorProto.FLOAT, present_shape[:3]),
+        ]
+
+    graph = helper.make_graph([node], "GroupQueryAttention_Graph", graph_inputs, graph_outputs)
+    model = helper.make_model(graph)
+    return model.SerializeToString()
+
+
+def quantize_kv_cache(x: numpy.ndarray):
+    """Quantize KV cache of shape (B, N, S, H) to int8 with one scale per token of each head."""
+    abs_max = numpy.abs(x).max(axis=-1)
+    scale = numpy.where(abs_max > 0, abs_max / 127.0, 1.0).astype(numpy.float32)
+    quantized = numpy.clip(numpy.rint(x / scale[..., None]), -127, 127).astype(numpy.int8)
+    return quantized, scale
+
+
+def create_inputs(batch_size, sequence_length, past_sequence_length, num_heads, kv_num_heads, head_size, seed=0):
+    rng = numpy.random.default_rng(seed)
+    total_sequence_length = past_sequence_length + sequence_length
+    inputs = {
+        "query": rng.standard_normal((batch_size, sequence_length, num_heads * head_size), dtype=numpy.float32),
+        "key": rng.standard_normal((batch_size, sequence_length, kv_num_heads * head_size), dtype=numpy.float32),
+        "value": rng.standard_normal((batch_size, sequence_length, kv_num_heads * head_size), dtype=numpy.float32),
+        "seqlens_k": numpy.full((batch_size,), total_sequence_length - 1, dtype=numpy.int32),
+        "total_sequence_length": numpy.array([total_sequence_length], dtype=numpy.int32),
+    }
+    if past_sequence_length > 0:
+        past_shape = (batch_size, kv_num_heads, past_sequence_length, head_size)
+        inputs["past_key"] = rng.standard_normal(past_shape, dtype=numpy.float32)
+        inputs["past_value"] = rng.standard_normal(past_shape, dtype=numpy.float32)
+    return inputs
+
+
+def run_gqa(inputs, sequence_length, past_sequence_length, num_heads, kv_num_heads, head_size, quantized, repeat=0):
+    """Run GroupQueryAttention on CPU. Returns output, present key/value (dequantized) and average latency in ms."""
+    batch_size = inputs["query"].shape[0]
+    model = create_gqa_graph(
+        batch_size, sequence_length, past_sequence_length, num_heads, kv_num_heads, head_size, quantized
+    )
+    session = InferenceSession(model, SessionOptions(), providers=["CPUExecutionProvider"])
+
+    feeds = dict(inputs)
+    if quantized and past_sequence_length > 0:
+        feeds["past_key"], feeds["past_key_scale"] = quantize_kv_cache(inputs["past_key"])
+        feeds["past_value"], feeds["past_value_scale"] = quantize_kv_cache(inputs["past_value"])
+
+    results = session.run(None, feeds)
+    latency = 0.0
+    if repeat > 0:
+        start = time.perf_counter()
+        for _ in range(repeat):
+            session.run(None, feeds)
+        latency = (time.perf_counter() - start) * 1000.0 / repeat
+
+    output, present_key, present_value = results[:3]
+    if quantized:
+        present_key = present_key.astype(numpy.float32) * results[3][..., None]
+        present_value = present_value.astype(numpy.float32) * results[4][..., None]
+    return output, present_key, present_value, latency
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--batch_size", type=int, default=1)
+    parser.add_argument("--num_heads", type=int, default=32)
+    parser.add_argument("--kv_num_heads", type=int, default=8)
+    parser.add_argument("--head_size", type=int, default=128)
+    parser.add_argument("--past_sequence_lengths", type=int, nargs="+", default=[512, 2048, 8192])
+    parser.add_argument("--repeat", type=int, default=100)
+    args = parser.parse_args()
+
+    print("past_seq_len,cache_mb_fp32,cache_mb_int8,latency_ms_fp32,latency_ms_int8,max_diff_output")
+    for past_sequence_length in args.past_sequence_lengths:
+        inputs = create_inputs(
+            args.batch_size, 1, past_sequence_length, args.num_heads, args.kv_num_heads, args.head_size
+        )
+        results = {}
+        for quantized in [False, True]:
+            results[quantized] = run_gqa(
+                inputs,
+                1,
+                past_sequence_length,
+                args.num_heads,
+                args.kv_num_heads,
+                args.head_size,
+                quantized,
+                args.repeat,
+            )
+
+        cache_elements = 2 * args.batch_size * args.kv_num_heads * (past_sequence_length + 1) * args.head_size
+        cache_mb_fp32 = cache_elements * 4 / 1e6
+        cache_mb_int8 = (cache_elements + cache_elements // args.head_size * 4) / 1e6
+        max_diff = numpy.abs(results[True][0] - results[False][0]).max()
+        print(
+            f"{past_sequence_length},{cache_mb_fp32:.2f},{cache_mb_int8:.2f},"
+            f"{results[False][3]:.3f},{results[True][3]:.3f},{max_diff:.5f}"
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -15,6 +15,7 @@ import unittest
 
 import numpy
 import torch
+from benchmark_gqa_kv_cache_cpu import create_inputs, run_gqa
 from bert_padding import pad_input, unpad_input
 from einops import rearrange, repeat
 from onnx import TensorProto, helper
@@ -2070,5 +2071,21 @@ class TestGQA(unittest.TestCase):
                                     self.assertTrue(all_close)
 
 
+class TestGQAQuantizedKVCache(unittest.TestCase):
+    def run_parity(self, sequence_length, past_sequence_length):
+        batch_size, num_heads, kv_num_heads, head_size = 2, 8, 2, 64
+        inputs = create_inputs(batch_size, sequence_length, past_sequence_length, num_heads, kv_num_heads, head_size)
+        expected = run_gqa(inputs, sequence_length, past_sequence_length, num_heads, kv_num_heads, head_size, False)
+        actual = run_gqa(inputs, sequence_length, past_sequence_length, num_heads, kv_num_heads, head_size, True)
+        for i in range(3):
+            numpy.testing.assert_allclose(actual[i], expected[i], rtol=0, atol=3e-2)
+
+    def test_int8_kv_cache_prompt(self):
+        self.run_parity(sequence_length=16, past_sequence_length=0)
+
+    def test_int8_kv_cache_token_generation(self):
+        self.run_parity(sequence_length=1, past_sequence_length=127)
+
+
 if __name__ == "__main__":
     unittest.main()
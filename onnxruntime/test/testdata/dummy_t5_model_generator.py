@@ -20,10 +20,11 @@ def create_model(
     length_penalty: float,
     sequence_as_input: bool,
     decoder_needs_input_ids: bool,
+    cross_attention: bool = False,
 ) -> onnx.ModelProto:
     encoder_graph = create_encoder(vocab_size, embed_dim, num_heads, head_size)
     decoder_graph = create_decoder(
-        vocab_size, embed_dim, num_heads, head_size, sequence_as_input, decoder_needs_input_ids
+        vocab_size, embed_dim, num_heads, head_size, sequence_as_input, decoder_needs_input_ids, cross_attention
     )
 
     # Inputs: encoder_input_ids
@@ -174,7 +175,7 @@ def create_encoder(vocab_size, embed_dim, num_heads, head_size) -> onnx.GraphPro
 
 
 def create_decoder(
-    vocab_size, embed_dim, num_heads, head_size, sequence_as_input, decoder_needs_input_ids
+    vocab_size, embed_dim, num_heads, head_size, sequence_as_input, decoder_needs_input_ids, cross_attention=False
 ) -> onnx.GraphProto:
     # Inputs: input_ids, encoder_input_ids (optional), encoder_attention_mask, past_self_key_0, past_self_value_0, past_cross_key_0, past_cross_value_0
     inputs = []
@@ -239,8 +240,11 @@ def create_decoder(
         onnx.numpy_helper.from_array(
             np.array([-1, num_heads, head_size], dtype=np.int64), name="self_state_before_tranpose_shape_no_batch"
         ),
-        onnx.numpy_helper.from_array(np.array([-1, 1, embed_dim], dtype=np.int64), name="hidden_states_mean_shape"),
     ]
+    if not cross_attention:
+        initializers.append(
+            onnx.numpy_helper.from_array(np.array([-1, 1, embed_dim], dtype=np.int64), name="hidden_states_mean_shape")
+        )
 
     # Nodes
     nodes = []
@@ -261,14 +265,28 @@ def create_decoder(
         )
     else:
         nodes.append(onnx.helper.make_node("Identity", ["decoder_hidden_states"], ["combined_hidden_states"]))
-    nodes.append(onnx.helper.make_node("ReduceMean", ["past_cross_key_0"], ["encoder_hidden_states_mean"], axes=[2]))
-    nodes.append(
-        onnx.helper.make_node(
-            "Reshape",
-            ["encoder_hidden_states_mean", "hidden_states_mean_shape"],
-            ["encoder_hidden_states_mean_reshaped"],
+    if cross_attention:
+        # Attend from the decoder hidden states to the cross attention key/value, which are only consumed here.
+        nodes.append(
+            onnx.helper.make_node(
+                "MultiHeadAttention",
+                ["combined_hidden_states", "past_cross_key_0", "past_cross_value_0"],
+                ["encoder_hidden_states_mean_reshaped"],
+                num_heads=num_heads,
+                domain="com.microsoft",
+            )
+        )
+    else:
+        nodes.append(
+            onnx.helper.make_node("ReduceMean", ["past_cross_key_0"], ["encoder_hidden_states_mean"], axes=[2])
+        )
+        nodes.append(
+            onnx.helper.make_node(
+                "Reshape",
+                ["encoder_hidden_states_mean", "hidden_states_mean_shape"],
+                ["encoder_hidden_states_mean_reshaped"],
+            )
         )
-    )
     if sequence_as_input:
         nodes.append(
             onnx.helper.make_node("ReduceMean", ["combined_hidden_states"], ["decoder_hidden_states_mean"], axes=[1])
@@ -350,8 +368,16 @@ def arg_parser():
     parser.add_argument("--move-initializers", action="store_true", help="Move initializers to outer scope")
     parser.add_argument("--sequence-as-input", action="store_true", help="Use sequence as input")
     parser.add_argument("--decoder-needs-input-ids", action="store_true", help="Decoder needs model/encoder input ids")
+    parser.add_argument(
+        "--cross-attention",
+        action="store_true",
+        help="Decoder uses MultiHeadAttention over the cross attention key/value (cannot be used with --sequence-as-input)",
+    )
 
-    return parser.parse_args()
+    args = parser.parse_args()
+    if args.cross_attention and args.sequence_as_input:
+        parser.error("--cross-attention cannot be used with --sequence-as-input")
+    return args
 
 
 if __name__ == "__main__":
@@ -369,6 +395,7 @@ if __name__ == "__main__":
         args.length_penalty,
         args.sequence_as_input,
         args.decoder_needs_input_ids,
+        args.cross_attention,
     )
     if args.move_initializers:
         move_initializers_on_outer_scope(model)